@@ -0,0 +1,178 @@
+#include "AffineMatrix.hpp"
+#include <stdexcept>
+#if defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace{
+    // Cuatro componentes de una columna (o cuatro puntos de un array por
+    // componente) con las operaciones que necesitan las transformaciones
+#if defined(REAL_FLOAT) && defined(__SSE__)
+    struct Lanes{ __m128 v; };
+    inline Lanes load(const Real* p){ return {_mm_load_ps(p)}; }
+    inline Lanes loadu(const Real* p){ return {_mm_loadu_ps(p)}; }
+    inline void store(Real* p, Lanes a){ _mm_store_ps(p, a.v); }
+    inline void storeu(Real* p, Lanes a){ _mm_storeu_ps(p, a.v); }
+    inline Lanes broadcast(Real x){ return {_mm_set1_ps(x)}; }
+    inline Lanes operator+(Lanes a, Lanes b){ return {_mm_add_ps(a.v, b.v)}; }
+    inline Lanes operator*(Lanes a, Lanes b){ return {_mm_mul_ps(a.v, b.v)}; }
+#elif !defined(REAL_FLOAT) && defined(__AVX__)
+    struct Lanes{ __m256d v; };
+    inline Lanes load(const Real* p){ return {_mm256_load_pd(p)}; }
+    inline Lanes loadu(const Real* p){ return {_mm256_loadu_pd(p)}; }
+    inline void store(Real* p, Lanes a){ _mm256_store_pd(p, a.v); }
+    inline void storeu(Real* p, Lanes a){ _mm256_storeu_pd(p, a.v); }
+    inline Lanes broadcast(Real x){ return {_mm256_set1_pd(x)}; }
+    inline Lanes operator+(Lanes a, Lanes b){ return {_mm256_add_pd(a.v, b.v)}; }
+    inline Lanes operator*(Lanes a, Lanes b){ return {_mm256_mul_pd(a.v, b.v)}; }
+#elif !defined(REAL_FLOAT) && defined(__SSE2__)
+    // Sin AVX una columna de doubles son dos registros SSE2
+    struct Lanes{ __m128d lo, hi; };
+    inline Lanes load(const Real* p){ return {_mm_load_pd(p), _mm_load_pd(p + 2)}; }
+    inline Lanes loadu(const Real* p){ return {_mm_loadu_pd(p), _mm_loadu_pd(p + 2)}; }
+    inline void store(Real* p, Lanes a){ _mm_store_pd(p, a.lo); _mm_store_pd(p + 2, a.hi); }
+    inline void storeu(Real* p, Lanes a){ _mm_storeu_pd(p, a.lo); _mm_storeu_pd(p + 2, a.hi); }
+    inline Lanes broadcast(Real x){ return {_mm_set1_pd(x), _mm_set1_pd(x)}; }
+    inline Lanes operator+(Lanes a, Lanes b){ return {_mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi)}; }
+    inline Lanes operator*(Lanes a, Lanes b){ return {_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi)}; }
+#else
+    struct Lanes{ Real v[4]; };
+    inline Lanes load(const Real* p){ return {{p[0], p[1], p[2], p[3]}}; }
+    inline Lanes loadu(const Real* p){ return load(p); }
+    inline void store(Real* p, Lanes a){ for (int i = 0; i < 4; i++) p[i] = a.v[i]; }
+    inline void storeu(Real* p, Lanes a){ store(p, a); }
+    inline Lanes broadcast(Real x){ return {{x, x, x, x}}; }
+    inline Lanes operator+(Lanes a, Lanes b){ for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+    inline Lanes operator*(Lanes a, Lanes b){ for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+#endif
+}
+
+AffineMatrix::AffineMatrix(){
+    for (size_t j = 0; j < 4; j++){
+        for (size_t i = 0; i < 4; i++){
+            col[j][i] = i == j && i < 3 ? 1 : 0;
+        }
+    }
+}
+
+AffineMatrix::AffineMatrix(const Matrix& m){
+    for (size_t j = 0; j < 4; j++){
+        for (size_t i = 0; i < 3; i++){
+            col[j][i] = m[i][j];
+        }
+        col[j][3] = 0;
+    }
+}
+
+Matrix AffineMatrix::toMatrix() const{
+    Matrix m = identity();
+    for (size_t i = 0; i < 3; i++){
+        for (size_t j = 0; j < 4; j++){
+            m[i][j] = col[j][i];
+        }
+    }
+    return m;
+}
+
+Point AffineMatrix::transformPoint(const Point& p) const{
+    alignas(32) Real r[4];
+    store(r, load(col[0]) * broadcast(p.x) + load(col[1]) * broadcast(p.y) + load(col[2]) * broadcast(p.z) + load(col[3]));
+    return Point(r[0], r[1], r[2]);
+}
+
+Vector AffineMatrix::transformVector(const Vector& v) const{
+    alignas(32) Real r[4];
+    store(r, load(col[0]) * broadcast(v.x) + load(col[1]) * broadcast(v.y) + load(col[2]) * broadcast(v.z));
+    return Vector(r[0], r[1], r[2]);
+}
+
+void AffineMatrix::transformPoints(const Real* in, Real* out, size_t count) const{
+    if(count == 0) return;
+    const Lanes c0 = load(col[0]), c1 = load(col[1]), c2 = load(col[2]), c3 = load(col[3]);
+    Real x = in[0], y = in[1], z = in[2];
+    for (size_t i = 0; i + 1 < count; i++){
+        // Se escriben 4 componentes: la cuarta cae sobre la x del siguiente
+        // punto, que por eso se lee antes y se sobrescribe en la vuelta siguiente
+        const Real* next = in + 3 * (i + 1);
+        Real nx = next[0], ny = next[1], nz = next[2];
+        storeu(out + 3 * i, c0 * broadcast(x) + c1 * broadcast(y) + c2 * broadcast(z) + c3);
+        x = nx;
+        y = ny;
+        z = nz;
+    }
+    alignas(32) Real last[4];
+    store(last, c0 * broadcast(x) + c1 * broadcast(y) + c2 * broadcast(z) + c3);
+    Real* lastOut = out + 3 * (count - 1);
+    lastOut[0] = last[0];
+    lastOut[1] = last[1];
+    lastOut[2] = last[2];
+}
+
+void AffineMatrix::transformPoints(size_t count, Real* x, Real* y, Real* z) const{
+    const AffineMatrix& m = *this;
+    size_t i = 0;
+    // Cuatro puntos por vuelta, un coeficiente de la matriz en cada registro
+    for (; i + 4 <= count; i += 4){
+        Lanes px = loadu(x + i), py = loadu(y + i), pz = loadu(z + i);
+        Lanes rx = px * broadcast(m(0, 0)) + py * broadcast(m(0, 1)) + pz * broadcast(m(0, 2)) + broadcast(m(0, 3));
+        Lanes ry = px * broadcast(m(1, 0)) + py * broadcast(m(1, 1)) + pz * broadcast(m(1, 2)) + broadcast(m(1, 3));
+        Lanes rz = px * broadcast(m(2, 0)) + py * broadcast(m(2, 1)) + pz * broadcast(m(2, 2)) + broadcast(m(2, 3));
+        storeu(x + i, rx);
+        storeu(y + i, ry);
+        storeu(z + i, rz);
+    }
+    for (; i < count; i++){
+        Real px = x[i], py = y[i], pz = z[i];
+        x[i] = m(0, 0) * px + m(0, 1) * py + m(0, 2) * pz + m(0, 3);
+        y[i] = m(1, 0) * px + m(1, 1) * py + m(1, 2) * pz + m(1, 3);
+        z[i] = m(2, 0) * px + m(2, 1) * py + m(2, 2) * pz + m(2, 3);
+    }
+}
+
+AffineMatrix operator*(const AffineMatrix& a, const AffineMatrix& b){
+    AffineMatrix result;
+    const Lanes a0 = load(a.col[0]), a1 = load(a.col[1]), a2 = load(a.col[2]), a3 = load(a.col[3]);
+    for (size_t j = 0; j < 4; j++){
+        Lanes c = a0 * broadcast(b(0, j)) + a1 * broadcast(b(1, j)) + a2 * broadcast(b(2, j));
+        // La fila 0 0 0 1 de b solo suma la traslacion de a en la ultima columna
+        store(result.col[j], j == 3 ? c + a3 : c);
+    }
+    return result;
+}
+
+AffineMatrix inverse(const AffineMatrix& m){
+    const Real a = m(0, 0), b = m(0, 1), c = m(0, 2);
+    const Real d = m(1, 0), e = m(1, 1), f = m(1, 2);
+    const Real g = m(2, 0), h = m(2, 1), k = m(2, 2);
+
+    // Bloque 3x3 por adjuntos
+    const Real c00 = e * k - f * h, c10 = f * g - d * k, c20 = d * h - e * g;
+    Real det = a * c00 + b * c10 + c * c20;
+    if (det == 0.0)
+        throw std::runtime_error("Matrix is singular and cannot be inverted.");
+    det = 1 / det;
+
+    AffineMatrix inv;
+    Real (&r)[4][4] = inv.col;
+    r[0][0] = c00 * det;             r[1][0] = (c * h - b * k) * det; r[2][0] = (b * f - c * e) * det;
+    r[0][1] = c10 * det;             r[1][1] = (a * k - c * g) * det; r[2][1] = (c * d - a * f) * det;
+    r[0][2] = c20 * det;             r[1][2] = (b * g - a * h) * det; r[2][2] = (a * e - b * d) * det;
+
+    // Traslacion: -L^-1 t
+    const Real tx = m(0, 3), ty = m(1, 3), tz = m(2, 3);
+    for (size_t i = 0; i < 3; i++){
+        r[3][i] = -(r[0][i] * tx + r[1][i] * ty + r[2][i] * tz);
+    }
+    r[3][3] = 0;
+    return inv;
+}
+
+AffineMatrix transposeLinear(const AffineMatrix& m){
+    AffineMatrix result;
+    for (size_t i = 0; i < 3; i++){
+        for (size_t j = 0; j < 3; j++){
+            result.col[j][i] = m(j, i);
+        }
+    }
+    return result;
+}
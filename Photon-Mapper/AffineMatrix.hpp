@@ -0,0 +1,42 @@
+#ifndef AFFINEMATRIX_HPP
+#define AFFINEMATRIX_HPP
+
+#include <cstddef>
+#include "Matrix.hpp"
+#include "Point.hpp"
+#include "Vector.hpp"
+
+// Transformacion afin (ultima fila 0 0 0 1) guardada por columnas de 4
+// componentes alineadas, la cuarta siempre 0: cada columna es un registro SSE
+// (float) o AVX (double, -mavx), y un punto se transforma con
+//     x * col0 + y * col1 + z * col2 + col3
+// sin reordenar datos. Sin esas extensiones se usa el mismo codigo escalar.
+// La inversa solo invierte el bloque 3x3 y recoloca la traslacion.
+class AffineMatrix{
+private:
+    alignas(32) Real col[4][4];
+public:
+    // Identidad
+    AffineMatrix();
+    // Toma las tres primeras filas de m: la cuarta se supone 0 0 0 1
+    explicit AffineMatrix(const Matrix& m);
+
+    Real operator()(size_t row, size_t column) const { return col[column][row]; }
+    Matrix toMatrix() const;
+
+    Point transformPoint(const Point& p) const;
+    Vector transformVector(const Vector& v) const;
+
+    // Lote de puntos xyz seguidos (como TriangleMesh::positions); in y out
+    // pueden ser el mismo buffer, pero no solaparse de otra forma
+    void transformPoints(const Real* in, Real* out, size_t count) const;
+    // Lote de puntos con un array por componente, transformados en su sitio
+    void transformPoints(size_t count, Real* x, Real* y, Real* z) const;
+
+    friend AffineMatrix operator*(const AffineMatrix& a, const AffineMatrix& b);
+    friend AffineMatrix inverse(const AffineMatrix& m);
+    // Traspuesta del bloque 3x3 sin traslacion (para normales con la inversa)
+    friend AffineMatrix transposeLinear(const AffineMatrix& m);
+};
+
+#endif /* AFFINEMATRIX_HPP */
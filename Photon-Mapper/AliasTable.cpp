@@ -0,0 +1,64 @@
+#include "AliasTable.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+AliasTable::AliasTable(const std::vector<double>& weights){
+    const size_t n = weights.size();
+    if(n == 0) return;
+    if(n > UINT32_MAX) throw std::runtime_error("Alias table too large");
+
+    double total = 0;
+    for (double w : weights){
+        if(!(w >= 0)) throw std::runtime_error("Alias table weights must be non negative");
+        total += w;
+    }
+    pdfs.resize(n);
+    for (size_t i = 0; i < n; i++){
+        pdfs[i] = total > 0 ? weights[i] / total : 1.0 / double(n);
+    }
+
+    // Cada celda guarda 1/n de probabilidad: las que tienen menos se completan con una que tiene de mas
+    probability.resize(n);
+    alias.resize(n);
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < n; i++){
+        scaled[i] = pdfs[i] * double(n);
+        (scaled[i] < 1.0 ? small : large).push_back(uint32_t(i));
+    }
+    while(!small.empty() && !large.empty()){
+        uint32_t s = small.back(), l = large.back();
+        small.pop_back();
+        probability[s] = scaled[s];
+        alias[s] = l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if(scaled[l] < 1.0){
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Lo que queda es 1 salvo errores de redondeo
+    for (uint32_t i : large){
+        probability[i] = 1.0;
+        alias[i] = i;
+    }
+    for (uint32_t i : small){
+        probability[i] = 1.0;
+        alias[i] = i;
+    }
+}
+
+size_t AliasTable::sample(double u, double* remapped) const{
+    const size_t n = pdfs.size();
+    double x = u * double(n);
+    size_t cell = std::min(size_t(x), n - 1);
+    // La parte fraccionaria decide entre la celda y su alias
+    double f = std::min(x - double(cell), 1.0);
+    double p = probability[cell];
+    if(f < p){
+        if(remapped) *remapped = std::min(f / p, 0.99999999999999989);
+        return cell;
+    }
+    if(remapped) *remapped = std::min((f - p) / (1.0 - p), 0.99999999999999989);
+    return alias[cell];
+}
@@ -0,0 +1,28 @@
+#ifndef ALIASTABLE_HPP
+#define ALIASTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tabla de alias (Vose): muestrea un indice con probabilidad proporcional a
+// su peso en O(1) con un solo numero aleatorio. Se construye en O(n).
+class AliasTable{
+private:
+    std::vector<double> probability;    // probabilidad de quedarse en la celda
+    std::vector<uint32_t> alias;        // indice alternativo de la celda
+    std::vector<double> pdfs;           // peso / suma
+public:
+    AliasTable() = default;
+    // Pesos >= 0; si todos son 0 se reparte por igual
+    AliasTable(const std::vector<double>& weights);
+
+    size_t size() const { return pdfs.size(); }
+    bool empty() const { return pdfs.empty(); }
+    // u en [0, 1); remapped (opcional) recibe otro numero uniforme en [0, 1)
+    // sacado de la parte de u que no se ha usado
+    size_t sample(double u, double* remapped = nullptr) const;
+    double pdf(size_t index) const { return pdfs[index]; }
+};
+
+#endif /* ALIASTABLE_HPP */
@@ -0,0 +1,38 @@
+#include "Arena.hpp"
+#include <algorithm>
+
+void* Arena::allocate(size_t bytes, size_t alignment){
+    // Primer bloque desde el actual con sitio; si no hay, uno nuevo al final
+    for (; block < blocks.size(); block++, offset = 0){
+        Block& current = blocks[block];
+        size_t start = (reinterpret_cast<size_t>(current.data.get()) + offset + alignment - 1) & ~(alignment - 1);
+        size_t begin = start - reinterpret_cast<size_t>(current.data.get());
+        if(begin + bytes <= current.size){
+            offset = begin + bytes;
+            return current.data.get() + begin;
+        }
+    }
+    const size_t size = std::max(BLOCK_SIZE, bytes + alignment);
+    blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+    block = blocks.size() - 1;
+    offset = 0;
+    return allocate(bytes, alignment);
+}
+
+void Arena::rewind(const Marker& marker){
+    block = marker.block;
+    offset = marker.offset;
+}
+
+size_t Arena::capacity() const{
+    size_t total = 0;
+    for (const Block& b : blocks){
+        total += b.size;
+    }
+    return total;
+}
+
+Arena& threadArena(){
+    thread_local Arena arena;
+    return arena;
+}
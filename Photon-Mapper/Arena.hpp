@@ -0,0 +1,79 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Memoria temporal de cada hilo para el camino de render: reservar solo avanza
+// un puntero dentro de bloques que se conservan entre usos, y liberar no hace
+// nada. ArenaScope devuelve la arena a donde estaba al salir del ambito (una
+// muestra, una fila), asi que tras las primeras muestras ya no se pide memoria
+// al sistema.
+class Arena{
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Marker{
+        size_t block;
+        size_t offset;
+    };
+private:
+    struct Block{
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t block = 0;       // bloque actual
+    size_t offset = 0;      // primer byte libre del bloque actual
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+    Marker mark() const { return {block, offset}; }
+    // Libera todo lo reservado despues de marker; los bloques se reutilizan
+    void rewind(const Marker& marker);
+    // Bytes reservados al sistema (no crece en estado estacionario)
+    size_t capacity() const;
+};
+
+// Arena del hilo actual
+Arena& threadArena();
+
+// Todo lo reservado en la arena del hilo durante el ambito se libera al salir
+class ArenaScope{
+private:
+    Arena& arena;
+    Arena::Marker marker;
+public:
+    ArenaScope() : arena(threadArena()), marker(arena.mark()) {}
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ~ArenaScope(){ arena.rewind(marker); }
+};
+
+// Allocator para contenedores estandar sobre la arena del hilo
+template<class T>
+struct ArenaAllocator{
+    using value_type = T;
+    Arena* arena;
+
+    ArenaAllocator() : arena(&threadArena()) {}
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n){ return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif /* ARENA_HPP */
@@ -1,12 +1,58 @@
 #define _USE_MATH_DEFINES
 #include <future>
+#include <algorithm>
 #include <thread>
 #include "Camera.hpp"
+#include "GBuffer.hpp"
+#include "PathIntegrator.hpp"
+#include "WavefrontRenderer.hpp"
 #include "Utils.hpp"
 #include "progressbar.hpp"
 #include "ThreadPool.hpp"
+#include "Numa.hpp"
 #include "ScopedTimer.hpp"
+#include "RenderStats.hpp"
 #include <math.h>
+#include <limits.h>
+
+namespace {
+    // Barra de progreso en su propio hilo, refrescada cada 100 ms con los pixeles terminados
+    class ProgressReporter{
+    private:
+        std::atomic<size_t> done{0};
+        std::atomic<bool> stopped{false};
+        const size_t total;
+        const bool show;
+        progressbar bar;
+        std::thread reporter;
+    public:
+        ProgressReporter(size_t total, bool show) : total(total), show(show), bar(int(total)) {
+            reporter = std::thread([this]() {
+                while (!stopped.load(std::memory_order_relaxed) && done.load(std::memory_order_relaxed) < this->total) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    if (this->show) bar.setProgress(int(done.load(std::memory_order_relaxed)), int(this->total));
+                }
+            });
+        }
+        ~ProgressReporter(){ finish(); }
+
+        void add(size_t pixels){ done.fetch_add(pixels, std::memory_order_relaxed); }
+        // rematar al 100% y salto de línea
+        void finish(){
+            if(!reporter.joinable()) return;
+            stopped = true;
+            reporter.join();
+            if (show){
+                bar.setProgress(int(total), int(total));
+                bar.finish();
+            }
+        }
+    };
+
+    size_t renderThreads(const RenderSettings& settings){
+        return settings.threads > 0 ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+}
 
 Camera::Camera(const Vector& up,const Vector& left,const Vector& front,const Point& o){
     this->up = up;
@@ -73,105 +119,195 @@ Ray Camera::getRayToPixel(size_t x, size_t y){
     return ray;
 }
 
-PPM Camera::render(const FigureCollection& scene, const std::vector<std::shared_ptr<Light>>& lights){
-    PPM image(this->height, this->width);
+PPM Camera::render(const SceneGeometry& scene, const std::vector<std::shared_ptr<Light>>& lights, const RenderSettings& settings){
     PhotonMap photonMap;
+    if(settings.pipelined && !settings.wavefront){
+        return renderPipelined(scene, lights, photonMap, settings);
+    }
     {
         ScopedTimer timer("PhotonMap Generation Timer");
-        photonMap = generatePhotonMap(scene, lights, MAX_PHOTONS);
+        photonMap = generatePhotonMap(scene, lights, settings);
     }
-    const int total = this->height * this->width;
-    std::atomic<int> pixels_done{0};
-    progressbar pb(this->height * this->width);
-    
-    const int numThreads = std::thread::hardware_concurrency();
-    ThreadPool pool(numThreads);
-    std::vector<std::future<void>> futures;
-
-    std::thread reporter([&]() {
-        while (true) {
-            int done = pixels_done.load(std::memory_order_relaxed);
-            if (done >= total) break;
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            pb.setProgress(done, total);
-        }
-        // rematar al 100% y salto de línea
-        pb.setProgress(total, total);
-        pb.finish();  
-    });
+    return render(scene, lights, photonMap, settings);
+}
 
-    for (size_t y = 0; y < this->height; y++){
+PPM Camera::render(const SceneGeometry& scene, const std::vector<std::shared_ptr<Light>>& lights, const PhotonMap& photonMap, const RenderSettings& settings){
+    const LightSampler lightSampler(lights);
+    if(settings.wavefront){
+        return WavefrontRenderer(scene, lightSampler, photonMap, settings).render(*this);
+    }
+    PPM image(this->height, this->width);
+    // Con afinidad cada nodo NUMA lee su propia copia del mapa de fotones y de
+    // los arrays de primitivas (mallas e instancias se comparten)
+    const bool replicate = settings.affinity != AFFINITY_NONE;
+    const NodeReplicas<SceneGeometry> sceneCopies(scene, replicate);
+    const NodeReplicas<PhotonMap> photonMapCopies(photonMap, replicate);
+    std::vector<PathIntegrator> integrators;
+    for (size_t node = 0; node < sceneCopies.size(); node++){
+        integrators.emplace_back(sceneCopies.at(node), lightSampler, photonMapCopies.at(node), settings);
+    }
+    ProgressReporter progress(this->height * this->width, settings.showProgress);
+    ThreadPool pool(renderThreads(settings), settings.affinity);
+
+    // Una fila por indice: el pool no reserva nada por pixel ni por muestra
+    parallelFor(pool, this->height, [&](size_t y) {
+        const PathIntegrator& integrator = integrators[currentNumaNode() % integrators.size()];
         for (size_t x = 0; x < this->width; x++){
-            futures.emplace_back(pool.enqueue([&, x, y]() {
-            
             Color color(0,0,0);
 
-            for(size_t i = 0; i < MAX_RAYS_PER_PIXEL; i++){
-                                
-                Ray ray = this->getRayToPixel(x, y);
-                
-                Intersection intersection = Intersection();
-                
-                if(scene.isIntersectedBy(ray, 0.00001f, INT_MAX, intersection)){
-                    color += intersection.material->getColor(ray, intersection, lights, scene, photonMap);
+            for(size_t i = 0; i < settings.raysPerPixel; i++){
+                color += integrator.radiance(this->getRayToPixel(x, y));
+            }
+
+            color /= double(settings.raysPerPixel);
+            image[y][x] = PPM::Pixel(color);
+        }
+        progress.add(this->width);
+    });
+    progress.finish();
+    return image;
+}
+
+PPM Camera::renderPipelined(const SceneGeometry& scene, const std::vector<std::shared_ptr<Light>>& lights, PhotonMap& photonMap, const RenderSettings& settings, double* photonSeconds){
+    // Con afinidad cada nodo NUMA lee su copia de la escena y del mapa, como en render
+    const bool replicate = settings.affinity != AFFINITY_NONE;
+    const NodeReplicas<SceneGeometry> sceneCopies(scene, replicate);
+    const LightSampler lightSampler(lights);
+    // Las copias del mapa y los integradores se crean con el mapa: solo se
+    // consultan cuando photonsReady esta listo
+    std::unique_ptr<NodeReplicas<PhotonMap>> photonMapCopies;
+    std::vector<PathIntegrator> integrators;
+
+    // Emision de fotones y kd-tree en su propio hilo, fuera del camino critico
+    double photonElapsed = 0;
+    std::shared_future<void> photonsReady = std::async(std::launch::async, [&]() {
+        {
+            ScopedTimer timer("PhotonMap Generation Timer", photonElapsed);
+            photonMap = generatePhotonMap(scene, lights, settings);
+        }
+        photonMapCopies = std::make_unique<NodeReplicas<PhotonMap>>(photonMap, replicate);
+        for (size_t node = 0; node < sceneCopies.size(); node++){
+            integrators.emplace_back(sceneCopies.at(node), lightSampler, photonMapCopies->at(node), settings);
+        }
+    }).share();
+    auto photonMapReady = [&]() {
+        return photonsReady.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    auto localIntegrator = [&]() -> const PathIntegrator& {
+        return integrators[currentNumaNode() % integrators.size()];
+    };
+
+    const MaterialTable& materials = scene.materialTable();
+    const size_t samplesPerPixel = settings.raysPerPixel;
+    const size_t rowSamples = this->width * samplesPerPixel;
+    PPM image(this->height, this->width);
+    std::vector<GBuffer> rows(this->height);
+    std::atomic<size_t> cachedSamples{0};
+    ProgressReporter progress(this->height * this->width, settings.showProgress);
+    ThreadPool pool(renderThreads(settings), settings.affinity);
+
+    // Mientras no hay mapa cada fila guarda su G-buffer (hasta GBUFFER_MAX_SAMPLES
+    // muestras); las filas que llegan con el mapa ya listo se renderizan del tiron
+    parallelFor(pool, this->height, [&](size_t y) {
+        if(!photonMapReady() && cachedSamples.fetch_add(rowSamples) + rowSamples <= GBUFFER_MAX_SAMPLES){
+            RenderStats& stats = threadStats();
+            GBuffer& gbuffer = rows[y];
+            gbuffer.resize(rowSamples);
+            const SceneGeometry& localScene = sceneCopies.local();
+            Intersection intersection;
+            for (size_t x = 0; x < this->width; x++){
+                for (size_t i = 0; i < samplesPerPixel; i++){
+                    Ray ray = this->getRayToPixel(x, y);
+                    stats.primaryRays++;
+                    bool hit = localScene.isIntersectedBy(ray, ray.epsilon(), INT_MAX, intersection);
+                    gbuffer.set(x * samplesPerPixel + i, ray, hit ? &intersection : nullptr);
                 }
             }
+            return;
+        }
+        photonsReady.wait();
+        // Si la emision ha fallado no hay integradores: photonsReady.get() relanza el error
+        if(integrators.empty()) return;
+        const PathIntegrator& integrator = localIntegrator();
+        for (size_t x = 0; x < this->width; x++){
+            Color color(0, 0, 0);
+            for (size_t i = 0; i < samplesPerPixel; i++){
+                color += integrator.radiance(this->getRayToPixel(x, y));
+            }
+            image[y][x] = PPM::Pixel(color / double(samplesPerPixel));
+        }
+        progress.add(this->width);
+    });
 
-            color /= double(MAX_RAYS_PER_PIXEL);
-            //std::cout<<"Final: "<<color.r<<" "<<color.g<<" "<<color.b<<" "<<std::endl;
-            image[y][x] = std::make_shared<PPM::Pixel>(color);
-            pixels_done.fetch_add(1, std::memory_order_relaxed);
-    
-            }));
+    // Estimacion de densidad sobre los impactos guardados
+    photonsReady.get();
+    if(photonSeconds) *photonSeconds = photonElapsed;
+    parallelFor(pool, this->height, [&](size_t y) {
+        GBuffer& gbuffer = rows[y];
+        if(gbuffer.size() == 0) return;
+        const PathIntegrator& integrator = localIntegrator();
+        for (size_t x = 0; x < this->width; x++){
+            Color color(0, 0, 0);
+            for (size_t i = x * samplesPerPixel; i < (x + 1) * samplesPerPixel; i++){
+                if(gbuffer.hit(i)){
+                    color += integrator.radiance(gbuffer.ray(i, this->o), gbuffer.intersection(i, materials));
+                }
+            }
+            image[y][x] = PPM::Pixel(color / double(samplesPerPixel));
         }
-    }
-    reporter.join();
-    for (auto &f : futures) {
-        f.get();
-    }
+        gbuffer = GBuffer();
+        progress.add(this->width);
+    });
+    progress.finish();
     return image;
 }
 
-PhotonMap Camera::generatePhotonMap(const FigureCollection& scene, const std::vector<std::shared_ptr<Light>>& lights, size_t totalPhotons){
+PhotonMap Camera::generatePhotonMap(const IntersectableFigure& scene, const std::vector<std::shared_ptr<Light>>& lights, const RenderSettings& settings){
+    const size_t totalPhotons = settings.photons;
     std::vector<Photon> photons;
-    double totalPower = 0;
-    for (const auto& light : lights) {
-        totalPower += light->intensity();
-    }
-    for (const auto& light : lights) {
-        size_t photonsPerLight = totalPhotons * (light->intensity()/totalPower);
+    RenderStats& stats = threadStats();
+    // Cada foton elige su luz por potencia con el arbol de luces; u estratificado
+    // en orden, asi cada luz recibe su parte sin perder fotones por redondeo
+    const LightSampler lightSampler(lights);
+    for (size_t i = 0; i < totalPhotons && !lightSampler.empty(); ++i) {
+        double lightPdf;
+        const Light* light = lightSampler.sample((i + 0.5) / totalPhotons, lightPdf);
+        if(!light) break;
+        Point origin;
+        Vector direction;
+        light->emit(origin, direction);
+        Color flux = light->flux() / (lightPdf * totalPhotons);
         
-        for (size_t i = 0; i < photonsPerLight; ++i) {
-            Point origin = light->getCenter();
-            Vector direction = randomDirection(); 
-            Color flux = 4 * M_PI * light->getPower() / photonsPerLight;
-            
-            Ray photonRay(origin, direction);
-            Intersection intersection;
-            size_t bounce = 0;
-            // Dispersión difusa
-            //direction = randomDirection(intersection.intersectionPoint, intersection.normal);
-            //photonRay = Ray(intersection.intersectionPoint, direction);
+        Ray photonRay(origin, direction);
+        Intersection intersection;
+        size_t bounce = 0;
+        stats.photonsEmitted++;
+        // Dispersión difusa
+        //direction = randomDirection(intersection.intersectionPoint, intersection.normal);
+        //photonRay = Ray(intersection.intersectionPoint, direction);
 
 
-            while (bounce < MAX_BOUNCES && scene.isIntersectedBy(photonRay, 1e-6f, INT_MAX, intersection)) {
-                RR_Event event = russianRoulette(*intersection.material);
-                
-                if(event.eventType == ABSORTION){
-                    continue;
-                }
+        while (bounce < settings.maxBounces && scene.isIntersectedBy(photonRay, photonRay.epsilon(), INT_MAX, intersection)) {
+            stats.photonRays++;
+            BSDFSample sample = intersection.material->sample(photonRay, intersection);
+            stats.photonRREvents[sample.eventType]++;
+            
+            if(sample.eventType == ABSORTION){
+                stats.photonsAbsorbed++;
+                break;
+            }
 
-                flux = flux * intersection.material->bsdf(photonRay, intersection, event);
-                
-                if(event.eventType == DIFUSSE){
-                    photons.push_back(Photon(intersection.intersectionPoint, photonRay.dir, flux));
-                }
-                bounce++;
-                
-                Vector randomVector = intersection.material->getSacterredVector(photonRay, intersection, event);
-                photonRay = Ray(intersection.intersectionPoint, randomVector);
+            flux = flux * sample.weight;
+            
+            if(sample.eventType == DIFUSSE){
+                photons.push_back(Photon(intersection.intersectionPoint, photonRay.dir, flux));
+                stats.photonsStored++;
             }
+            bounce++;
+            
+            photonRay = Ray(intersection.intersectionPoint, sample.direction);
         }
+        stats.photonBounces[std::min(bounce, STATS_MAX_BOUNCES)]++;
     }
 
     return newPhotonMap(photons); 
@@ -3,10 +3,11 @@
 #include "Vector.hpp"
 #include "Point.hpp"
 #include "Ray.hpp"
-#include "FigureCollection.hpp"
+#include "SceneGeometry.hpp"
 #include "PPM.hpp"
 #include "PhotonMap.hpp"
-#include "Light.hpp"
+#include "LightSampler.hpp"
+#include "RenderSettings.hpp"
 
 class Camera{
 private:
@@ -28,8 +29,14 @@ public:
     void setHeight(const size_t height);    
     void setWidth(const size_t width);   
     Ray getRayToPixel(size_t x, size_t y); 
-    PPM render(const FigureCollection& scene, const std::vector<std::shared_ptr<Light>>& lights);
-    PhotonMap generatePhotonMap(const FigureCollection& scene, const std::vector<std::shared_ptr<Light>>& lights, size_t totalPhotons);
+    PPM render(const SceneGeometry& scene, const std::vector<std::shared_ptr<Light>>& lights, const RenderSettings& settings = RenderSettings());
+    PPM render(const SceneGeometry& scene, const std::vector<std::shared_ptr<Light>>& lights, const PhotonMap& photonMap, const RenderSettings& settings = RenderSettings());
+    // Render en tuberia: el mapa de fotones se construye en otro hilo mientras
+    // el pool guarda el primer impacto de cada muestra (GBuffer.hpp); con el
+    // mapa listo se sombrean esos impactos. Deja el mapa en photonMap y, si se
+    // pide, el tiempo de su construccion (solapado con el render) en photonSeconds
+    PPM renderPipelined(const SceneGeometry& scene, const std::vector<std::shared_ptr<Light>>& lights, PhotonMap& photonMap, const RenderSettings& settings = RenderSettings(), double* photonSeconds = nullptr);
+    PhotonMap generatePhotonMap(const IntersectableFigure& scene, const std::vector<std::shared_ptr<Light>>& lights, const RenderSettings& settings = RenderSettings());
 };
 
 #endif /* CAMERA_HPP */
\ No newline at end of file
@@ -17,6 +17,6 @@ std::ostream& operator<<(std::ostream& os, const Color &c){
     return os;
 }
 
-Color Color::fromRGB(double r_, double g_, double b_){
+Color Color::fromRGB(Real r_, Real g_, Real b_){
     return Color(r_ / 255.0, g_ / 255.0, b_ / 255.0);
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "Coordinate.hpp"
 
-Coordinate::Coordinate(double x, double y, double z, double w){
+Coordinate::Coordinate(Real x, Real y, Real z, Real w){
     this->x = x;
     this->y = y;
     this->z = z;
@@ -36,7 +36,7 @@ Matrix baseChange(const Coordinate& origin, const Coordinate& u, const Coordinat
 }
 
 Coordinate operator*(const Matrix& m, const Coordinate& c){
-    double new_x, new_y, new_z, new_w;
+    Real new_x, new_y, new_z, new_w;
 
     new_x = m[0][0] * c.x + m[0][1] * c.y + m[0][2] * c.z + m[0][3] * c.w;
     new_y = m[1][0] * c.x + m[1][1] * c.y + m[1][2] * c.z + m[1][3] * c.w;
@@ -66,7 +66,7 @@ Coordinate operator*(const Coordinate& c1, const Coordinate& c2){
     );
 }
 
-Coordinate operator*(const Coordinate& c, const double constant){
+Coordinate operator*(const Coordinate& c, const Real constant){
     return Coordinate(
         c.x * constant,
         c.y * constant,
@@ -75,7 +75,7 @@ Coordinate operator*(const Coordinate& c, const double constant){
     );
 }
 
-Coordinate operator*(const double constant, const Coordinate& c){
+Coordinate operator*(const Real constant, const Coordinate& c){
     return c * constant;
 }
 
@@ -88,7 +88,7 @@ Coordinate operator/(const Coordinate& c1, const Coordinate& c2){
     );
 }
 
-Coordinate operator/(const Coordinate& c, const double constant){
+Coordinate operator/(const Coordinate& c, const Real constant){
     return Coordinate(
         c.x / constant,
         c.y / constant,
@@ -106,7 +106,7 @@ Coordinate operator+(const Coordinate& c1, const Coordinate& c2){
     );
 }
 
-Coordinate operator+(const Coordinate& c, const double constant){
+Coordinate operator+(const Coordinate& c, const Real constant){
     return Coordinate(
         c.x + constant,
         c.y + constant,
@@ -115,7 +115,7 @@ Coordinate operator+(const Coordinate& c, const double constant){
     );
 }
 
-Coordinate operator+(const double constant, const Coordinate& c){
+Coordinate operator+(const Real constant, const Coordinate& c){
     return c + constant;
 }
 
@@ -126,32 +126,32 @@ Coordinate& Coordinate::operator+=(const Coordinate& c){
     return *this;
 }
 
-Coordinate& Coordinate::operator+=(const double constant){
+Coordinate& Coordinate::operator+=(const Real constant){
     this->x += constant;
     this->y += constant;
     this->z += constant;
     return *this;
 }
 
-Coordinate& Coordinate::operator*=(const double constant){
+Coordinate& Coordinate::operator*=(const Real constant){
     this->x *= constant;
     this->y *= constant;
     this->z *= constant;
     return *this;
 }
 
-Coordinate& Coordinate::operator/=(const double constant){
+Coordinate& Coordinate::operator/=(const Real constant){
     this->x /= constant;
     this->y /= constant;
     this->z /= constant;
     return *this;
 }
 
-double maxComponent(const Coordinate& c){
+Real maxComponent(const Coordinate& c){
     return std::max(c.x, std::max(c.y, c.z));
 }
 
-double& Coordinate::operator[](std::size_t idx){
+Real& Coordinate::operator[](std::size_t idx){
     switch (idx){
         case 0:
             return this->x;
@@ -168,7 +168,7 @@ double& Coordinate::operator[](std::size_t idx){
     }
 }
 
-const double& Coordinate::operator[](std::size_t idx ) const{
+const Real& Coordinate::operator[](std::size_t idx ) const{
     switch (idx){
         case 0:
             return this->x;
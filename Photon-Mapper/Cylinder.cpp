@@ -1,7 +1,8 @@
 #include "Cylinder.hpp"
+#include "SceneGeometry.hpp"
 #include <math.h>
 
-bool Cylinder::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const {
+bool Cylinder::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const {
     // Vector hacia la base del cilindro
     if (!this->visible) {
         return false;
@@ -13,29 +14,29 @@ bool Cylinder::isIntersectedBy(const Ray& ray, double tMin, double tMax, Interse
     Vector deltaW = delta - axis * dotProduct(delta, axis);
 
     // Cálculo para intersección con el cuerpo del cilindro
-    double a = dotProduct(w, w);
-    double b = 2 * dotProduct(w, deltaW);
-    double c = dotProduct(deltaW, deltaW) - radius * radius;
+    Real a = dotProduct(w, w);
+    Real b = 2 * dotProduct(w, deltaW);
+    Real c = dotProduct(deltaW, deltaW) - radius * radius;
 
-    double discriminant = b * b - 4 * a * c;
+    Real discriminant = b * b - 4 * a * c;
 
     if (discriminant >= 0) {
         // Soluciones cuadráticas
-        double t0 = (-b - sqrt(discriminant)) / (2 * a);
-        double t1 = (-b + sqrt(discriminant)) / (2 * a);
+        Real t0 = (-b - sqrt(discriminant)) / (2 * a);
+        Real t1 = (-b + sqrt(discriminant)) / (2 * a);
 
         // Verifica rango de altura del cilindro para el cuerpo
-        for (double t : {t0, t1}) {
+        for (Real t : {t0, t1}) {
             if (t > tMin && t < tMax) {
                 Point pCuerpo = ray.at(t);
-                double hCuerpo = dotProduct(pCuerpo - baseCenter, axis);
+                Real hCuerpo = dotProduct(pCuerpo - baseCenter, axis);
 
                 if (hCuerpo >= 0 && hCuerpo <= height) {
                     intersection.t = t;
                     intersection.intersectionPoint = pCuerpo;
                     Vector outwardNormal = normalize(pCuerpo - (Point)((Coordinate)baseCenter + (Coordinate)(axis * hCuerpo)));
                     intersection.normal = dotProduct(outwardNormal, ray.dir) < 0 ? outwardNormal : -outwardNormal;
-                    intersection.material = this->material;
+                    intersection.material = this->material.get();
                     intersection.figureName = "Cylinder";
                     return true;
                 }
@@ -45,17 +46,17 @@ bool Cylinder::isIntersectedBy(const Ray& ray, double tMin, double tMax, Interse
 
     // Cálculo para intersección con las tapas
     for (int i = 0; i < 2; i++) {
-        double hTapa = (i == 0) ? 0 : height;
+        Real hTapa = (i == 0) ? 0 : height;
         Point centerTapa = (Point)((Coordinate)baseCenter + (Coordinate)(axis * hTapa));
 
-        double tTapa = dotProduct(centerTapa - ray.origin, axis) / dotProduct(ray.dir, axis);
+        Real tTapa = dotProduct(centerTapa - ray.origin, axis) / dotProduct(ray.dir, axis);
         if (tTapa > tMin && tTapa < tMax) {
             Point pTapa = ray.at(tTapa);
             if (module(pTapa - centerTapa) <= radius) {
                 intersection.t = tTapa;
                 intersection.intersectionPoint = pTapa;
                 intersection.normal = (i == 0) ? -axis : axis;
-                intersection.material = this->material;
+                intersection.material = this->material.get();
                 intersection.figureName = "Cylinder";
                 return true;
             }
@@ -69,7 +70,7 @@ void Cylinder::applyTransform(const Matrix& t) {
     baseCenter = t * baseCenter;
 
     Vector newAxis = t * axis;
-    double axisScale = module(newAxis); 
+    Real axisScale = module(newAxis); 
     axis = normalize(newAxis);
 
     Vector tangent;
@@ -80,8 +81,14 @@ void Cylinder::applyTransform(const Matrix& t) {
     tangent = normalize(tangent);
 
     Vector transformedTangent = t * tangent;
-    double radialScale = module(transformedTangent);
+    Real radialScale = module(transformedTangent);
 
     radius *= radialScale;
     height *= axisScale;
 }
+
+bool Cylinder::storeIn(SceneGeometry& geometry) const{
+    if(!visible) return false;
+    geometry.addCylinder(baseCenter, axis, radius, height, material);
+    return true;
+}
@@ -1,10 +1,11 @@
 #include "Figure.hpp"
+#include "MaterialTable.hpp"
 
 Figure::Figure(const std::shared_ptr<Material>& material){
     this->material = material;
 }
 
-void Figure::setColor(double r, double g, double b){
+void Figure::setColor(Real r, Real g, Real b){
     this->material.get()->setColor(Color(r, g, b));
 }
 
@@ -12,6 +13,14 @@ void Figure::setVisible(bool visible){
     this->visible = visible;
 }
 
+bool Figure::storeIn(SceneGeometry& geometry) const{
+    return false;
+}
+
+void Figure::registerMaterials(MaterialTable& table) const{
+    if(material) table.add(material);
+}
+
 void Figure::setMaterial(const std::shared_ptr<Material>& material){
     this->material = material;
 }
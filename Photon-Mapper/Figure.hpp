@@ -4,6 +4,9 @@
 #include "Color.hpp"
 #include "Material.hpp"
 
+class SceneGeometry;
+class MaterialTable;
+
 class Figure: public IntersectableFigure{
 protected:
     bool visible = true;
@@ -13,10 +16,16 @@ public:
     Figure() = default;
     Figure(const std::shared_ptr<Material>& material);
     virtual ~Figure() = default;
-    void setColor(double r, double g, double b);
+    void setColor(Real r, Real g, Real b);
     void setMaterial(const std::shared_ptr<Material>& material);
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override = 0;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override = 0;
     virtual void applyTransform(const Matrix& t) = 0;
+    // Copia la figura a los arrays de su tipo; false si no tiene o no es visible
+    virtual bool storeIn(SceneGeometry& geometry) const;
+    // Añade a la tabla los materiales que pueden aparecer en sus impactos
+    virtual void registerMaterials(MaterialTable& table) const;
+    // Material de todos sus impactos; nullptr si no tiene uno solo
+    virtual std::shared_ptr<Material> uniformMaterial() const { return material; }
     void setVisible(bool visible);
 };
 
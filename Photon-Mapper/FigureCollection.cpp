@@ -1,5 +1,6 @@
 #include "FigureCollection.hpp"
 #include <stdlib.h>
+#include "RenderStats.hpp"
 
 FigureCollection::FigureCollection(){
     this->figureList = std::vector<Figure*>();
@@ -17,10 +18,8 @@ FigureCollection::FigureCollection(std::vector<Figure*> figureList){
     this->figureList = figureList;
 }
 
+// Las figuras pertenecen a quien las crea (pila de main o una Scene)
 FigureCollection::~FigureCollection(){
-    for(size_t i = 0; i < figureList.size(); i++){
-        figureList[i]->~Figure();
-    }
     figureList.clear();
 }
 
@@ -40,10 +39,14 @@ std::vector<Figure*>::iterator FigureCollection::iterator(){
     return this->figureList.begin();
 }
 
-bool FigureCollection::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const{
+bool FigureCollection::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
     Intersection tmp;
     bool anyHit = false;
-    double closest = tMax;
+    Real closest = tMax;
+
+    RenderStats& stats = threadStats();
+    stats.sceneQueries++;
+    stats.primitiveTests += this->figureList.size();
 
     for (const auto& fig : this->figureList) {
         if (fig->isIntersectedBy(ray, tMin, closest, tmp)) {
@@ -15,7 +15,7 @@ public:
     void add(Figure *figure);
     void deleteAll();
     size_t size();
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
     virtual void applyTransform(const Matrix& t) override;
     std::vector<Figure*>::iterator iterator();
     std::vector<Figure*>::iterator begin();
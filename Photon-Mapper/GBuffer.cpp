@@ -0,0 +1,40 @@
+#include "GBuffer.hpp"
+
+void GBuffer::resize(size_t n){
+    for (std::vector<Real>* component : {&px, &py, &pz, &nx, &ny, &nz, &dx, &dy, &dz}){
+        component->resize(n);
+    }
+    materialId.assign(n, NO_MATERIAL);
+}
+
+void GBuffer::set(size_t i, const Ray& ray, const Intersection* hit){
+    dx[i] = ray.dir.x; dy[i] = ray.dir.y; dz[i] = ray.dir.z;
+    if(!hit){
+        materialId[i] = NO_MATERIAL;
+        return;
+    }
+    px[i] = hit->intersectionPoint.x; py[i] = hit->intersectionPoint.y; pz[i] = hit->intersectionPoint.z;
+    nx[i] = hit->normal.x; ny[i] = hit->normal.y; nz[i] = hit->normal.z;
+    materialId[i] = hit->materialId;
+}
+
+Ray GBuffer::ray(size_t i, const Point& origin) const{
+    // La direccion ya esta normalizada: se copia tal cual
+    Ray result;
+    result.origin = origin;
+    result.dir = Vector(dx[i], dy[i], dz[i]);
+    return result;
+}
+
+Intersection GBuffer::intersection(size_t i, const MaterialTable& materials) const{
+    Intersection result;
+    result.intersectionPoint = Point(px[i], py[i], pz[i]);
+    result.normal = Vector(nx[i], ny[i], nz[i]);
+    result.materialId = materialId[i];
+    result.material = materials.get(materialId[i]);
+    return result;
+}
+
+size_t GBuffer::bytes() const{
+    return size() * (9 * sizeof(Real) + sizeof(uint32_t));
+}
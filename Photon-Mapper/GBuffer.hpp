@@ -0,0 +1,26 @@
+#ifndef GBUFFER_HPP
+#define GBUFFER_HPP
+#include <cstdint>
+#include <vector>
+#include "IntersectableFigure.hpp"
+#include "MaterialTable.hpp"
+
+// Primer impacto de cada muestra de camara (punto, normal, direccion del rayo
+// e id del material), un array por componente. Se rellena sin el mapa de
+// fotones y despues se sombrea desde aqui sin volver a trazar el rayo de camara.
+struct GBuffer{
+    std::vector<Real> px, py, pz, nx, ny, nz, dx, dy, dz;
+    std::vector<uint32_t> materialId;   // NO_MATERIAL si el rayo no choca
+
+    void resize(size_t n);
+    size_t size() const { return materialId.size(); }
+    // hit == nullptr: el rayo no choca con nada
+    void set(size_t i, const Ray& ray, const Intersection* hit);
+    bool hit(size_t i) const { return materialId[i] != NO_MATERIAL; }
+    // Rayos de camara: todos salen de origin
+    Ray ray(size_t i, const Point& origin) const;
+    Intersection intersection(size_t i, const MaterialTable& materials) const;
+    size_t bytes() const;
+};
+
+#endif /* GBUFFER_HPP */
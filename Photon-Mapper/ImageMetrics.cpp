@@ -0,0 +1,28 @@
+#include "ImageMetrics.hpp"
+#include <math.h>
+#include <limits>
+#include <stdexcept>
+
+double rmse(const PPM& image, const PPM& reference){
+    if(image.getWidth() != reference.getWidth() || image.getHeight() != reference.getHeight()){
+        throw std::runtime_error("Images of different size cannot be compared");
+    }
+    double sum = 0;
+    for (int32_t i = 0; i < image.getHeight(); i++){
+        for (int32_t j = 0; j < image.getWidth(); j++){
+            const PPM::Pixel& a = image[i][j];
+            const PPM::Pixel& b = reference[i][j];
+            sum += (a.r - b.r) * (a.r - b.r) + (a.g - b.g) * (a.g - b.g) + (a.b - b.b) * (a.b - b.b);
+        }
+    }
+    double samples = 3.0 * image.getWidth() * image.getHeight();
+    return samples > 0 ? sqrt(sum / samples) : 0.0;
+}
+
+double psnr(const PPM& image, const PPM& reference, double peak){
+    double error = rmse(image, reference);
+    if(error == 0){
+        return std::numeric_limits<double>::infinity();
+    }
+    return 20.0 * log10(peak / error);
+}
@@ -0,0 +1,11 @@
+#ifndef IMAGEMETRICS_HPP
+#define IMAGEMETRICS_HPP
+
+#include "PPM.hpp"
+
+// Error entre dos imagenes del mismo tamaño (valores en memoria, tras tone mapping en [0,1])
+double rmse(const PPM& image, const PPM& reference);
+// PSNR en dB respecto a un valor de pico (1.0 para imagenes en [0,1]); infinito si son iguales
+double psnr(const PPM& image, const PPM& reference, double peak = 1.0);
+
+#endif /* IMAGEMETRICS_HPP */
@@ -0,0 +1,53 @@
+#include "Instance.hpp"
+#include "MaterialTable.hpp"
+#include <stdexcept>
+
+Instance::Instance(const std::shared_ptr<const Figure>& geometry, const Matrix& objectToWorld, const std::shared_ptr<Material>& material)
+    : Figure(material), geometry(geometry), objectToWorld(objectToWorld) {
+    if (!geometry) {
+        throw std::runtime_error("Instance without geometry");
+    }
+    updateInverse();
+}
+
+void Instance::updateInverse() {
+    worldToObject = inverse(objectToWorld);
+    normalToWorld = transposeLinear(worldToObject);
+}
+
+bool Instance::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const {
+    if (!this->visible) {
+        return false;
+    }
+
+    // Ray normaliza la direccion: con escala, t en objeto = t en mundo * |M^-1 d|
+    Vector objectDir = worldToObject.transformVector(ray.dir);
+    Real dirScale = module(objectDir);
+    Ray objectRay(worldToObject.transformPoint(ray.origin), objectDir);
+
+    if (!geometry->isIntersectedBy(objectRay, tMin * dirScale, tMax * dirScale, intersection)) {
+        return false;
+    }
+
+    intersection.t /= dirScale;
+    intersection.intersectionPoint = ray.at(intersection.t);
+    intersection.normal = normalize(normalToWorld.transformVector(intersection.normal));
+    if (this->material) {
+        intersection.material = this->material.get();
+    }
+    return true;
+}
+
+void Instance::applyTransform(const Matrix& t) {
+    objectToWorld = AffineMatrix(t) * objectToWorld;
+    updateInverse();
+}
+
+void Instance::registerMaterials(MaterialTable& table) const {
+    Figure::registerMaterials(table);
+    geometry->registerMaterials(table);
+}
+
+std::shared_ptr<Material> Instance::uniformMaterial() const {
+    return this->material ? this->material : geometry->uniformMaterial();
+}
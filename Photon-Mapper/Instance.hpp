@@ -0,0 +1,37 @@
+#ifndef INSTANCE_HPP
+#define INSTANCE_HPP
+
+#include <memory>
+#include "Figure.hpp"
+#include "AffineMatrix.hpp"
+
+// Copia de una geometria compartida colocada con su propia transformacion.
+// La geometria no se modifica: el rayo se pasa a espacio objeto y el resultado
+// se devuelve a espacio mundo, asi mil copias de una malla ocupan una sola malla.
+class Instance : public Figure {
+private:
+    std::shared_ptr<const Figure> geometry;
+    AffineMatrix objectToWorld;
+    AffineMatrix worldToObject;
+    AffineMatrix normalToWorld;   // transpuesta de la inversa, para las normales
+
+    void updateInverse();
+public:
+    // Sin material se usa el de la geometria
+    Instance(const std::shared_ptr<const Figure>& geometry, const Matrix& objectToWorld, const std::shared_ptr<Material>& material = nullptr);
+    virtual ~Instance() = default;
+
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
+    // Compone la transformacion de la instancia, no toca la geometria compartida
+    virtual void applyTransform(const Matrix& t) override;
+    // El material propio y los de la geometria compartida
+    virtual void registerMaterials(MaterialTable& table) const override;
+    // El propio o, si no tiene, el de la geometria
+    virtual std::shared_ptr<Material> uniformMaterial() const override;
+
+    const AffineMatrix& getObjectToWorld() const { return objectToWorld; }
+    const AffineMatrix& getWorldToObject() const { return worldToObject; }
+    const std::shared_ptr<const Figure>& getGeometry() const { return geometry; }
+};
+
+#endif /* INSTANCE_HPP */
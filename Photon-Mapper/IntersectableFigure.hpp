@@ -1,5 +1,6 @@
 #ifndef INTERSECTABLEFIGURE_HPP
 #define INTERSECTABLEFIGURE_HPP
+#include <cstdint>
 #include <memory>
 #include "Ray.hpp"
 #include "Color.hpp"
@@ -7,13 +8,17 @@
 
 class Material;
 
+// Id de material de un impacto fuera de una tabla de materiales (MaterialTable.hpp)
+const uint32_t NO_MATERIAL = UINT32_MAX;
+
 class Intersection{
     public:
-        double t = 0;
+        Real t = 0;
         Vector normal = Vector();
         Point intersectionPoint = Point();
-        std::shared_ptr<Material> material;
-        std::string figureName = ""; 
+        const Material* material = nullptr;     // lo mantiene vivo la figura
+        uint32_t materialId = NO_MATERIAL;
+        const char* figureName = "";
 };
 
 class IntersectableFigure{
@@ -22,7 +27,7 @@ private:
 public:
     IntersectableFigure(/* args */) = default;
     virtual ~IntersectableFigure() = default;
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const = 0;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const = 0;
     
 };
 
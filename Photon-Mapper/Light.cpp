@@ -1,4 +1,7 @@
+#define _USE_MATH_DEFINES
 #include "Light.hpp"
+#include "Utils.hpp"
+#include <math.h>
 
 Light::Light(const Point& center, const Color& power){
     this->center = center;
@@ -10,11 +13,6 @@ Light::Light(){
     this->power = Color(1,1,1);
 }
 
-Light::~Light(){
-    this->center.~Point();
-    this->power.~Color();
-}
-
 Point Light::getCenter() const{
     return this->center;
 }
@@ -23,6 +21,33 @@ Color Light::getPower() const{
     return this->power;
 }
 
+Color Light::flux() const{
+    return 4 * M_PI * this->power;
+}
+
 double Light::intensity() const{
-    return (power.r + power.g + power.b ) / 3.0;
+    Color total = this->flux();
+    return (total.r + total.g + total.b) / 3.0;
+}
+
+bool Light::sample(const Point& from, double u1, double u2, LightSample& sample) const{
+    Vector toLight = this->center - from;
+    double distance = module(toLight);
+    if(distance <= 0){
+        return false;
+    }
+    sample.point = this->center;
+    sample.direction = toLight / distance;
+    sample.distance = distance;
+    sample.radiance = this->power / (distance * distance);
+    return true;
+}
+
+void Light::emit(Point& origin, Vector& direction) const{
+    origin = this->center;
+    direction = randomDirection();
+}
+
+LightBounds Light::bounds() const{
+    return {this->center, this->center, this->intensity(), Vector(0, 0, 1), -1.0, 0.0};
 }
@@ -1,19 +1,48 @@
 #ifndef LIGHT_HPP
 #define LIGHT_HPP
 #include "Point.hpp"
+#include "Vector.hpp"
 #include "Color.hpp"
 
+// Muestra de una luz vista desde un punto de la escena
+struct LightSample{
+    Point point;            // punto muestreado en la luz
+    Vector direction;       // normalizada, hacia la luz
+    double distance;
+    Color radiance;         // radiancia incidente dividida por la pdf (en angulo solido)
+};
+
+// Cotas de una luz (o de un grupo) para el arbol de luces: caja, potencia y
+// cono de normales. Cada normal emite hasta thetaE alrededor de si misma.
+struct LightBounds{
+    Point min, max;
+    double phi;             // potencia, intensity()
+    Vector axis;            // eje del cono de normales (unitario)
+    double cosThetaO;       // apertura del cono de normales (-1 -> todas las direcciones)
+    double cosThetaE;       // apertura de la emision de cada normal (0 -> difusa)
+};
+
+// Luz puntual. Las luces de area (Lights.hpp) redefinen el muestreo y la emision;
+// no forman parte de la geometria, asi que no se ven ni proyectan sombra.
 class Light{
-private:
+protected:
     Point center;
     Color power;
 public:
     Light(const Point& center, const Color& power);
     Light();
-    ~Light();
+    virtual ~Light() = default;
     Point getCenter() const;
     Color getPower() const;
+    // Potencia total emitida (la de una puntual es 4 pi power)
+    virtual Color flux() const;
+    // Media de flux(): peso para repartir muestras y fotones entre luces
     double intensity() const;
+    // u1, u2 en [0, 1); false si la luz no llega a from
+    virtual bool sample(const Point& from, double u1, double u2, LightSample& sample) const;
+    // Origen y direccion de un foton; cada uno lleva flux() / fotones emitidos
+    virtual void emit(Point& origin, Vector& direction) const;
+    virtual LightBounds bounds() const;
 };
 
-#endif /* LIGHT_HPP */
\ No newline at end of file
+#endif /* LIGHT_HPP */
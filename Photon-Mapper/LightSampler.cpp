@@ -0,0 +1,14 @@
+#include "LightSampler.hpp"
+
+LightSampler::LightSampler(const std::vector<std::shared_ptr<Light>>& lights) : lights(lights), tree(lights){
+}
+
+const Light* LightSampler::sample(const Point& point, const Vector& normal, double u, double& pdf) const{
+    int64_t index = this->tree.sample(point, normal, u, pdf);
+    return index < 0 ? nullptr : this->lights[index].get();
+}
+
+const Light* LightSampler::sample(double u, double& pdf) const{
+    int64_t index = this->tree.sample(u, pdf);
+    return index < 0 ? nullptr : this->lights[index].get();
+}
@@ -0,0 +1,28 @@
+#ifndef LIGHTSAMPLER_HPP
+#define LIGHTSAMPLER_HPP
+#include <memory>
+#include <vector>
+#include "Light.hpp"
+#include "LightTree.hpp"
+
+// Luces de la escena con su jerarquia (LightTree): cada muestra de luz
+// directa elige una sola luz en O(log n) segun lo que aporta al punto, y
+// los fotones se reparten por potencia con la misma estructura.
+class LightSampler{
+private:
+    std::vector<std::shared_ptr<Light>> lights;
+    LightTree tree;
+public:
+    LightSampler() = default;
+    LightSampler(const std::vector<std::shared_ptr<Light>>& lights);
+
+    bool empty() const { return lights.empty(); }
+    size_t size() const { return lights.size(); }
+    const std::vector<std::shared_ptr<Light>>& getLights() const { return lights; }
+    // Por contribucion estimada en point; nullptr si ninguna luz llega. u en [0, 1)
+    const Light* sample(const Point& point, const Vector& normal, double u, double& pdf) const;
+    // Por potencia (proporcional a Light::intensity())
+    const Light* sample(double u, double& pdf) const;
+};
+
+#endif /* LIGHTSAMPLER_HPP */
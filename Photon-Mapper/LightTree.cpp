@@ -0,0 +1,296 @@
+#define _USE_MATH_DEFINES
+#include "LightTree.hpp"
+#include <algorithm>
+#include <limits>
+#include <math.h>
+
+namespace {
+    const size_t BUCKETS = 12;
+
+    double clamp1(double x){
+        return std::min(std::max(x, -1.0), 1.0);
+    }
+
+    double safeSqrt(double x){
+        return sqrt(std::max(x, 0.0));
+    }
+
+    // cos(max(0, a - b)) y sin(max(0, a - b)) a partir de senos y cosenos
+    double cosSubClamped(double sinA, double cosA, double sinB, double cosB){
+        if(cosA > cosB) return 1;
+        return cosA * cosB + sinA * sinB;
+    }
+
+    double sinSubClamped(double sinA, double cosA, double sinB, double cosB){
+        if(cosA > cosB) return 0;
+        return sinA * cosB - cosA * sinB;
+    }
+
+    double angleBetween(const Vector& a, const Vector& b){
+        if(dotProduct(a, b) < 0){
+            return M_PI - 2 * asin(std::min<double>(module(a + b) / 2, 1.0));
+        }
+        return 2 * asin(std::min<double>(module(b - a) / 2, 1.0));
+    }
+
+    // v girado theta alrededor del eje unitario k (Rodrigues)
+    Vector rotate(const Vector& v, const Vector& k, double theta){
+        return cos(theta) * v + sin(theta) * crossProduct(k, v) + (1 - cos(theta)) * dotProduct(k, v) * k;
+    }
+
+    // Cono minimo que contiene a los dos
+    void mergeCones(const Vector& axisA, double cosA, const Vector& axisB, double cosB, Vector& axis, double& cosTheta){
+        double thetaA = acos(clamp1(cosA)), thetaB = acos(clamp1(cosB));
+        double thetaD = angleBetween(axisA, axisB);
+        if(std::min(thetaD + thetaB, M_PI) <= thetaA){
+            axis = axisA;
+            cosTheta = cosA;
+            return;
+        }
+        if(std::min(thetaD + thetaA, M_PI) <= thetaB){
+            axis = axisB;
+            cosTheta = cosB;
+            return;
+        }
+        double thetaO = (thetaA + thetaD + thetaB) / 2;
+        Vector k = crossProduct(axisA, axisB);
+        if(thetaO >= M_PI || module(k) < 1e-12){
+            axis = axisA;
+            cosTheta = -1;
+            return;
+        }
+        axis = normalize(rotate(axisA, normalize(k), thetaO - thetaA));
+        cosTheta = cos(thetaO);
+    }
+
+    Vector diagonal(const LightBounds& b){
+        return b.max - b.min;
+    }
+
+    double surfaceArea(const LightBounds& b){
+        Vector d = diagonal(b);
+        return 2 * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    double centroid(const LightBounds& b, int axis){
+        return (b.min[axis] + b.max[axis]) / 2;
+    }
+
+    // Medida de las direcciones del cono de emision (SAOH, Conty y Kulla)
+    double orientationMeasure(const LightBounds& b){
+        double thetaO = acos(clamp1(b.cosThetaO));
+        double thetaE = acos(clamp1(b.cosThetaE));
+        double thetaW = std::min(thetaO + thetaE, M_PI);
+        double sinO = sin(thetaO);
+        return 2 * M_PI * (1 - b.cosThetaO)
+             + M_PI / 2 * (2 * thetaW * sinO - cos(thetaO - 2 * thetaW) - 2 * thetaO * sinO + b.cosThetaO);
+    }
+
+    double splitCost(const LightBounds& b, double kr){
+        return kr * b.phi * orientationMeasure(b) * std::max(surfaceArea(b), 1e-12);
+    }
+}
+
+LightBounds merge(const LightBounds& a, const LightBounds& b){
+    if(a.phi <= 0) return b;
+    if(b.phi <= 0) return a;
+    LightBounds result;
+    result.min = Point(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z));
+    result.max = Point(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z));
+    result.phi = a.phi + b.phi;
+    mergeCones(a.axis, a.cosThetaO, b.axis, b.cosThetaO, result.axis, result.cosThetaO);
+    result.cosThetaE = std::min(a.cosThetaE, b.cosThetaE);
+    return result;
+}
+
+LightTree::Node::Node(const LightBounds& bounds, uint32_t child, bool leaf) : child(child), leaf(leaf){
+    for (int i = 0; i < 3; i++){
+        min[i] = bounds.min[i];
+        max[i] = bounds.max[i];
+        center[i] = (min[i] + max[i]) / 2;
+        axis[i] = bounds.axis[i];
+    }
+    halfDiagonal = module(diagonal(bounds)) / 2;
+    phi = bounds.phi;
+    cosThetaO = bounds.cosThetaO;
+    sinThetaO = safeSqrt(1 - cosThetaO * cosThetaO);
+    cosThetaE = bounds.cosThetaE;
+}
+
+LightTree::LightTree(const std::vector<std::shared_ptr<Light>>& lights){
+    std::vector<std::pair<LightBounds, uint32_t>> bounds;
+    bounds.reserve(lights.size());
+    for (size_t i = 0; i < lights.size(); i++){
+        LightBounds b = lights[i]->bounds();
+        // Las luces sin potencia nunca se eligen
+        if(b.phi > 0) bounds.push_back({b, uint32_t(i)});
+    }
+    if(!bounds.empty()){
+        nodes.reserve(2 * bounds.size() - 1);
+        build(bounds, 0, bounds.size());
+    }
+}
+
+// Particion por cubetas del centroide minimizando el coste SAOH
+uint32_t LightTree::build(std::vector<std::pair<LightBounds, uint32_t>>& lights, size_t begin, size_t end){
+    uint32_t index = uint32_t(nodes.size());
+    if(end - begin == 1){
+        nodes.emplace_back(lights[begin].first, lights[begin].second, true);
+        return index;
+    }
+
+    const LightBounds& first = lights[begin].first;
+    LightBounds total = first;
+    Point cmin(centroid(first, 0), centroid(first, 1), centroid(first, 2)), cmax = cmin;
+    for (size_t i = begin + 1; i < end; i++){
+        total = merge(total, lights[i].first);
+    }
+    for (size_t i = begin; i < end; i++){
+        for (int axis = 0; axis < 3; axis++){
+            Real c = centroid(lights[i].first, axis);
+            cmin[axis] = std::min(cmin[axis], c);
+            cmax[axis] = std::max(cmax[axis], c);
+        }
+    }
+
+    Vector d = diagonal(total);
+    double maxExtent = std::max({d.x, d.y, d.z});
+    double bestCost = std::numeric_limits<double>::infinity();
+    int bestAxis = -1;
+    size_t bestBucket = 0;
+    for (int axis = 0; axis < 3; axis++){
+        double extent = cmax[axis] - cmin[axis];
+        if(extent <= 0) continue;
+        auto bucketOf = [&](const LightBounds& b){
+            size_t bucket = size_t(BUCKETS * (centroid(b, axis) - cmin[axis]) / extent);
+            return std::min(bucket, BUCKETS - 1);
+        };
+        LightBounds buckets[BUCKETS];
+        for (LightBounds& b : buckets) b.phi = 0;
+        for (size_t i = begin; i < end; i++){
+            LightBounds& b = buckets[bucketOf(lights[i].first)];
+            b = merge(b, lights[i].first);
+        }
+        // Penaliza cortar por un eje corto de una caja alargada
+        double kr = d[axis] > 0 ? maxExtent / d[axis] : 1.0;
+        // Cotas acumuladas desde la derecha; la izquierda se acumula al avanzar
+        LightBounds suffix[BUCKETS];
+        suffix[BUCKETS - 1] = buckets[BUCKETS - 1];
+        for (size_t b = BUCKETS - 1; b-- > 0; ){
+            suffix[b] = merge(buckets[b], suffix[b + 1]);
+        }
+        LightBounds left = buckets[0];
+        for (size_t split = 1; split < BUCKETS; left = merge(left, buckets[split]), split++){
+            const LightBounds& right = suffix[split];
+            if(left.phi <= 0 || right.phi <= 0) continue;
+            double cost = splitCost(left, kr) + splitCost(right, kr);
+            if(cost < bestCost){
+                bestCost = cost;
+                bestAxis = axis;
+                bestBucket = split;
+            }
+        }
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    if(bestAxis >= 0){
+        double extent = cmax[bestAxis] - cmin[bestAxis];
+        auto it = std::partition(lights.begin() + begin, lights.begin() + end, [&](const std::pair<LightBounds, uint32_t>& light){
+            size_t bucket = std::min(size_t(BUCKETS * (centroid(light.first, bestAxis) - cmin[bestAxis]) / extent), BUCKETS - 1);
+            return bucket < bestBucket;
+        });
+        size_t split = size_t(it - lights.begin());
+        if(split > begin && split < end) mid = split;
+    }
+
+    nodes.emplace_back(total, 0, false);
+    build(lights, begin, mid);
+    uint32_t right = build(lights, mid, end);
+    nodes[index].child = right;
+    return index;
+}
+
+// Cota superior de la contribucion de las luces del nodo en point
+double LightTree::importance(const Node& node, const double point[3], const double normal[3]){
+    double toPoint[3] = {point[0] - node.center[0], point[1] - node.center[1], point[2] - node.center[2]};
+    double dc2 = toPoint[0] * toPoint[0] + toPoint[1] * toPoint[1] + toPoint[2] * toPoint[2];
+    // Sin explotar cerca de la caja: al menos la mitad de su diagonal
+    double d2 = std::max(dc2, node.halfDiagonal);
+    double invLength = dc2 > 0 ? 1 / sqrt(dc2) : 0;
+    double wi[3] = {toPoint[0] * invLength, toPoint[1] * invLength, dc2 > 0 ? toPoint[2] * invLength : 1.0};
+
+    // Angulo que ocupa la caja vista desde point
+    double cosB = -1;
+    bool inside = point[0] >= node.min[0] && point[0] <= node.max[0] && point[1] >= node.min[1] && point[1] <= node.max[1]
+               && point[2] >= node.min[2] && point[2] <= node.max[2];
+    double r2 = node.halfDiagonal * node.halfDiagonal;
+    if(!inside && dc2 > r2){
+        cosB = safeSqrt(1 - r2 / dc2);
+    }
+    double sinB = safeSqrt(1 - cosB * cosB);
+
+    // Angulo minimo entre el cono de normales y la direccion a point
+    double cosW = node.axis[0] * wi[0] + node.axis[1] * wi[1] + node.axis[2] * wi[2];
+    double sinW = safeSqrt(1 - cosW * cosW);
+    double cosX = cosSubClamped(sinW, cosW, node.sinThetaO, node.cosThetaO);
+    double sinX = sinSubClamped(sinW, cosW, node.sinThetaO, node.cosThetaO);
+    double cosP = cosSubClamped(sinX, cosX, sinB, cosB);
+    if(cosP <= node.cosThetaE) return 0;
+
+    double result = node.phi * cosP / d2;
+    if(normal[0] != 0 || normal[1] != 0 || normal[2] != 0){
+        double cosI = std::abs(wi[0] * normal[0] + wi[1] * normal[1] + wi[2] * normal[2]);
+        double sinI = safeSqrt(1 - cosI * cosI);
+        result *= cosSubClamped(sinI, cosI, sinB, cosB);
+    }
+    return std::max(result, 0.0);
+}
+
+int64_t LightTree::sample(const Point& point, const Vector& normal, double u, double& pdf) const{
+    pdf = 0;
+    if(nodes.empty()) return -1;
+    const double p[3] = {point.x, point.y, point.z};
+    const double n[3] = {normal.x, normal.y, normal.z};
+    double pmf = 1;
+    uint32_t node = 0;
+    while(!nodes[node].leaf){
+        uint32_t left = node + 1, right = nodes[node].child;
+        double importanceLeft = importance(nodes[left], p, n);
+        double importanceRight = importance(nodes[right], p, n);
+        if(importanceLeft <= 0 && importanceRight <= 0) return -1;
+        double probability = importanceLeft / (importanceLeft + importanceRight);
+        if(u < probability){
+            node = left;
+            pmf *= probability;
+            u = std::min(u / probability, 0.99999999999999989);
+        }else{
+            node = right;
+            pmf *= 1 - probability;
+            u = std::min((u - probability) / (1 - probability), 0.99999999999999989);
+        }
+    }
+    if(node == 0 && importance(nodes[0], p, n) <= 0) return -1;
+    pdf = pmf;
+    return nodes[node].child;
+}
+
+int64_t LightTree::sample(double u, double& pdf) const{
+    pdf = 0;
+    if(nodes.empty()) return -1;
+    double pmf = 1;
+    uint32_t node = 0;
+    while(!nodes[node].leaf){
+        double probability = nodes[node + 1].phi / nodes[node].phi;
+        if(u < probability){
+            node = node + 1;
+            pmf *= probability;
+            u = std::min(u / probability, 0.99999999999999989);
+        }else{
+            node = nodes[node].child;
+            pmf *= 1 - probability;
+            u = std::min((u - probability) / (1 - probability), 0.99999999999999989);
+        }
+    }
+    pdf = pmf;
+    return nodes[node].child;
+}
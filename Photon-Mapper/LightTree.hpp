@@ -0,0 +1,47 @@
+#ifndef LIGHTTREE_HPP
+#define LIGHTTREE_HPP
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Light.hpp"
+
+// Jerarquia de luces (BVH con potencia y conos de orientacion, como en
+// Conty y Kulla 2018). Para elegir una luz se baja desde la raiz eligiendo
+// cada hijo en proporcion a su contribucion estimada en el punto: distancia,
+// potencia y orientacion respecto a la luz y a la normal. Una muestra cuesta
+// O(log n) y las luces lejanas o de espaldas casi nunca se eligen.
+class LightTree{
+private:
+    // Cotas en doubles sueltos (sin Point/Vector) para recorrerlas rapido
+    struct Node{
+        double min[3], max[3];
+        double center[3];
+        double halfDiagonal;
+        double axis[3];
+        double phi;
+        double cosThetaO, sinThetaO, cosThetaE;
+        uint32_t child;         // interior: hijo derecho (el izquierdo es el siguiente); hoja: luz
+        bool leaf;
+
+        Node(const LightBounds& bounds, uint32_t child, bool leaf);
+    };
+    std::vector<Node> nodes;    // en profundidad, raiz en 0
+
+    uint32_t build(std::vector<std::pair<LightBounds, uint32_t>>& lights, size_t begin, size_t end);
+    static double importance(const Node& node, const double point[3], const double normal[3]);
+public:
+    LightTree() = default;
+    LightTree(const std::vector<std::shared_ptr<Light>>& lights);
+
+    bool empty() const { return nodes.empty(); }
+    // Indice de luz elegida por su contribucion en point (normal (0,0,0) -> sin normal);
+    // -1 si ninguna llega. u en [0, 1)
+    int64_t sample(const Point& point, const Vector& normal, double u, double& pdf) const;
+    // Indice de luz elegida por potencia; con u estratificados reparte sin sesgo de redondeo
+    int64_t sample(double u, double& pdf) const;
+};
+
+// Union de dos cotas
+LightBounds merge(const LightBounds& a, const LightBounds& b);
+
+#endif /* LIGHTTREE_HPP */
@@ -0,0 +1,318 @@
+#define _USE_MATH_DEFINES
+#include "Lights.hpp"
+#include "Utils.hpp"
+#include "Sampling.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <math.h>
+#include <stdexcept>
+
+namespace {
+    // Por debajo de este angulo solido (o muy cerca de la semiesfera) el muestreo
+    // esferico pierde precision y se muestrea el area
+    const double MIN_SOLID_ANGLE = 3e-4;
+    const double MAX_SOLID_ANGLE = 6.22;
+
+    inline Point offset(const Point& p, const Vector& v){
+        return Point(p.x + v.x, p.y + v.y, p.z + v.z);
+    }
+
+    // Angulo entre vectores unitarios sin perder precision cerca de 0 y de pi
+    double angleBetween(const Vector& a, const Vector& b){
+        if(dotProduct(a, b) < 0){
+            return M_PI - 2 * asin(std::min<double>(module(a + b) / 2, 1.0));
+        }
+        return 2 * asin(std::min<double>(module(b - a) / 2, 1.0));
+    }
+
+    // Parte de v perpendicular al vector unitario w, normalizada
+    Vector orthogonalTo(const Vector& v, const Vector& w){
+        return normalize(v - dotProduct(v, w) * w);
+    }
+
+    // Rellena la muestra a partir de un punto de la superficie elegido por area
+    bool areaSample(const Point& from, const Point& point, const Vector& normal, double area, const Color& radiance, LightSample& sample){
+        Vector toLight = point - from;
+        double distance = module(toLight);
+        if(distance <= 0) return false;
+        Vector direction = toLight / distance;
+        double cosLight = -dotProduct(normal, direction);
+        if(cosLight <= 0) return false;
+        sample.point = point;
+        sample.direction = direction;
+        sample.distance = distance;
+        // pdf en angulo solido: d^2 / (area cos)
+        sample.radiance = radiance * (area * cosLight / (distance * distance));
+        return true;
+    }
+
+    // Direccion sobre el triangulo esferico abc (vectores unitarios) con densidad
+    // uniforme en angulo solido (Arvo 1995); devuelve su angulo solido, 0 si degenera
+    double sampleSphericalTriangle(const Vector& a, const Vector& b, const Vector& c, double u1, double u2, Vector& direction){
+        Vector nab = crossProduct(a, b), nbc = crossProduct(b, c), nca = crossProduct(c, a);
+        if(module(nab) == 0 || module(nbc) == 0 || module(nca) == 0) return 0;
+        nab = normalize(nab);
+        nbc = normalize(nbc);
+        nca = normalize(nca);
+
+        double alpha = angleBetween(nab, -nca);
+        double beta = angleBetween(nbc, -nab);
+        double gamma = angleBetween(nca, -nbc);
+        double solidAngle = alpha + beta + gamma - M_PI;
+        if(solidAngle <= 0) return 0;
+
+        // Arco a-c' que deja el area u1 * solidAngle
+        double areaPi = M_PI + u1 * solidAngle;
+        double cosAlpha = cos(alpha), sinAlpha = sin(alpha);
+        double sinPhi = sin(areaPi) * cosAlpha - cos(areaPi) * sinAlpha;
+        double cosPhi = cos(areaPi) * cosAlpha + sin(areaPi) * sinAlpha;
+        double k1 = cosPhi + cosAlpha;
+        double k2 = sinPhi - sinAlpha * dotProduct(a, b);
+        double cosB = (k2 + (k2 * cosPhi - k1 * sinPhi) * cosAlpha) / ((k2 * sinPhi + k1 * cosPhi) * sinAlpha);
+        cosB = std::min(std::max(cosB, -1.0), 1.0);
+        double sinB = sqrt(std::max(0.0, 1 - cosB * cosB));
+        Vector cp = cosB * a + sinB * orthogonalTo(c, a);
+
+        // Punto del arco b-c'
+        double cosTheta = 1 - u2 * (1 - dotProduct(cp, b));
+        double sinTheta = sqrt(std::max(0.0, 1 - cosTheta * cosTheta));
+        direction = normalize(cosTheta * b + sinTheta * orthogonalTo(cp, b));
+        return solidAngle;
+    }
+}
+
+/* SPHERE */
+Lights::SphereLight::SphereLight(const Point& center, double radius, const Color& radiance): Light(center, radiance){
+    if(radius <= 0) throw std::runtime_error("Sphere light radius must be positive");
+    this->radius = radius;
+}
+
+Color Lights::SphereLight::flux() const{
+    return this->power * (M_PI * 4 * M_PI * radius * radius);
+}
+
+// Cono de direcciones que ve la esfera desde from
+bool Lights::SphereLight::sample(const Point& from, double u1, double u2, LightSample& sample) const{
+    Vector toCenter = this->center - from;
+    double d2 = dotProduct(toCenter, toCenter);
+    double r2 = radius * radius;
+    if(d2 <= r2) return false;      // dentro: solo emite hacia fuera
+
+    double d = sqrt(d2);
+    double sin2Max = r2 / d2;
+    double cosMax = sqrt(1 - sin2Max);
+    double oneMinusCos = sin2Max / (1 + cosMax);   // 1 - cosMax sin cancelacion
+
+    double cosTheta = 1 - u1 * oneMinusCos;
+    double sinTheta = sqrt(std::max(0.0, 1 - cosTheta * cosTheta));
+    double phi = 2 * M_PI * u2;
+    Vector w = toCenter / d, u, v;
+    Sampling::orthonormalBasis(w, u, v);
+    Vector direction = sinTheta * cos(phi) * u + sinTheta * sin(phi) * v + cosTheta * w;
+
+    double distance = d * cosTheta - sqrt(std::max(0.0, r2 - d2 * sinTheta * sinTheta));
+    sample.point = offset(from, distance * direction);
+    sample.direction = direction;
+    sample.distance = distance;
+    sample.radiance = this->power * (2 * M_PI * oneMinusCos);
+    return true;
+}
+
+void Lights::SphereLight::emit(Point& origin, Vector& direction) const{
+    Vector normal = randomDirection();
+    origin = offset(this->center, radius * normal);
+    direction = randomDirection(origin, normal);
+}
+
+LightBounds Lights::SphereLight::bounds() const{
+    Point min(center.x - radius, center.y - radius, center.z - radius);
+    Point max(center.x + radius, center.y + radius, center.z + radius);
+    return {min, max, this->intensity(), Vector(0, 0, 1), -1.0, 0.0};
+}
+
+/* RECTANGLE */
+Lights::RectangleLight::RectangleLight(const Point& corner, const Vector& edge1, const Vector& edge2, const Color& radiance)
+    : Light(offset(corner, 0.5 * edge1 + 0.5 * edge2), radiance), corner(corner), edge1(edge1), edge2(edge2){
+    Vector n = crossProduct(edge1, edge2);
+    this->area = module(n);
+    if(this->area <= 0) throw std::runtime_error("Rectangle light edges must not be parallel");
+    // El muestreo por rectangulo esferico supone un rectangulo; con un
+    // paralelogramo la pdf seria incorrecta (coseno maximo 1e-4 entre aristas)
+    if(std::abs(dotProduct(edge1, edge2)) > 1e-4 * module(edge1) * module(edge2)){
+        throw std::runtime_error("Rectangle light edges must be perpendicular");
+    }
+    this->normal = n / this->area;
+}
+
+Color Lights::RectangleLight::flux() const{
+    return this->power * (M_PI * area);
+}
+
+// Rectangulo esferico (Urena et al. 2013): la direccion es uniforme en el angulo solido
+bool Lights::RectangleLight::sample(const Point& from, double u1, double u2, LightSample& sample) const{
+    Vector d = this->corner - from;
+    if(dotProduct(this->normal, d) >= 0) return false;     // detras de la luz
+
+    double exl = module(edge1), eyl = module(edge2);
+    Vector x = edge1 / exl, y = edge2 / eyl, z = crossProduct(x, y);
+    double x0 = dotProduct(d, x), y0 = dotProduct(d, y), z0 = dotProduct(d, z);
+    if(z0 > 0){
+        z = -z;
+        z0 = -z0;
+    }
+    double x1 = x0 + exl, y1 = y0 + eyl;
+
+    // Normales de los planos que pasan por from y cada arista (coordenadas locales)
+    Vector n0 = normalize(Vector(0, z0, -y0));
+    Vector n1 = normalize(Vector(-z0, 0, x1));
+    Vector n2 = normalize(Vector(0, -z0, y1));
+    Vector n3 = normalize(Vector(z0, 0, -x0));
+    double g0 = acos(std::min(std::max<double>(-dotProduct(n0, n1), -1.0), 1.0));
+    double g1 = acos(std::min(std::max<double>(-dotProduct(n1, n2), -1.0), 1.0));
+    double g2 = acos(std::min(std::max<double>(-dotProduct(n2, n3), -1.0), 1.0));
+    double g3 = acos(std::min(std::max<double>(-dotProduct(n3, n0), -1.0), 1.0));
+    double k = 2 * M_PI - g2 - g3;
+    double solidAngle = g0 + g1 - k;
+
+    if(!(solidAngle > MIN_SOLID_ANGLE && solidAngle < MAX_SOLID_ANGLE)){
+        Point point = offset(this->corner, u1 * edge1 + u2 * edge2);
+        return areaSample(from, point, this->normal, this->area, this->power, sample);
+    }
+
+    double b0 = n0.z, b1 = n2.z;
+    double au = u1 * solidAngle + k;
+    double fu = (cos(au) * b0 - b1) / sin(au);
+    double cu = std::copysign(1.0, fu) / sqrt(fu * fu + b0 * b0);
+    cu = std::min(std::max(cu, -1.0), 1.0);
+    double xu = -(cu * z0) / std::max(sqrt(1 - cu * cu), 1e-12);
+    xu = std::min(std::max(xu, x0), x1);
+    double dist = sqrt(xu * xu + z0 * z0);
+    double h0 = y0 / sqrt(dist * dist + y0 * y0);
+    double h1 = y1 / sqrt(dist * dist + y1 * y1);
+    double hv = h0 + u2 * (h1 - h0);
+    double yv = hv * hv < 1 - 1e-12 ? (hv * dist) / sqrt(1 - hv * hv) : y1;
+
+    Vector toLight = xu * x + yv * y + z0 * z;
+    double distance = module(toLight);
+    sample.point = offset(from, toLight);
+    sample.direction = toLight / distance;
+    sample.distance = distance;
+    sample.radiance = this->power * solidAngle;
+    return true;
+}
+
+void Lights::RectangleLight::emit(Point& origin, Vector& direction) const{
+    origin = offset(this->corner, randomDouble() * edge1 + randomDouble() * edge2);
+    direction = randomDirection(origin, this->normal);
+}
+
+LightBounds Lights::RectangleLight::bounds() const{
+    Point corners[4] = {corner, offset(corner, edge1), offset(corner, edge2), offset(corner, edge1 + edge2)};
+    Point min = corners[0], max = corners[0];
+    for (const Point& p : corners){
+        min = Point(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max = Point(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+    return {min, max, this->intensity(), this->normal, 1.0, 0.0};
+}
+
+/* MESH */
+Lights::MeshLight::MeshLight(std::vector<Real>&& positions, std::vector<uint32_t>&& indices, const Color& radiance)
+    : positions(std::move(positions)), indices(std::move(indices)){
+    this->power = radiance;
+    const size_t count = this->indices.size() / 3;
+    if(count == 0) throw std::runtime_error("Mesh light without triangles");
+    for (uint32_t index : this->indices){
+        if(size_t(index) * 3 + 2 >= this->positions.size()) throw std::runtime_error("Mesh light index out of range");
+    }
+
+    std::vector<double> areas(count);
+    this->normals.resize(3 * count);
+    Vector centroid(0, 0, 0);
+    for (size_t t = 0; t < count; t++){
+        Point a = vertex(this->indices[3 * t]), b = vertex(this->indices[3 * t + 1]), c = vertex(this->indices[3 * t + 2]);
+        Vector n = crossProduct(b - a, c - a);
+        double length = module(n);
+        areas[t] = length / 2;
+        if(length > 0) n = n / length;
+        this->normals[3 * t] = n.x;
+        this->normals[3 * t + 1] = n.y;
+        this->normals[3 * t + 2] = n.z;
+        this->area += areas[t];
+        centroid += (areas[t] / 3) * (Vector(a) + Vector(b) + Vector(c));
+    }
+    if(this->area <= 0) throw std::runtime_error("Mesh light with zero area");
+    this->center = Point(centroid / this->area);
+    this->triangles = AliasTable(areas);
+}
+
+Point Lights::MeshLight::vertex(uint32_t index) const{
+    const Real* p = this->positions.data() + 3 * size_t(index);
+    return Point(p[0], p[1], p[2]);
+}
+
+Color Lights::MeshLight::flux() const{
+    return this->power * (M_PI * area);
+}
+
+bool Lights::MeshLight::sample(const Point& from, double u1, double u2, LightSample& sample) const{
+    // u1 elige el triangulo y se reaprovecha para muestrear dentro
+    size_t t = this->triangles.sample(u1, &u1);
+    double pdf = this->triangles.pdf(t);
+    Point a = vertex(this->indices[3 * t]), b = vertex(this->indices[3 * t + 1]), c = vertex(this->indices[3 * t + 2]);
+    Vector normal(this->normals[3 * t], this->normals[3 * t + 1], this->normals[3 * t + 2]);
+    if(dotProduct(normal, from - a) <= 0) return false;     // cara trasera
+
+    Vector da = a - from, db = b - from, dc = c - from;
+    Vector direction;
+    double solidAngle = sampleSphericalTriangle(normalize(da), normalize(db), normalize(dc), u1, u2, direction);
+    double cosLight = -dotProduct(normal, direction);
+    if(!(solidAngle > MIN_SOLID_ANGLE && solidAngle < MAX_SOLID_ANGLE) || cosLight <= 0){
+        double s = sqrt(u1);
+        Point point = offset(a, s * (1 - u2) * (b - a) + s * u2 * (c - a));
+        if(!areaSample(from, point, normal, pdf * this->area, this->power, sample)) return false;
+        sample.radiance /= pdf;
+        return true;
+    }
+
+    // Corte de la direccion con el plano del triangulo
+    double distance = dotProduct(da, normal) / dotProduct(direction, normal);
+    sample.point = offset(from, distance * direction);
+    sample.direction = direction;
+    sample.distance = distance;
+    sample.radiance = this->power * (solidAngle / pdf);
+    return true;
+}
+
+void Lights::MeshLight::emit(Point& origin, Vector& direction) const{
+    size_t t = this->triangles.sample(randomDouble());
+    Point a = vertex(this->indices[3 * t]), b = vertex(this->indices[3 * t + 1]), c = vertex(this->indices[3 * t + 2]);
+    double s = sqrt(randomDouble()), u = randomDouble();
+    origin = offset(a, s * (1 - u) * (b - a) + s * u * (c - a));
+    direction = randomDirection(origin, Vector(this->normals[3 * t], this->normals[3 * t + 1], this->normals[3 * t + 2]));
+}
+
+// Cono alrededor de la normal media ponderada por area
+LightBounds Lights::MeshLight::bounds() const{
+    const double inf = std::numeric_limits<double>::infinity();
+    Point min(inf, inf, inf), max(-inf, -inf, -inf);
+    for (size_t i = 0; i < this->positions.size(); i += 3){
+        min = Point(std::min(min.x, positions[i]), std::min(min.y, positions[i + 1]), std::min(min.z, positions[i + 2]));
+        max = Point(std::max(max.x, positions[i]), std::max(max.y, positions[i + 1]), std::max(max.z, positions[i + 2]));
+    }
+    Vector axis(0, 0, 0);
+    for (size_t t = 0; t < this->triangleCount(); t++){
+        axis = axis + this->triangles.pdf(t) * Vector(normals[3 * t], normals[3 * t + 1], normals[3 * t + 2]);
+    }
+    double length = module(axis);
+    if(length < 1e-9){
+        return {min, max, this->intensity(), Vector(0, 0, 1), -1.0, 0.0};
+    }
+    axis = axis / length;
+    double cosThetaO = 1.0;
+    for (size_t t = 0; t < this->triangleCount(); t++){
+        if(this->triangles.pdf(t) > 0) cosThetaO = std::min<double>(cosThetaO, dotProduct(axis, Vector(normals[3 * t], normals[3 * t + 1], normals[3 * t + 2])));
+    }
+    return {min, max, this->intensity(), axis, cosThetaO, 0.0};
+}
@@ -0,0 +1,63 @@
+#ifndef LIGHTS_HPP
+#define LIGHTS_HPP
+#include <cstdint>
+#include <vector>
+#include "Light.hpp"
+#include "AliasTable.hpp"
+
+// Luces de area con emision difusa. power es la radiancia emitida; desde lejos
+// equivalen a una puntual de power * area proyectada. Se muestrean por angulo
+// solido, asi que la varianza no crece al acercarse a la luz.
+namespace Lights{
+
+    // Esfera que emite hacia fuera
+    class SphereLight: public Light{
+    private:
+        double radius;
+    public:
+        SphereLight(const Point& center, double radius, const Color& radiance);
+        double getRadius() const { return radius; }
+        Color flux() const override;
+        bool sample(const Point& from, double u1, double u2, LightSample& sample) const override;
+        void emit(Point& origin, Vector& direction) const override;
+        LightBounds bounds() const override;
+    };
+
+    // Rectangulo corner + s * edge1 + t * edge2; lanza si las aristas no son
+    // perpendiculares. Emite por el lado de crossProduct(edge1, edge2)
+    class RectangleLight: public Light{
+    private:
+        Point corner;
+        Vector edge1, edge2;
+        Vector normal;
+        double area;
+    public:
+        RectangleLight(const Point& corner, const Vector& edge1, const Vector& edge2, const Color& radiance);
+        Color flux() const override;
+        bool sample(const Point& from, double u1, double u2, LightSample& sample) const override;
+        void emit(Point& origin, Vector& direction) const override;
+        LightBounds bounds() const override;
+    };
+
+    // Malla emisora (triangulos en el sentido antihorario vistos desde el lado que emite).
+    // Se elige un triangulo por area y dentro se muestrea su angulo solido
+    class MeshLight: public Light{
+    private:
+        std::vector<Real> positions;        // x y z por vertice
+        std::vector<uint32_t> indices;      // 3 por triangulo
+        std::vector<double> normals;        // normal unitaria por triangulo
+        AliasTable triangles;               // por area
+        double area = 0;
+
+        Point vertex(uint32_t index) const;
+    public:
+        MeshLight(std::vector<Real>&& positions, std::vector<uint32_t>&& indices, const Color& radiance);
+        size_t triangleCount() const { return indices.size() / 3; }
+        Color flux() const override;
+        bool sample(const Point& from, double u1, double u2, LightSample& sample) const override;
+        void emit(Point& origin, Vector& direction) const override;
+        LightBounds bounds() const override;
+    };
+
+} // namespace Lights
+#endif /* LIGHTS_HPP */
@@ -0,0 +1,87 @@
+#include "MappedFile.hpp"
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPEDFILE_USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& fileName){
+    this->open(fileName);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept{
+    if(this != &other){
+        this->release();
+        this->buffer = std::move(other.buffer);
+        this->isMapped = other.isMapped;
+        this->mappedSize = other.mappedSize;
+        this->mappedData = this->isMapped ? other.mappedData : this->buffer.data();
+        other.mappedData = nullptr;
+        other.mappedSize = 0;
+        other.isMapped = false;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile(){
+    this->release();
+}
+
+void MappedFile::release(){
+#ifdef MAPPEDFILE_USE_MMAP
+    if(this->isMapped && this->mappedData != nullptr){
+        munmap(const_cast<char*>(this->mappedData), this->mappedSize);
+    }
+#endif
+    this->buffer.clear();
+    this->mappedData = nullptr;
+    this->mappedSize = 0;
+    this->isMapped = false;
+}
+
+void MappedFile::open(const std::string& fileName){
+    this->release();
+#ifdef MAPPEDFILE_USE_MMAP
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if(fd < 0){
+        throw std::runtime_error("Cannot open file: " + fileName);
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0){
+        ::close(fd);
+        throw std::runtime_error("Cannot stat file: " + fileName);
+    }
+    this->mappedSize = static_cast<std::size_t>(st.st_size);
+    if(this->mappedSize > 0){
+        void* addr = mmap(nullptr, this->mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        if(addr == MAP_FAILED){
+            ::close(fd);
+            this->mappedSize = 0;
+            throw std::runtime_error("Cannot map file: " + fileName);
+        }
+        this->mappedData = static_cast<const char*>(addr);
+        this->isMapped = true;
+    }
+    // El mapeo sigue siendo valido tras cerrar el descriptor
+    ::close(fd);
+#else
+    std::ifstream inFile(fileName, std::ios::binary | std::ios::ate);
+    if(!inFile.is_open()){
+        throw std::runtime_error("Cannot open file: " + fileName);
+    }
+    this->mappedSize = static_cast<std::size_t>(inFile.tellg());
+    inFile.seekg(0);
+    this->buffer.resize(this->mappedSize);
+    inFile.read(this->buffer.data(), this->mappedSize);
+    this->mappedData = this->buffer.data();
+#endif
+}
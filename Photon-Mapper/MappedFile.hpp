@@ -0,0 +1,33 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Fichero de solo lectura proyectado en memoria (mmap en POSIX).
+// En plataformas sin mmap el contenido se lee entero a un buffer.
+class MappedFile{
+private:
+    const char* mappedData = nullptr;
+    std::size_t mappedSize = 0;
+    std::vector<char> buffer;
+    bool isMapped = false;
+
+    void release();
+public:
+    MappedFile() = default;
+    MappedFile(const std::string& fileName);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    void open(const std::string& fileName);
+    const char* data() const { return mappedData; }
+    std::size_t size() const { return mappedSize; }
+    bool empty() const { return mappedSize == 0; }
+};
+
+#endif /* MAPPEDFILE_HPP */
@@ -3,8 +3,6 @@
 #include <vector>
 #include <memory>
 #include "IntersectableFigure.hpp"
-#include "Light.hpp"
-#include "PhotonMap.hpp"
 
 class Intersection;
 class IntersectableFigure;
@@ -25,6 +23,15 @@ struct RR_Event{
 /* FUNCTIONS */
 RR_Event russianRoulette(Color kdWeight, Color ksWeight, Color ktWeight);
 
+// Muestra de la BSDF: evento elegido, direccion de salida y peso f * cos / pdf
+struct BSDFSample{
+    RR_EventType eventType;
+    Vector direction;
+    Color weight;
+};
+
+// Los materiales solo muestrean y evaluan su BSDF; el transporte (caminos,
+// luz directa, mapa de fotones) lo hace PathIntegrator
 class Material{
 private:
     Color kd;
@@ -37,15 +44,14 @@ public:
     Material() = default;
     Material(const Color& color);
     Material(const Color& kd, const Color& ks, const Color& kt, double ior);
-    ~Material() = default;
+    virtual ~Material() = default;
     void setColor(const Color& color);
-    virtual Color getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& lights, const IntersectableFigure& scene, const PhotonMap& photonMap, int depth = 0) const;
+    virtual BSDFSample sample(const Ray& ray, const Intersection& intersection) const;
     virtual Color brdf(const Ray& ray, const Intersection& intersection) const;
-    Color nextEvent(const std::vector<std::shared_ptr<Light>>& lights, const Intersection& intersection, const IntersectableFigure& scene) const;
+    // Si el integrador suma luz directa en este material (el mapa de fotones ya la incluye)
+    virtual bool usesNextEvent() const;
     Vector getSacterredVector(const Ray &ray, const Intersection &intersection, const RR_Event event) const;
     Color bsdf(const Ray& ray, const Intersection& intersection, const RR_Event event) const;
-    Color calculateIllumination(const std::vector<const Photon*>& nearestPhotons, const Intersection& intersection) const;
-    friend RR_Event russianRoulette(Material& material);
 };
 
 
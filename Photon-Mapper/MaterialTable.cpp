@@ -0,0 +1,22 @@
+#include "MaterialTable.hpp"
+#include <stdexcept>
+
+uint32_t MaterialTable::add(const std::shared_ptr<Material>& material){
+    if(!material){
+        throw std::runtime_error("MaterialTable: null material");
+    }
+    auto it = ids.find(material.get());
+    if(it != ids.end()) return it->second;
+    if(materials.size() >= NO_MATERIAL){
+        throw std::runtime_error("MaterialTable: too many materials");
+    }
+    uint32_t id = uint32_t(materials.size());
+    materials.push_back(material);
+    ids.emplace(material.get(), id);
+    return id;
+}
+
+uint32_t MaterialTable::find(const Material* material) const{
+    auto it = ids.find(material);
+    return it == ids.end() ? NO_MATERIAL : it->second;
+}
@@ -0,0 +1,29 @@
+#ifndef MATERIALTABLE_HPP
+#define MATERIALTABLE_HPP
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Material.hpp"
+
+// Materiales de una escena, cada uno una sola vez y con un id de 32 bits. Las
+// primitivas y los impactos guardan el id; el render agrupa los impactos por
+// id y resuelve el material una vez por grupo.
+class MaterialTable{
+private:
+    std::vector<std::shared_ptr<Material>> materials;
+    std::unordered_map<const Material*, uint32_t> ids;
+public:
+    MaterialTable() = default;
+
+    // Id del material, añadiendolo si no estaba
+    uint32_t add(const std::shared_ptr<Material>& material);
+    // NO_MATERIAL si no esta en la tabla
+    uint32_t find(const Material* material) const;
+
+    size_t size() const { return materials.size(); }
+    const Material& operator[](uint32_t id) const { return *materials[id]; }
+    const Material* get(uint32_t id) const { return id < materials.size() ? materials[id].get() : nullptr; }
+};
+
+#endif /* MATERIALTABLE_HPP */
@@ -2,11 +2,11 @@
 #define MATERIALS_HPP
 #include "Material.hpp"
 #include "Color.hpp"
-#include "Light.hpp"
 #include "Ray.hpp"
 
 namespace Materials{
 
+    // Difuso puro con luz directa: termina en el mapa de fotones
     class Lambertian: public Material{
     private:
         Color kd = Color(1,1,1);
@@ -15,10 +15,12 @@ namespace Materials{
         Lambertian(const Color& color);
         Lambertian(double r, double g, double b);
         ~Lambertian() = default;
-        virtual Color getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& light, const IntersectableFigure& scene, const PhotonMap& photonMap, int depth = 0) const override;
-        virtual Color brdf(const Ray& ray, const Intersection& intersection) const ;
+        virtual BSDFSample sample(const Ray& ray, const Intersection& intersection) const override;
+        virtual Color brdf(const Ray& ray, const Intersection& intersection) const override;
+        virtual bool usesNextEvent() const override;
     };
 
+    // Espejo con luz directa: el camino sigue por la reflexion
     class Metal: public Material{
     private:
         Color kd = Color(1,1,1);
@@ -27,9 +29,10 @@ namespace Materials{
         Metal(const Color& color);
         Metal(double r, double g, double b);
         ~Metal() = default;
-        virtual Color getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& light, const IntersectableFigure& scene, const PhotonMap& photonMap, int depth = 0) const override;
-        virtual Color brdf(const Ray& ray, const Intersection& intersection) const ;
+        virtual BSDFSample sample(const Ray& ray, const Intersection& intersection) const override;
+        virtual Color brdf(const Ray& ray, const Intersection& intersection) const override;
+        virtual bool usesNextEvent() const override;
     };
 
 } // namespace Materials
-#endif /* MATERIALS_HPP */
\ No newline at end of file
+#endif /* MATERIALS_HPP */
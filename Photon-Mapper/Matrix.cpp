@@ -68,7 +68,7 @@ Matrix transpose(const Matrix& m){
     return result;
 }
 
-Matrix translation(const double new_x, const double new_y, const double new_z){
+Matrix translation(const Real new_x, const Real new_y, const Real new_z){
     Matrix m = identity();
     m[0][3] = new_x;
     m[1][3] = new_y;
@@ -76,7 +76,7 @@ Matrix translation(const double new_x, const double new_y, const double new_z){
     return m;
 }
 
-Matrix rotationX(const double angle){
+Matrix rotationX(const Real angle){
     Matrix m = identity();
     m[1][1] = cos(angle);
     m[1][2] = -sin(angle);
@@ -85,7 +85,7 @@ Matrix rotationX(const double angle){
     return m;
 }
 
-Matrix rotationY(const double angle){
+Matrix rotationY(const Real angle){
     Matrix m = identity();
     m[0][0] = cos(angle);
     m[0][2] = sin(angle);
@@ -94,7 +94,7 @@ Matrix rotationY(const double angle){
     return m;
 }
 
-Matrix rotationZ(const double angle){
+Matrix rotationZ(const Real angle){
     Matrix m = identity();
     m[0][0] = cos(angle);
     m[0][1] = -sin(angle);
@@ -103,7 +103,7 @@ Matrix rotationZ(const double angle){
     return m;
 }
 
-Matrix scale(const double x_scale, const double y_scale, const double z_scale){
+Matrix scale(const Real x_scale, const Real y_scale, const Real z_scale){
     Matrix m = identity();
     m[0][0] = x_scale;
     m[1][1] = y_scale;
@@ -125,7 +125,7 @@ Matrix operator*(const Matrix& m1, const Matrix& m2){
     return result;
 }
 
-Matrix operator*(const Matrix& m, const double c){
+Matrix operator*(const Matrix& m, const Real c){
     Matrix result = Matrix();
     for (size_t i = 0; i < 4; i++){
         for (size_t j = 0; j < 4; j++){
@@ -135,16 +135,16 @@ Matrix operator*(const Matrix& m, const double c){
     return result;
 }
 
-Matrix operator*(const double c, const Matrix& m){
+Matrix operator*(const Real c, const Matrix& m){
     return m * c;
 }
 
 Matrix inverse(const Matrix& m){
     Matrix inv;
-    double det;
-    double invOut[16];
+    Real det;
+    Real invOut[16];
 
-    const double* a = &m.mat[0][0]; // Acceso plano a los datos
+    const Real* a = &m.mat[0][0]; // Acceso plano a los datos
 
     invOut[0] =  a[5]  * a[10] * a[15] - 
                  a[5]  * a[11] * a[14] - 
@@ -266,7 +266,7 @@ Matrix inverse(const Matrix& m){
     det = 1.0 / det;
 
     for (int i = 0; i < 16; i++)
-        reinterpret_cast<double*>(&inv)[i] = invOut[i] * det;
+        reinterpret_cast<Real*>(&inv)[i] = invOut[i] * det;
 
     return inv;
 }
\ No newline at end of file
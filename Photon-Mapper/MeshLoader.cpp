@@ -0,0 +1,484 @@
+#include "MeshLoader.hpp"
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    size_t workerCount(size_t threads){
+        return threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /* OBJ */
+    struct ObjChunk{
+        const char* begin;
+        const char* end;
+        size_t vertices = 0;
+        size_t triangles = 0;
+        size_t firstVertex = 0;
+        size_t firstTriangle = 0;
+    };
+
+    inline bool isBlank(char c){
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* skipBlanks(const char* p, const char* end){
+        while(p < end && isBlank(*p)) p++;
+        return p;
+    }
+
+    inline const char* endOfLine(const char* p, const char* end){
+        const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+        return newline ? newline : end;
+    }
+
+    inline bool isKeyword(const char* p, const char* end, char keyword){
+        return p + 1 < end && p[0] == keyword && (p[1] == ' ' || p[1] == '\t');
+    }
+
+    // Numero de vertices de una linea "f" (sin contar el keyword)
+    size_t countFaceVertices(const char* p, const char* end){
+        size_t n = 0;
+        while(true){
+            p = skipBlanks(p, end);
+            if(p >= end || *p == '#') return n;
+            n++;
+            while(p < end && !isBlank(*p)) p++;
+        }
+    }
+
+    void countObjChunk(ObjChunk& chunk){
+        for (const char* p = chunk.begin; p < chunk.end; ){
+            const char* end = endOfLine(p, chunk.end);
+            const char* line = skipBlanks(p, end);
+            if(isKeyword(line, end, 'v')){
+                chunk.vertices++;
+            }else if(isKeyword(line, end, 'f')){
+                size_t n = countFaceVertices(line + 1, end);
+                if(n >= 3) chunk.triangles += n - 2;
+            }
+            p = end + 1;
+        }
+    }
+
+    inline const char* parseDouble(const char* p, const char* end, double& value){
+        p = skipBlanks(p, end);
+        if(p < end && *p == '+') p++;
+        std::from_chars_result result = std::from_chars(p, end, value);
+        return result.ec == std::errc() ? result.ptr : nullptr;
+    }
+
+    void parseObjChunk(const ObjChunk& chunk, size_t totalVertices, Real* positions, uint32_t* indices, const std::string& fileName){
+        size_t vertex = chunk.firstVertex;
+        uint32_t* triangle = indices + 3 * chunk.firstTriangle;
+
+        for (const char* p = chunk.begin; p < chunk.end; ){
+            const char* end = endOfLine(p, chunk.end);
+            const char* line = skipBlanks(p, end);
+
+            if(isKeyword(line, end, 'v')){
+                Real* out = positions + 3 * vertex;
+                const char* q = line + 1;
+                for (int axis = 0; axis < 3 && q; axis++){
+                    double value = 0;
+                    q = parseDouble(q, end, value);
+                    out[axis] = Real(value);
+                }
+                if(!q){
+                    throw std::runtime_error(fileName + ": malformed vertex");
+                }
+                vertex++;
+            }else if(isKeyword(line, end, 'f')){
+                uint32_t first = 0, previous = 0;
+                size_t n = 0;
+                const char* q = line + 1;
+                while(true){
+                    q = skipBlanks(q, end);
+                    if(q >= end || *q == '#') break;
+                    long long index = 0;
+                    std::from_chars_result result = std::from_chars(q, end, index);
+                    if(result.ec != std::errc()){
+                        throw std::runtime_error(fileName + ": malformed face");
+                    }
+                    // 1-based; negativo -> relativo al ultimo vertice leido
+                    long long resolved = index > 0 ? index - 1 : (long long)vertex + index;
+                    if(index == 0 || resolved < 0 || resolved >= (long long)totalVertices){
+                        throw std::runtime_error(fileName + ": face index out of range: " + std::to_string(index));
+                    }
+                    uint32_t current = uint32_t(resolved);
+                    if(n == 0){
+                        first = current;
+                    }else if(n >= 2){
+                        triangle[0] = first;
+                        triangle[1] = previous;
+                        triangle[2] = current;
+                        triangle += 3;
+                    }
+                    previous = current;
+                    n++;
+                    // Saltar /vt/vn
+                    q = result.ptr;
+                    while(q < end && !isBlank(*q)) q++;
+                }
+            }
+            p = end + 1;
+        }
+    }
+
+    /* PLY */
+    enum class PlyType{ Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+    struct PlyProperty{
+        std::string name;
+        PlyType type;
+        bool isList = false;
+        PlyType countType = PlyType::UInt8;
+    };
+
+    struct PlyElement{
+        std::string name;
+        size_t count = 0;
+        std::vector<PlyProperty> properties;
+    };
+
+    PlyType plyType(const std::string& name, const std::string& fileName){
+        if(name == "char" || name == "int8") return PlyType::Int8;
+        if(name == "uchar" || name == "uint8") return PlyType::UInt8;
+        if(name == "short" || name == "int16") return PlyType::Int16;
+        if(name == "ushort" || name == "uint16") return PlyType::UInt16;
+        if(name == "int" || name == "int32") return PlyType::Int32;
+        if(name == "uint" || name == "uint32") return PlyType::UInt32;
+        if(name == "float" || name == "float32") return PlyType::Float32;
+        if(name == "double" || name == "float64") return PlyType::Float64;
+        throw std::runtime_error(fileName + ": unknown PLY type " + name);
+    }
+
+    size_t plyTypeSize(PlyType type){
+        switch(type){
+            case PlyType::Int8: case PlyType::UInt8: return 1;
+            case PlyType::Int16: case PlyType::UInt16: return 2;
+            case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+            case PlyType::Float64: return 8;
+        }
+        return 0;
+    }
+
+    bool hostIsLittleEndian(){
+        const uint16_t one = 1;
+        unsigned char first;
+        memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    template<typename T>
+    inline T readRaw(const char* p, bool swap){
+        char bytes[sizeof(T)];
+        memcpy(bytes, p, sizeof(T));
+        if(swap) std::reverse(bytes, bytes + sizeof(T));
+        T value;
+        memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    inline double readPlyValue(const char* p, PlyType type, bool swap){
+        switch(type){
+            case PlyType::Int8: return readRaw<int8_t>(p, swap);
+            case PlyType::UInt8: return readRaw<uint8_t>(p, swap);
+            case PlyType::Int16: return readRaw<int16_t>(p, swap);
+            case PlyType::UInt16: return readRaw<uint16_t>(p, swap);
+            case PlyType::Int32: return readRaw<int32_t>(p, swap);
+            case PlyType::UInt32: return readRaw<uint32_t>(p, swap);
+            case PlyType::Float32: return readRaw<float>(p, swap);
+            case PlyType::Float64: return readRaw<double>(p, swap);
+        }
+        return 0;
+    }
+
+    inline uint32_t readPlyIndex(const char* p, PlyType type, bool swap, size_t vertexCount, const std::string& fileName){
+        double index = readPlyValue(p, type, swap);
+        if(index < 0 || index >= double(vertexCount)){
+            throw std::runtime_error(fileName + ": face index out of range");
+        }
+        return uint32_t(index);
+    }
+
+    // Avanza sobre un elemento que no se usa (o sobre el resto de una cara)
+    const char* skipPlyElement(const char* p, const char* end, const PlyElement& element, bool swap, const std::string& fileName){
+        for (size_t i = 0; i < element.count; i++){
+            for (const PlyProperty& property : element.properties){
+                size_t size = plyTypeSize(property.isList ? property.countType : property.type);
+                if(p + size > end) throw std::runtime_error(fileName + ": truncated PLY data");
+                if(property.isList){
+                    size_t n = size_t(readPlyValue(p, property.countType, swap));
+                    size += n * plyTypeSize(property.type);
+                    if(p + size > end) throw std::runtime_error(fileName + ": truncated PLY data");
+                }
+                p += size;
+            }
+        }
+        return p;
+    }
+
+    const char* parsePlyVertices(const char* p, const char* end, const PlyElement& element, bool swap, size_t threads, MeshData& mesh, const std::string& fileName){
+        size_t stride = 0;
+        size_t offset[3] = {0, 0, 0};
+        PlyType type[3] = {PlyType::Float32, PlyType::Float32, PlyType::Float32};
+        bool found[3] = {false, false, false};
+        for (const PlyProperty& property : element.properties){
+            if(property.isList){
+                throw std::runtime_error(fileName + ": list properties in vertex element are not supported");
+            }
+            for (int axis = 0; axis < 3; axis++){
+                if(property.name == std::string(1, char('x' + axis))){
+                    offset[axis] = stride;
+                    type[axis] = property.type;
+                    found[axis] = true;
+                }
+            }
+            stride += plyTypeSize(property.type);
+        }
+        if(!found[0] || !found[1] || !found[2]){
+            throw std::runtime_error(fileName + ": vertex element without x, y, z");
+        }
+        if(size_t(end - p) < element.count * stride){
+            throw std::runtime_error(fileName + ": truncated PLY data");
+        }
+
+        mesh.positions.resize(element.count * 3);
+        Real* positions = mesh.positions.data();
+        const size_t ranges = std::min(element.count, threads * 4);
+        parallelFor(ranges, threads, [&](size_t r){
+            size_t begin = element.count * r / ranges;
+            size_t last = element.count * (r + 1) / ranges;
+            for (size_t i = begin; i < last; i++){
+                const char* vertex = p + i * stride;
+                for (int axis = 0; axis < 3; axis++){
+                    positions[3 * i + axis] = readPlyValue(vertex + offset[axis], type[axis], swap);
+                }
+            }
+        });
+        return p + element.count * stride;
+    }
+
+    const char* parsePlyFaces(const char* p, const char* end, const PlyElement& element, bool swap, size_t threads, MeshData& mesh, const std::string& fileName){
+        size_t listIndex = element.properties.size();
+        for (size_t i = 0; i < element.properties.size(); i++){
+            const PlyProperty& property = element.properties[i];
+            if(property.isList && (property.name == "vertex_indices" || property.name == "vertex_index")){
+                listIndex = i;
+            }
+        }
+        if(listIndex == element.properties.size()){
+            throw std::runtime_error(fileName + ": face element without vertex_indices");
+        }
+        const PlyProperty& list = element.properties[listIndex];
+        const size_t countSize = plyTypeSize(list.countType);
+        const size_t indexSize = plyTypeSize(list.type);
+        const size_t vertexCount = mesh.positions.size() / 3;
+
+        // Caso habitual: solo triangulos -> registros de tamaño fijo, en paralelo.
+        // Es una suposicion: si hay otros poligonos los rangos posteriores leen
+        // registros desalineados, asi que aqui no se lanza nada; un indice fuera
+        // de rango solo es un error si todas las caras resultan ser triangulos
+        const size_t stride = countSize + 3 * indexSize;
+        if(element.properties.size() == 1 && size_t(end - p) >= element.count * stride){
+            mesh.indices.resize(element.count * 3);
+            uint32_t* indices = mesh.indices.data();
+            std::atomic<bool> onlyTriangles{true};
+            std::atomic<bool> outOfRange{false};
+            const size_t ranges = std::min(element.count, threads * 4);
+            parallelFor(ranges, threads, [&](size_t r){
+                size_t begin = element.count * r / ranges;
+                size_t last = element.count * (r + 1) / ranges;
+                for (size_t i = begin; i < last && onlyTriangles.load(std::memory_order_relaxed); i++){
+                    const char* face = p + i * stride;
+                    if(readPlyValue(face, list.countType, swap) != 3){
+                        onlyTriangles = false;
+                        return;
+                    }
+                    for (int k = 0; k < 3; k++){
+                        double index = readPlyValue(face + countSize + k * indexSize, list.type, swap);
+                        if(index < 0 || index >= double(vertexCount)){
+                            outOfRange = true;
+                            index = 0;
+                        }
+                        indices[3 * i + k] = uint32_t(index);
+                    }
+                }
+            });
+            if(onlyTriangles){
+                if(outOfRange) throw std::runtime_error(fileName + ": face index out of range");
+                return p + element.count * stride;
+            }
+            mesh.indices.clear();
+        }
+
+        // Poligonos generales: recorrido secuencial y triangulacion en abanico
+        mesh.indices.reserve(element.count * 3);
+        for (size_t i = 0; i < element.count; i++){
+            for (size_t j = 0; j < element.properties.size(); j++){
+                const PlyProperty& property = element.properties[j];
+                if(!property.isList){
+                    p += plyTypeSize(property.type);
+                    if(p > end) throw std::runtime_error(fileName + ": truncated PLY data");
+                    continue;
+                }
+                if(p + countSize > end) throw std::runtime_error(fileName + ": truncated PLY data");
+                size_t n = size_t(readPlyValue(p, property.countType, swap));
+                p += countSize;
+                size_t itemSize = plyTypeSize(property.type);
+                if(p + n * itemSize > end) throw std::runtime_error(fileName + ": truncated PLY data");
+                if(j == listIndex && n >= 3){
+                    uint32_t first = readPlyIndex(p, property.type, swap, vertexCount, fileName);
+                    uint32_t previous = readPlyIndex(p + itemSize, property.type, swap, vertexCount, fileName);
+                    for (size_t k = 2; k < n; k++){
+                        uint32_t current = readPlyIndex(p + k * itemSize, property.type, swap, vertexCount, fileName);
+                        mesh.indices.insert(mesh.indices.end(), {first, previous, current});
+                        previous = current;
+                    }
+                }
+                p += n * itemSize;
+            }
+        }
+        return p;
+    }
+
+    std::string extension(const std::string& fileName){
+        size_t dot = fileName.find_last_of('.');
+        if(dot == std::string::npos) return "";
+        std::string ext = fileName.substr(dot + 1);
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext;
+    }
+}
+
+MeshData loadObj(const std::string& fileName, size_t threads){
+    MappedFile file(fileName);
+    threads = workerCount(threads);
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    // Trozos de ~1 MB como minimo; cada linea pertenece al trozo donde empieza
+    const size_t chunkCount = std::max<size_t>(1, std::min(threads * 4, file.size() / (1 << 20)));
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char* previous = data;
+    for (size_t c = 0; c < chunkCount; c++){
+        const char* last = data + file.size() * (c + 1) / chunkCount;
+        while(last < end && last > data && last[-1] != '\n') last++;
+        chunks[c].begin = previous;
+        chunks[c].end = last;
+        previous = last;
+    }
+
+    parallelFor(chunkCount, threads, [&](size_t c){ countObjChunk(chunks[c]); });
+
+    size_t totalVertices = 0, totalTriangles = 0;
+    for (ObjChunk& chunk : chunks){
+        chunk.firstVertex = totalVertices;
+        chunk.firstTriangle = totalTriangles;
+        totalVertices += chunk.vertices;
+        totalTriangles += chunk.triangles;
+    }
+    if(totalVertices > UINT32_MAX){
+        throw std::runtime_error(fileName + ": too many vertices");
+    }
+
+    MeshData mesh;
+    mesh.positions.resize(totalVertices * 3);
+    mesh.indices.resize(totalTriangles * 3);
+    parallelFor(chunkCount, threads, [&](size_t c){
+        parseObjChunk(chunks[c], totalVertices, mesh.positions.data(), mesh.indices.data(), fileName);
+    });
+    return mesh;
+}
+
+MeshData loadPly(const std::string& fileName, size_t threads){
+    MappedFile file(fileName);
+    threads = workerCount(threads);
+    const char* data = file.data();
+    const char* end = data + file.size();
+
+    // Cabecera en texto hasta "end_header"
+    std::vector<PlyElement> elements;
+    std::string format;
+    const char* p = data;
+    bool headerDone = false;
+    for (size_t lineNumber = 0; p < end && !headerDone; lineNumber++){
+        const char* lineEnd = endOfLine(p, end);
+        std::string line(p, lineEnd);
+        p = lineEnd + 1;
+        if(!line.empty() && line.back() == '\r') line.pop_back();
+        if(lineNumber == 0){
+            if(line != "ply") throw std::runtime_error(fileName + ": not a PLY file");
+            continue;
+        }
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        if(keyword == "format"){
+            tokens >> format;
+        }else if(keyword == "element"){
+            PlyElement element;
+            tokens >> element.name >> element.count;
+            elements.push_back(element);
+        }else if(keyword == "property"){
+            if(elements.empty()) throw std::runtime_error(fileName + ": property before element");
+            PlyProperty property;
+            std::string type;
+            tokens >> type;
+            if(type == "list"){
+                std::string countType, itemType;
+                tokens >> countType >> itemType;
+                property.isList = true;
+                property.countType = plyType(countType, fileName);
+                property.type = plyType(itemType, fileName);
+            }else{
+                property.type = plyType(type, fileName);
+            }
+            tokens >> property.name;
+            elements.back().properties.push_back(property);
+        }else if(keyword == "end_header"){
+            headerDone = true;
+        }
+    }
+    if(!headerDone){
+        throw std::runtime_error(fileName + ": missing end_header");
+    }
+
+    bool swap;
+    if(format == "binary_little_endian") swap = !hostIsLittleEndian();
+    else if(format == "binary_big_endian") swap = hostIsLittleEndian();
+    else throw std::runtime_error(fileName + ": unsupported PLY format " + format + " (only binary)");
+
+    MeshData mesh;
+    bool hasVertices = false;
+    for (const PlyElement& element : elements){
+        if(element.name == "vertex"){
+            p = parsePlyVertices(p, end, element, swap, threads, mesh, fileName);
+            hasVertices = true;
+        }else if(element.name == "face"){
+            if(!hasVertices) throw std::runtime_error(fileName + ": face element before vertex element");
+            p = parsePlyFaces(p, end, element, swap, threads, mesh, fileName);
+        }else{
+            p = skipPlyElement(p, end, element, swap, fileName);
+        }
+    }
+    return mesh;
+}
+
+MeshData loadMeshData(const std::string& fileName, size_t threads){
+    std::string ext = extension(fileName);
+    if(ext == "obj") return loadObj(fileName, threads);
+    if(ext == "ply") return loadPly(fileName, threads);
+    throw std::runtime_error("Unknown mesh format: " + fileName);
+}
+
+std::shared_ptr<TriangleMesh> loadMesh(const std::string& fileName, const std::shared_ptr<Material>& material, size_t threads){
+    MeshData mesh = loadMeshData(fileName, threads);
+    return std::make_shared<TriangleMesh>(std::move(mesh.positions), std::move(mesh.indices), material);
+}
@@ -0,0 +1,29 @@
+#ifndef MESHLOADER_HPP
+#define MESHLOADER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TriangleMesh.hpp"
+
+// Geometria importada: buffers contiguos listos para TriangleMesh
+struct MeshData{
+    std::vector<Real> positions;        // x y z por vertice
+    std::vector<uint32_t> indices;      // 3 por triangulo (poligonos triangulados en abanico)
+};
+
+// OBJ: solo posiciones ("v") y caras ("f", con o sin /vt/vn, indices negativos).
+// El fichero se proyecta en memoria y se parte en trozos por lineas, cada hilo
+// cuenta y luego escribe sus vertices/triangulos directamente en su rango.
+MeshData loadObj(const std::string& fileName, size_t threads = 0);
+
+// PLY binario (little o big endian): propiedades x, y, z del elemento "vertex"
+// y la lista vertex_indices/vertex_index del elemento "face".
+MeshData loadPly(const std::string& fileName, size_t threads = 0);
+
+// Elige el formato por la extension (.obj / .ply); threads = 0 -> todos los nucleos
+MeshData loadMeshData(const std::string& fileName, size_t threads = 0);
+std::shared_ptr<TriangleMesh> loadMesh(const std::string& fileName, const std::shared_ptr<Material>& material, size_t threads = 0);
+
+#endif /* MESHLOADER_HPP */
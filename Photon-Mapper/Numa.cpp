@@ -0,0 +1,123 @@
+#include "Numa.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace{
+    thread_local size_t pinnedNode = 0;
+
+    // Lista de nucleos o nodos del kernel: "0-23,48-71"
+    std::vector<int> parseCpuList(const std::string& list){
+        std::vector<int> cpus;
+        std::stringstream ss(list);
+        std::string range;
+        while(std::getline(ss, range, ',')){
+            if(range.empty() || range == "\n") continue;
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++){
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    NumaTopology readTopology(){
+        NumaTopology topology;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool haveAllowed = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+        // Los nodos en linea no tienen por que ser consecutivos
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string nodeList;
+        std::getline(online, nodeList);
+        for (int node : parseCpuList(nodeList)){
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string list;
+            std::getline(file, list);
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(list)){
+                if(!haveAllowed || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) cpus.push_back(cpu);
+            }
+            if(!cpus.empty()) topology.nodeCpus.push_back(cpus);
+        }
+#endif
+        if(topology.nodeCpus.empty()){
+            std::vector<int> cpus(std::max(1u, std::thread::hardware_concurrency()));
+            for (size_t i = 0; i < cpus.size(); i++) cpus[i] = int(i);
+            topology.nodeCpus.push_back(cpus);
+        }
+        return topology;
+    }
+
+    void pinTo(const std::vector<int>& cpus){
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus){
+            if(cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        }
+        // Si falla (p.ej. nucleo fuera del cpuset) el hilo sigue sin fijar
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+    }
+}
+
+ThreadAffinity parseAffinity(const std::string& name){
+    if(name == "none" || name == "off") return AFFINITY_NONE;
+    if(name == "core") return AFFINITY_CORE;
+    if(name == "socket" || name == "node") return AFFINITY_SOCKET;
+    throw std::runtime_error("Invalid value for affinity: " + name);
+}
+
+const char* affinityName(ThreadAffinity affinity){
+    switch(affinity){
+        case AFFINITY_CORE: return "core";
+        case AFFINITY_SOCKET: return "socket";
+        default: return "none";
+    }
+}
+
+size_t NumaTopology::cpus() const{
+    size_t total = 0;
+    for (const std::vector<int>& cpus : nodeCpus){
+        total += cpus.size();
+    }
+    return total;
+}
+
+const NumaTopology& NumaTopology::system(){
+    static const NumaTopology topology = readTopology();
+    return topology;
+}
+
+void pinCurrentThread(ThreadAffinity affinity, size_t worker){
+    if(affinity == AFFINITY_NONE) return;
+    const NumaTopology& topology = NumaTopology::system();
+    const size_t node = worker % topology.nodes();
+    const std::vector<int>& cpus = topology.nodeCpus[node];
+    if(affinity == AFFINITY_CORE){
+        pinTo({cpus[(worker / topology.nodes()) % cpus.size()]});
+    }else{
+        pinTo(cpus);
+    }
+    pinnedNode = node;
+}
+
+void pinCurrentThreadToNode(size_t node){
+    const NumaTopology& topology = NumaTopology::system();
+    node %= topology.nodes();
+    pinTo(topology.nodeCpus[node]);
+    pinnedNode = node;
+}
+
+size_t currentNumaNode(){
+    return pinnedNode;
+}
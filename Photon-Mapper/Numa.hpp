@@ -0,0 +1,69 @@
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Afinidad de hilos y nodos NUMA. La topologia se lee de /sys/devices/system/node
+// (Linux) limitada a los nucleos que el proceso puede usar; si no existe hay un
+// solo nodo con todos los nucleos y fijar la afinidad no hace nada.
+enum ThreadAffinity{
+    AFFINITY_NONE,      // el sistema reparte los hilos
+    AFFINITY_CORE,      // cada hilo fijo en un nucleo
+    AFFINITY_SOCKET     // cada hilo fijo en los nucleos de su nodo
+};
+
+// none, core o socket; lanza std::runtime_error con cualquier otro nombre
+ThreadAffinity parseAffinity(const std::string& name);
+const char* affinityName(ThreadAffinity affinity);
+
+struct NumaTopology{
+    std::vector<std::vector<int>> nodeCpus;     // nucleos de cada nodo
+
+    size_t nodes() const { return nodeCpus.size(); }
+    size_t cpus() const;
+    static const NumaTopology& system();
+};
+
+// Fija el hilo actual como el worker-esimo de un pool. Los workers se reparten
+// entre nodos por turnos (0 -> nodo 0, 1 -> nodo 1, ...), asi con pocos hilos
+// ya se usa la memoria de todos los nodos
+void pinCurrentThread(ThreadAffinity affinity, size_t worker);
+void pinCurrentThreadToNode(size_t node);
+// Nodo al que se ha fijado el hilo actual (0 si no se ha fijado)
+size_t currentNumaNode();
+
+// Una copia por nodo de un dato de solo lectura, hecha por un hilo fijo en ese
+// nodo: sus paginas se tocan por primera vez alli y quedan en su memoria. Sin
+// replicate o con un solo nodo no se copia nada y se usa el original.
+template<class T>
+class NodeReplicas{
+private:
+    const T& original;
+    std::vector<std::unique_ptr<T>> copies;
+public:
+    NodeReplicas(const T& original, bool replicate) : original(original){
+        const size_t nodes = NumaTopology::system().nodes();
+        if(!replicate || nodes <= 1) return;
+        copies.resize(nodes);
+        std::vector<std::thread> threads;
+        for (size_t node = 0; node < nodes; node++){
+            threads.emplace_back([this, node]() {
+                pinCurrentThreadToNode(node);
+                copies[node] = std::make_unique<T>(this->original);
+            });
+        }
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+    }
+
+    size_t size() const { return copies.empty() ? 1 : copies.size(); }
+    const T& at(size_t node) const { return copies.empty() ? original : *copies[node]; }
+    // Copia del nodo del hilo actual
+    const T& local() const { return at(currentNumaNode() % size()); }
+};
+
+#endif /* NUMA_HPP */
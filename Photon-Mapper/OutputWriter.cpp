@@ -0,0 +1,78 @@
+#include "OutputWriter.hpp"
+#include <chrono>
+#include <stdexcept>
+
+OutputWriter::OutputWriter(const ToneMappingPipeline& toneMapping, size_t threads, size_t capacity)
+    : toneMapping(toneMapping), threads(threads), capacity(capacity){
+    if(capacity > 0){
+        worker = std::thread(&OutputWriter::run, this);
+    }
+}
+
+OutputWriter::~OutputWriter(){
+    finish();
+}
+
+void OutputWriter::write(Job& job) const{
+    try{
+        Result result;
+        auto start = std::chrono::steady_clock::now();
+        toneMapping.apply(job.image, threads);
+        auto toned = std::chrono::steady_clock::now();
+        job.image.save(job.fileName);
+        auto saved = std::chrono::steady_clock::now();
+        result.toneSeconds = std::chrono::duration<double>(toned - start).count();
+        result.saveSeconds = std::chrono::duration<double>(saved - toned).count();
+        result.image = std::move(job.image);
+        job.result.set_value(std::move(result));
+    }catch(...){
+        job.result.set_exception(std::current_exception());
+    }
+}
+
+void OutputWriter::run(){
+    while(true){
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            notEmpty.wait(lock, [this]() { return stop || !jobs.empty(); });
+            // Con stop se vacia la cola antes de salir
+            if(jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        notFull.notify_one();
+        write(job);
+    }
+}
+
+std::future<OutputWriter::Result> OutputWriter::submit(PPM image, const std::string& fileName){
+    Job job;
+    job.image = std::move(image);
+    job.fileName = fileName;
+    std::future<Result> result = job.result.get_future();
+    if(capacity == 0){
+        write(job);
+        return result;
+    }
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if(stop)
+            throw std::runtime_error("submit on finished OutputWriter");
+        notFull.wait(lock, [this]() { return jobs.size() < capacity; });
+        jobs.push_back(std::move(job));
+    }
+    notEmpty.notify_one();
+    return result;
+}
+
+void OutputWriter::finish(){
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        stop = true;
+    }
+    notEmpty.notify_all();
+    if(worker.joinable()){
+        worker.join();
+    }
+}
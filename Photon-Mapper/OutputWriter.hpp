@@ -0,0 +1,58 @@
+#ifndef OUTPUTWRITER_HPP
+#define OUTPUTWRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "PPM.hpp"
+#include "ToneMapping.hpp"
+#include "Utils.hpp"
+
+// Salida en segundo plano: un hilo aplica el tone mapping y guarda cada imagen
+// mientras el siguiente render avanza. La cola admite como mucho capacity
+// imagenes esperando (mas la que se esta escribiendo); submit se bloquea si
+// esta llena, asi la memoria queda acotada aunque el disco vaya mas lento que
+// el render. Con capacity 0 submit escribe la imagen en el mismo hilo.
+class OutputWriter{
+public:
+    struct Result{
+        PPM image;                  // ya con el tone mapping aplicado
+        double toneSeconds = 0;
+        double saveSeconds = 0;
+    };
+private:
+    struct Job{
+        PPM image;
+        std::string fileName;
+        std::promise<Result> result;
+    };
+
+    ToneMappingPipeline toneMapping;
+    size_t threads;
+    size_t capacity;
+    std::deque<Job> jobs;
+    std::mutex queueMutex;
+    std::condition_variable notEmpty, notFull;
+    bool stop = false;
+    std::thread worker;
+
+    void write(Job& job) const;
+    void run();
+public:
+    // threads: hilos del tone mapping (0 -> todos los nucleos)
+    OutputWriter(const ToneMappingPipeline& toneMapping, size_t threads = 0, size_t capacity = WRITE_QUEUE);
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+    // Termina de escribir las imagenes pendientes
+    ~OutputWriter();
+
+    // Los errores al guardar se relanzan en el get() del future
+    std::future<Result> submit(PPM image, const std::string& fileName);
+    // Espera a que se escriban todas las imagenes enviadas
+    void finish();
+};
+
+#endif /* OUTPUTWRITER_HPP */
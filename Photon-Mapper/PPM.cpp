@@ -1,10 +1,139 @@
 #include "PPM.hpp"
-#include <iostream>
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
 #include <string>
 
 const std::string MAX = "#MAX=";
 
+namespace {
+    // Bytes de texto por tarea al leer un P3
+    const size_t PARSE_CHUNK = 1 << 20;
+    // Filas formateadas en paralelo antes de escribirlas en orden
+    const int32_t SAVE_ROWS = 256;
+
+    struct ValueChunk{
+        const char* begin;
+        const char* end;
+        size_t values = 0;
+        size_t firstValue = 0;
+    };
+
+    inline bool isSpace(char c){
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    inline const char* skipSpaces(const char* p, const char* end){
+        while(p < end && isSpace(*p)) p++;
+        return p;
+    }
+
+    inline const char* endOfToken(const char* p, const char* end){
+        while(p < end && !isSpace(*p)) p++;
+        return p;
+    }
+
+    bool hasExtension(const std::string& fileName, const std::string& extension){
+        if(fileName.size() < extension.size()) return false;
+        return std::equal(extension.rbegin(), extension.rend(), fileName.rbegin(),
+                          [](char a, char b){ return a == std::tolower((unsigned char)b); });
+    }
+
+    bool littleEndianHost(){
+        const uint16_t one = 1;
+        unsigned char first;
+        memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    // Numero del texto [p, end) que termina en espacio o en end. Los enteros de
+    // hasta 18 cifras (lo habitual en un P3) van por un bucle propio; el resto por from_chars
+    inline const char* parseValue(const char* p, const char* end, double& value){
+        const char* q = p;
+        uint64_t n = 0;
+        while(q < end && q - p < 18 && unsigned(*q - '0') < 10){
+            n = n * 10 + unsigned(*q - '0');
+            q++;
+        }
+        if(q > p && (q == end || isSpace(*q))){
+            value = double(n);
+            return q;
+        }
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if(result.ec != std::errc() || (result.ptr < end && !isSpace(*result.ptr))){
+            return nullptr;
+        }
+        return result.ptr;
+    }
+
+    size_t countValues(const char* p, const char* end){
+        size_t n = 0;
+        while(true){
+            p = skipSpaces(p, end);
+            if(p >= end) return n;
+            n++;
+            p = endOfToken(p, end);
+        }
+    }
+
+    // Cabecera de texto: numero despues de saltar espacios y comentarios
+    class HeaderReader{
+    private:
+        const char* p;
+        const char* end;
+        const std::string& fileName;
+    public:
+        double realMaxColorValue = 1.0;
+
+        HeaderReader(const char* begin, const char* end, const std::string& fileName) : p(begin), end(end), fileName(fileName) {}
+
+        // Comentarios; "#MAX=" da el valor real del maximo
+        void skip(){
+            while(true){
+                p = skipSpaces(p, end);
+                if(p >= end || *p != '#') return;
+                const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+                const char* lineEnd = newline ? newline : end;
+                if(size_t(lineEnd - p) >= MAX.size() && std::equal(MAX.begin(), MAX.end(), p)){
+                    double value = 0;
+                    std::from_chars_result result = std::from_chars(p + MAX.size(), lineEnd, value);
+                    if(result.ec != std::errc() || value <= 0){
+                        throw std::runtime_error(fileName + ": invalid " + MAX + " comment");
+                    }
+                    realMaxColorValue = value;
+                }
+                p = lineEnd;
+            }
+        }
+
+        std::string token(){
+            skip();
+            const char* start = p;
+            p = endOfToken(p, end);
+            return std::string(start, p);
+        }
+
+        double number(){
+            skip();
+            double value = 0;
+            const char* start = p < end && *p == '+' ? p + 1 : p;
+            std::from_chars_result result = std::from_chars(start, end, value);
+            if(result.ec != std::errc() || (result.ptr < end && !isSpace(*result.ptr))){
+                throw std::runtime_error(fileName + ": invalid header");
+            }
+            p = result.ptr;
+            return value;
+        }
+
+        const char* position() const { return p; }
+    };
+}
+
 PPM::PPM(int32_t height, int32_t width){
 	this->fileName = "file.ppm";
 	this->version = "P3";
@@ -12,89 +141,191 @@ PPM::PPM(int32_t height, int32_t width){
 	this->height = height;
 	this->width = width;
 	this->maxColorValue = 255.0;
-	this->pixels = std::vector<std::vector<std::shared_ptr<Pixel>>>(this->height);
-	for (int32_t i = 0; i < this->height; i++){
-		this->pixels[i] = std::vector<std::shared_ptr<Pixel>>(this->width);
-	}
+	this->pixels = std::vector<Pixel>(size_t(this->height) * this->width);
 }
 
-double PPM::toMemoryValue(double s){
-	return s * (realMaxColorValue / maxColorValue);
+PPM::PPM(const std::string& fileName, size_t threads){
+    this->load(fileName, threads);
 }
 
-double PPM::toFileValue(double v){
-	return v * (maxColorValue);
-}
+void PPM::load(const std::string& fileName, size_t threads){
+	MappedFile file(fileName);
+	const char* begin = file.data();
+	const char* end = begin + file.size();
 
-PPM::PPM(const std::string& fileName){
-    this->load(fileName);
+	HeaderReader header(begin, end, fileName);
+	std::string magic = header.token();
+	if(magic != "P3" && magic != "PF" && magic != "Pf"){
+		throw std::runtime_error(fileName + ": not a P3 PPM or PFM file");
+	}
+	double w = header.number();
+	double h = header.number();
+	double maxValue = header.number();
+	if(w <= 0 || h <= 0 || w > INT32_MAX || h > INT32_MAX || maxValue == 0 || (magic == "P3" && maxValue < 0)){
+		throw std::runtime_error(fileName + ": invalid header");
+	}
+
+	this->fileName = fileName;
+	this->version = magic;
+	this->width = int32_t(w);
+	this->height = int32_t(h);
+	this->pixels = std::vector<Pixel>(size_t(this->height) * this->width);
+
+	if(magic == "P3"){
+		this->realMaxColorValue = header.realMaxColorValue;
+		this->maxColorValue = maxValue;
+		this->loadText(header.position(), end, threads);
+	}else{
+		// Un unico espacio separa la cabecera de los datos binarios
+		this->loadFloat(header.position() + 1, end, magic == "PF" ? 3 : 1, maxValue < 0);
+	}
 }
 
-PPM::~PPM(){
-	(this->pixels).clear();
+// Dos pasadas en paralelo sobre trozos cortados en un espacio: contar valores
+// (da la posicion de cada trozo en el buffer) y convertirlos en su sitio
+void PPM::loadText(const char* begin, const char* end, size_t threads){
+	std::vector<ValueChunk> chunks;
+	for (const char* p = begin; p < end; ){
+		const char* last = endOfToken(std::min(p + PARSE_CHUNK, end), end);
+		chunks.push_back({p, last});
+		p = last;
+	}
+
+	parallelFor(chunks.size(), threads, [&](size_t i){
+		chunks[i].values = countValues(chunks[i].begin, chunks[i].end);
+	});
+	size_t total = 0;
+	for (ValueChunk& chunk : chunks){
+		chunk.firstValue = total;
+		total += chunk.values;
+	}
+	const size_t expected = 3 * this->pixels.size();
+	if(total != expected){
+		throw std::runtime_error(this->fileName + ": expected " + std::to_string(expected)
+		                         + " values, found " + std::to_string(total));
+	}
+
+	const double scale = this->realMaxColorValue / this->maxColorValue;
+	Real* values = this->data();
+	parallelFor(chunks.size(), threads, [&](size_t i){
+		Real* out = values + chunks[i].firstValue;
+		const char* p = chunks[i].begin;
+		const char* chunkEnd = chunks[i].end;
+		while((p = skipSpaces(p, chunkEnd)) < chunkEnd){
+			double value;
+			p = parseValue(p, chunkEnd, value);
+			if(!p){
+				throw std::runtime_error(this->fileName + ": invalid number");
+			}
+			*out++ = value * scale;
+		}
+	});
 }
 
-void PPM::load(const std::string& fileName){
-    std::ifstream inFile(fileName);
-    
-	if(inFile.is_open()){
-		this->fileName = fileName;
-
-		inFile >> this->version;
-		
-		std::string tmp;
-		inFile >> tmp;
-		tmp = tmp.replace(tmp.begin(), tmp.begin() + MAX.size(), "");
-		this->realMaxColorValue = std::stod(tmp);
-//		std::getchar();
-		inFile.ignore(INT64_MAX,'\n');
-		inFile.ignore(INT64_MAX,'\n');
-
-		inFile >> this->width;
-		inFile >> this->height;
-
-		inFile >> this->maxColorValue;
-
-		double r, g, b;
-		this->pixels = std::vector<std::vector<std::shared_ptr<Pixel>>>(this->height);
-		for (int32_t i = 0; i < this->height; i++){
-			this->pixels[i] = std::vector<std::shared_ptr<Pixel>>(this->width);
-			for (int32_t j = 0; j < this->width; j++){
-				inFile >> r >> g >> b;
-				this->pixels[i][j] = std::make_shared<Pixel>(
-											toMemoryValue(r),
-											toMemoryValue(g),
-											toMemoryValue(b)
-									);
+// PFM: floats de 32 bits, filas de abajo a arriba; escala negativa -> little endian
+void PPM::loadFloat(const char* begin, const char* end, int channels, bool littleEndian){
+	const size_t rowValues = size_t(this->width) * channels;
+	if(begin > end || size_t(end - begin) < rowValues * this->height * sizeof(float)){
+		throw std::runtime_error(this->fileName + ": truncated PFM data");
+	}
+	const bool swap = littleEndian != littleEndianHost();
+	double maxValue = 0;
+	for (int32_t y = 0; y < this->height; y++){
+		const char* row = begin + (this->height - 1 - y) * rowValues * sizeof(float);
+		Pixel* out = (*this)[y];
+		for (int32_t x = 0; x < this->width; x++){
+			float rgb[3] = {0, 0, 0};
+			for (int c = 0; c < channels; c++){
+				unsigned char bytes[4];
+				memcpy(bytes, row + (size_t(x) * channels + c) * sizeof(float), 4);
+				if(swap){
+					std::swap(bytes[0], bytes[3]);
+					std::swap(bytes[1], bytes[2]);
+				}
+				memcpy(&rgb[c], bytes, 4);
+			}
+			if(channels == 1){
+				rgb[1] = rgb[2] = rgb[0];
 			}
+			out[x] = Pixel(rgb[0], rgb[1], rgb[2]);
+			maxValue = std::max<double>({maxValue, out[x].r, out[x].g, out[x].b});
 		}
+	}
+	// Los valores ya estan en memoria tal cual; el maximo real es el de los datos
+	this->realMaxColorValue = maxValue > 0 ? maxValue : 1.0;
+	this->maxColorValue = 255.0;
+}
 
-	} else{
+void PPM::save(const std::string& fileName, size_t threads){
+	if(hasExtension(fileName, ".pfm")){
+		this->saveFloat(fileName);
 		return;
 	}
+	std::ofstream outFile(fileName, std::ios::binary);
+	if(!outFile.is_open()){
+		throw std::runtime_error("Cannot create " + fileName);
+	}
+	outFile << "P3" << std::endl;
+	outFile << MAX << this->realMaxColorValue << std::endl;
+	outFile << this->width << ' ' << this->height << std::endl;
+	outFile << this->maxColorValue << std::endl;
 
-	inFile.close();
+	// Mismo formato que operator<< por defecto (6 cifras significativas):
+	// "r g b\t" por pixel y una fila por linea. Hasta ~14 caracteres por valor
+	const double scale = this->maxColorValue / this->realMaxColorValue;
+	const size_t lineSize = size_t(this->width) * 3 * 16 + 2;
+	std::vector<std::vector<char>> lines(std::min(SAVE_ROWS, this->height), std::vector<char>(lineSize));
+	std::vector<size_t> lengths(lines.size());
+	for (int32_t first = 0; first < this->height; first += SAVE_ROWS){
+		int32_t rows = std::min(SAVE_ROWS, this->height - first);
+		parallelFor(size_t(rows), this->pixels.size() < 65536 ? 1 : threads, [&](size_t r){
+			const Real* values = this->data() + 3 * size_t(first + r) * this->width;
+			char* out = lines[r].data();
+			char* last = out + lineSize;
+			for (int32_t i = 0; i < 3 * this->width; i++){
+				out = std::to_chars(out, last, values[i] * scale, std::chars_format::general, 6).ptr;
+				*out++ = (i % 3 == 2) ? '\t' : ' ';
+			}
+			*out++ = '\n';
+			lengths[r] = out - lines[r].data();
+		});
+		for (int32_t r = 0; r < rows; r++){
+			outFile.write(lines[r].data(), lengths[r]);
+		}
+	}
+	outFile.close();
+	if(outFile.fail()){
+		throw std::runtime_error("Error writing " + fileName);
+	}
 }
 
-void PPM::save(const std::string& fileName){
-	std::ofstream outFile(fileName);
-
-	if(outFile.is_open()){
-		outFile << this->version << std::endl;
-		outFile << MAX << this->realMaxColorValue << std::endl;
-		outFile << this->width << ' ' << this->height << std::endl;
-		outFile << this->maxColorValue << std::endl;
-
-		//outFile << std::fixed;
-		for (int32_t i = 0; i < this->height; i++){
-			for (int32_t j = 0; j < this->width; j++){
-				Pixel p = *pixels[i][j].get();
-				outFile << toFileValue(p.r) << " " << toFileValue(p.g) << " " << toFileValue(p.b) << '\t';
+// PFM en little endian con los valores de memoria (escala -1)
+void PPM::saveFloat(const std::string& fileName){
+	std::ofstream outFile(fileName, std::ios::binary);
+	if(!outFile.is_open()){
+		throw std::runtime_error("Cannot create " + fileName);
+	}
+	outFile << "PF\n" << this->width << ' ' << this->height << "\n-1.0\n";
+	const bool swap = !littleEndianHost();
+	std::vector<float> row(3 * size_t(this->width));
+	for (int32_t y = this->height - 1; y >= 0; y--){
+		const Real* values = this->data() + 3 * size_t(y) * this->width;
+		for (size_t i = 0; i < row.size(); i++){
+			row[i] = float(values[i]);
+			if(swap){
+				unsigned char bytes[4];
+				memcpy(bytes, &row[i], 4);
+				std::swap(bytes[0], bytes[3]);
+				std::swap(bytes[1], bytes[2]);
+				memcpy(&row[i], bytes, 4);
 			}
-			outFile << std::endl;
 		}
+		outFile.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(float));
 	}
 	outFile.close();
+	if(outFile.fail()){
+		throw std::runtime_error("Error writing " + fileName);
+	}
 }
 
 std::ostream& operator<<(std::ostream& os, const PPM& image){
@@ -104,4 +335,4 @@ std::ostream& operator<<(std::ostream& os, const PPM& image){
 	os << image.width << " " << image.height << std::endl;
 	os << image.maxColorValue << std::endl;
 	return os;
-}
\ No newline at end of file
+}
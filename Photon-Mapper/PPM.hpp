@@ -8,13 +8,14 @@
 class PPM{
 public:
     struct Pixel{
-        double r, g, b;
+        Real r, g, b;
+        Pixel() : r(0), g(0), b(0) {}
         Pixel(Color color){
             this->r = color.r;
             this->g = color.g;
             this->b = color.b;
         }
-        Pixel(double r, double g, double b){
+        Pixel(Real r, Real g, Real b){
             this->r = r;
             this->g = g;
             this->b = b;
@@ -26,30 +27,37 @@ private:
     double realMaxColorValue;
     int32_t height, width;
     double maxColorValue;    
-    std::vector<std::vector<std::shared_ptr<Pixel>>> pixels;
+    std::vector<Pixel> pixels;      // fila a fila, contiguos
 
 private:
-    double toMemoryValue(double s);
-    double toFileValue(double v);
+    void loadText(const char* begin, const char* end, size_t threads);
+    void loadFloat(const char* begin, const char* end, int channels, bool littleEndian);
+    void saveFloat(const std::string& fileName);
 
 public:
-    PPM(const std::string& fileName);
+    PPM(const std::string& fileName, size_t threads = 0);
     PPM() = default;
     PPM(int32_t height, int32_t width);
-    ~PPM();
 
-    void load(const std::string& fileName);
-    void save(const std::string& fileName = "out.ppm");
-    std::vector<std::shared_ptr<Pixel>>& operator[](std::size_t idx){ return pixels[idx]; }
-    const std::vector<std::shared_ptr<Pixel>>& operator[](std::size_t idx) const{ return pixels[idx]; }
+    // P3 (texto, con #MAX=) o PFM (PF/Pf, floats); lanza std::runtime_error si no se puede leer.
+    // El texto se convierte en paralelo directamente sobre los pixeles
+    void load(const std::string& fileName, size_t threads = 0);
+    // Extension .pfm -> PFM; cualquier otra -> P3
+    void save(const std::string& fileName = "out.ppm", size_t threads = 0);
+    int32_t getWidth() const { return width; }
+    int32_t getHeight() const { return height; }
+    // Fila idx: image[y][x]
+    Pixel* operator[](std::size_t idx){ return pixels.data() + idx * width; }
+    const Pixel* operator[](std::size_t idx) const{ return pixels.data() + idx * width; }
+    // Canales r g b de todos los pixeles seguidos (3 * width * height valores)
+    Real* data(){ return reinterpret_cast<Real*>(pixels.data()); }
+    const Real* data() const{ return reinterpret_cast<const Real*>(pixels.data()); }
     friend std::ostream& operator<<(std::ostream& os, const PPM& image);
 
-    friend void clamping(PPM& image, double clampValue);
-    friend void equalization(PPM& image);
-    friend void equalizationAndClamping(PPM& image, const double clampValue);
-    friend void gamma(PPM& image, double gammaValue);
-    friend void gammaAndClamping(PPM& image, double gammaValue, double clampValue);  
+    friend class ToneMappingPipeline;
 };
 
 
+static_assert(sizeof(PPM::Pixel) == 3 * sizeof(Real), "PPM::Pixel must be three packed Reals");
+
 #endif /*PPM_HPP*/
\ No newline at end of file
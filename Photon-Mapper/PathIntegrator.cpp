@@ -0,0 +1,143 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <algorithm>
+#include <limits>
+#include <limits.h>
+#include "PathIntegrator.hpp"
+#include "Material.hpp"
+#include "Utils.hpp"
+#include "RenderStats.hpp"
+#include "Arena.hpp"
+
+PathIntegrator::PathIntegrator(const IntersectableFigure& scene, const LightSampler& lights, const PhotonMap& photonMap, const RenderSettings& settings)
+    : scene(scene), lights(lights), photonMap(photonMap), settings(settings) {}
+
+Color PathIntegrator::radiance(const Ray& ray) const{
+    RenderStats& stats = threadStats();
+    stats.primaryRays++;
+    Intersection intersection;
+    if(!scene.isIntersectedBy(ray, ray.epsilon(), INT_MAX, intersection)){
+        return Color(0, 0, 0);
+    }
+    return radiance(ray, intersection);
+}
+
+Color PathIntegrator::radiance(const Ray& ray, const Intersection& firstHit) const{
+    // Los temporales de la muestra (vecinos de cada estimacion) van a la arena del hilo
+    ArenaScope scope;
+    Color result(0, 0, 0);
+    for (size_t path = 0; path < settings.maxPaths; path++){
+        result += tracePath(ray, firstHit);
+    }
+    return result / double(std::max<size_t>(settings.maxPaths, 1));
+}
+
+Color PathIntegrator::tracePath(Ray ray, Intersection intersection) const{
+    RenderStats& stats = threadStats();
+    Color result(0, 0, 0);
+    Color throughput(1, 1, 1);
+    size_t bounce = 0;
+    for (; bounce < settings.maxBounces; bounce++){
+        const Material& material = *intersection.material;
+        if(material.usesNextEvent()){
+            result += throughput * nextEvent(intersection);
+        }
+        Vector direction;
+        if(!scatter(material, ray, intersection, bounce, throughput, result, direction)){
+            break;
+        }
+        ray = Ray(intersection.intersectionPoint, direction);
+        stats.secondaryRays++;
+        if(!scene.isIntersectedBy(ray, ray.epsilon(), INT_MAX, intersection)){
+            break;
+        }
+    }
+    stats.pathBounces[std::min(bounce, STATS_MAX_BOUNCES)]++;
+    return result;
+}
+
+bool PathIntegrator::scatter(const Material& material, const Ray& ray, const Intersection& intersection, size_t bounce, Color& throughput, Color& result, Vector& direction) const{
+    RenderStats& stats = threadStats();
+    BSDFSample sample = material.sample(ray, intersection);
+    stats.rrEvents[sample.eventType]++;
+    if(sample.eventType == ABSORTION){
+        return false;
+    }
+    if(sample.eventType == DIFUSSE){
+        result += throughput * sample.weight * photonEstimate(intersection);
+        return false;
+    }
+    throughput = throughput * sample.weight;
+
+    // Ruleta rusa: sobrevive con probabilidad igual al throughput (acotada)
+    if(bounce + 1 >= settings.rouletteDepth){
+        double survive = std::min<double>(maxComponent(throughput), 0.95);
+        if(randomDouble() >= survive){
+            stats.pathsTerminated++;
+            return false;
+        }
+        throughput /= survive;
+    }
+    direction = sample.direction;
+    return true;
+}
+
+// Una sola luz por muestra, elegida por su contribucion estimada en el punto:
+// el coste apenas depende del numero de luces y el valor esperado es la suma de todas
+bool PathIntegrator::sampleDirect(const Material& material, const Intersection& intersection, Ray& shadowRay, double& distance, Color& contribution) const{
+    double lightPdf;
+    const Light* light = lights.sample(intersection.intersectionPoint, intersection.normal, randomDouble(), lightPdf);
+    LightSample sample;
+    if(!light || lightPdf <= 0 || !light->sample(intersection.intersectionPoint, randomDouble(), randomDouble(), sample)){
+        return false;
+    }
+    shadowRay = Ray(intersection.intersectionPoint, sample.direction);
+    distance = sample.distance;
+    Color brdf = material.brdf(Ray(), intersection);
+    double cosine = abs(dotProduct(intersection.normal, sample.direction));
+    contribution = sample.radiance * brdf * cosine / lightPdf;
+    return true;
+}
+
+Color PathIntegrator::nextEvent(const Intersection& intersection) const{
+    Ray shadowRay;
+    double distance;
+    Color contribution;
+    if(!sampleDirect(*intersection.material, intersection, shadowRay, distance, contribution)){
+        return Color(0, 0, 0);
+    }
+    Intersection shadowIntersection;
+    threadStats().shadowRays++;
+    if(scene.isIntersectedBy(shadowRay, shadowRay.epsilon(), distance, shadowIntersection)){
+        return Color(0, 0, 0);
+    }
+    return contribution;
+}
+
+// Nucleo de Silverman sobre el radio del foton mas lejano
+Color PathIntegrator::photonEstimate(const Intersection& intersection) const{
+    // Vecinos en la arena del hilo: se liberan al terminar la muestra (radiance)
+    ArenaVector<const Photon*> nearestPhotons;
+    nearestPhotons.reserve(settings.neighbors + 1);
+    search_nearest(photonMap, intersection.intersectionPoint, settings.neighbors, std::numeric_limits<float>::infinity(), nearestPhotons);
+    if(nearestPhotons.empty()){
+        return Color(0, 0, 0);
+    }
+
+    double r = 0;
+    for (const Photon* photon : nearestPhotons){
+        r = std::max<double>(r, module(photon->getPosition() - intersection.intersectionPoint));
+    }
+
+    const double alpha = 0.918;
+    const double beta = 1.953;
+    const double d = 1 - std::exp(-beta);
+    Color result(0, 0, 0);
+    for (const Photon* photon : nearestPhotons){
+        double dist = module(photon->getPosition() - intersection.intersectionPoint);
+        double u = 1 - std::exp(-beta * (dist * dist) / (2 * r * r));
+        double kernelWeight = alpha * (1 - (u / d));
+        result += photon->getFlux() * kernelWeight;
+    }
+    return result / (M_PI * r * r);
+}
@@ -0,0 +1,40 @@
+#ifndef PATHINTEGRATOR_HPP
+#define PATHINTEGRATOR_HPP
+#include "IntersectableFigure.hpp"
+#include "LightSampler.hpp"
+#include "PhotonMap.hpp"
+#include "RenderSettings.hpp"
+
+// Integrador iterativo: el camino (rayo, throughput y radiancia) vive en un
+// bucle y los materiales solo muestrean y evaluan su BSDF.
+//  - Los eventos difusos terminan con la estimacion del mapa de fotones.
+//  - Los especulares y refractivos siguen el camino hasta settings.maxBounces.
+//  - Pasados settings.rouletteDepth rebotes el camino se corta con ruleta
+//    rusa segun su throughput (y el que sobrevive se repondera).
+class PathIntegrator{
+private:
+    const IntersectableFigure& scene;
+    const LightSampler& lights;
+    const PhotonMap& photonMap;
+    const RenderSettings& settings;
+
+    Color tracePath(Ray ray, Intersection intersection) const;
+public:
+    PathIntegrator(const IntersectableFigure& scene, const LightSampler& lights, const PhotonMap& photonMap, const RenderSettings& settings);
+
+    // Radiancia que llega por ray; settings.maxPaths caminos desde el primer impacto
+    Color radiance(const Ray& ray) const;
+    // Igual, con el primer impacto ya calculado (G-buffer del render en tuberia)
+    Color radiance(const Ray& ray, const Intersection& firstHit) const;
+    // Luz directa de una sola luz elegida por el arbol de luces
+    Color nextEvent(const Intersection& intersection) const;
+    // nextEvent sin trazar la sombra: rayo de sombra, distancia y contribucion si no hay oclusion
+    bool sampleDirect(const Material& material, const Intersection& intersection, Ray& shadowRay, double& distance, Color& contribution) const;
+    // Un vertice del camino: muestrea la BSDF, suma en result lo que termina aqui (mapa de
+    // fotones), actualiza throughput con la ruleta rusa y devuelve false si el camino acaba
+    bool scatter(const Material& material, const Ray& ray, const Intersection& intersection, size_t bounce, Color& throughput, Color& result, Vector& direction) const;
+    // Estimacion de densidad con los settings.neighbors fotones mas cercanos
+    Color photonEstimate(const Intersection& intersection) const;
+};
+
+#endif /* PATHINTEGRATOR_HPP */
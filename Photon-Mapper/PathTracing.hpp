@@ -17,14 +17,30 @@
 #include "Cylinder.hpp"
 #include "Triangle.hpp"
 #include "TriangleMesh.hpp"
+#include "Instance.hpp"
+#include "MeshLoader.hpp"
+#include "SceneLoader.hpp"
 #include "Plane.hpp"
 #include "Camera.hpp"
+#include "PathIntegrator.hpp"
+#include "WavefrontRenderer.hpp"
+#include "RayBinning.hpp"
 #include "PPM.hpp"
+#include "ToneMapping.hpp"
+#include "OutputWriter.hpp"
+#include "Numa.hpp"
 #include "FigureCollection.hpp"
+#include "SceneGeometry.hpp"
+#include "MaterialTable.hpp"
 #include "Light.hpp"
+#include "Lights.hpp"
+#include "LightSampler.hpp"
 #include "Materials.hpp"
 #include "Color.hpp"
 #include "ScopedTimer.hpp"
+#include "RenderStats.hpp"
 #include "Utils.hpp"
+#include "Sampling.hpp"
+#include "RenderSettings.hpp"
 
 #endif /* PATHTRACING_HPP */
\ No newline at end of file
@@ -1,4 +1,10 @@
 #include "PhotonMap.hpp"
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <stdexcept>
+#include "MappedFile.hpp"
+#include "RenderStats.hpp"
 
 Photon::Photon(const Point &pos, const Vector& incident, const Color& flux){
     this->pos = pos;    
@@ -11,21 +17,131 @@ PhotonMap newPhotonMap(const std::vector<Photon>& photons){
 }
 
 std::vector<const Photon*> search_nearest(const PhotonMap& map, const Point& query_position, unsigned long nphotons_estimate, float radius_estimate){
-    return map.nearest_neighbors(
+    RenderStats& stats = threadStats();
+    std::size_t visited = 0;
+    auto nearest = map.nearest_neighbors_counted(
         query_position,
         nphotons_estimate,
-        radius_estimate
+        radius_estimate,
+        visited
     );
+    stats.photonQueries++;
+    stats.kdNodesVisited += visited;
+    return nearest;
 }
 
 std::vector<const Photon*> search_nearest(const PhotonMap& map, const Point& query_position, unsigned long nphotons_estimate){
-    return map.nearest_neighbors(
-        query_position,
-        nphotons_estimate
-    );
+    return search_nearest(map, query_position, nphotons_estimate, std::numeric_limits<float>::infinity());
+}
+
+void search_nearest(const PhotonMap& map, const Point& query_position, unsigned long nphotons_estimate, float radius_estimate, ArenaVector<const Photon*>& nearest){
+    RenderStats& stats = threadStats();
+    std::size_t visited = 0;
+    map.nearest_neighbors_counted(query_position, nphotons_estimate, radius_estimate, visited, nearest);
+    stats.photonQueries++;
+    stats.kdNodesVisited += visited;
 }
 
 std::ostream& operator<<(std::ostream& os, const Photon &p) {
     os << "Photon(Position: " << p.pos << ", Incident: " << p.incident << ", Flux: " << p.flux << ")";
     return os;
-}
\ No newline at end of file
+}
+
+namespace {
+    const char PHOTON_MAP_MAGIC[8] = {'P', 'H', 'O', 'T', 'O', 'N', 'M', 'P'};
+
+    struct PhotonMapFileHeader{
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        uint64_t count;
+    };
+
+    // Registro plano (sin punteros ni vtable) para poder leerlo directamente del mapeo
+    struct PhotonRecord{
+        double pos[3];
+        double incident[3];
+        double flux[3];
+    };
+}
+
+void savePhotonMap(const PhotonMap& map, const std::string& fileName){
+    std::ofstream outFile(fileName, std::ios::binary);
+    if(!outFile.is_open()){
+        throw std::runtime_error("Cannot write photon map file: " + fileName);
+    }
+
+    PhotonMapFileHeader header;
+    std::memcpy(header.magic, PHOTON_MAP_MAGIC, sizeof(header.magic));
+    header.version = PHOTON_MAP_FILE_VERSION;
+    header.recordSize = sizeof(PhotonRecord);
+    header.count = map.size();
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<PhotonRecord> records(map.size());
+    const std::vector<Photon>& photons = map.data();
+    for (size_t i = 0; i < photons.size(); i++){
+        Point pos = photons[i].getPosition();
+        Vector incident = photons[i].getIncident();
+        Color flux = photons[i].getFlux();
+        records[i] = PhotonRecord{
+            {pos.x, pos.y, pos.z},
+            {incident.x, incident.y, incident.z},
+            {flux.r, flux.g, flux.b}
+        };
+    }
+    outFile.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(PhotonRecord));
+
+    // Ejes de cada nodo en un byte (N = 3)
+    std::vector<uint8_t> axes(map.axes().begin(), map.axes().end());
+    outFile.write(reinterpret_cast<const char*>(axes.data()), axes.size());
+
+    if(!outFile){
+        throw std::runtime_error("Error writing photon map file: " + fileName);
+    }
+}
+
+PhotonMap loadPhotonMap(const std::string& fileName){
+    MappedFile file(fileName);
+
+    PhotonMapFileHeader header;
+    if(file.size() < sizeof(header)){
+        throw std::runtime_error("Invalid photon map file: " + fileName);
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(std::memcmp(header.magic, PHOTON_MAP_MAGIC, sizeof(header.magic)) != 0){
+        throw std::runtime_error("Invalid photon map file: " + fileName);
+    }
+    if(header.version != PHOTON_MAP_FILE_VERSION || header.recordSize != sizeof(PhotonRecord)){
+        throw std::runtime_error("Unsupported photon map file version: " + fileName);
+    }
+    // Se compara por division: un count manipulado podria desbordar el producto
+    const size_t entrySize = sizeof(PhotonRecord) + sizeof(uint8_t);
+    const size_t payload = file.size() - sizeof(header);
+    if(header.count > payload / entrySize || payload != header.count * entrySize){
+        throw std::runtime_error("Truncated photon map file: " + fileName);
+    }
+
+    const PhotonRecord* records = reinterpret_cast<const PhotonRecord*>(file.data() + sizeof(header));
+    const uint8_t* axes = reinterpret_cast<const uint8_t*>(records + header.count);
+
+    std::vector<Photon> photons;
+    photons.reserve(header.count);
+    for (uint64_t i = 0; i < header.count; i++){
+        const PhotonRecord& r = records[i];
+        photons.emplace_back(
+            Point(r.pos[0], r.pos[1], r.pos[2]),
+            Vector(r.incident[0], r.incident[1], r.incident[2]),
+            Color(r.flux[0], r.flux[1], r.flux[2])
+        );
+    }
+    // Un eje fuera de [0, 3) haria que cada busqueda leyera fuera de la posicion
+    std::vector<std::size_t> nodes(axes, axes + header.count);
+    for (std::size_t axis : nodes){
+        if(axis >= 3){
+            throw std::runtime_error("Invalid photon map file: " + fileName);
+        }
+    }
+
+    return PhotonMap(std::move(photons), std::move(nodes), PhotonAxisPosition());
+}
@@ -7,6 +7,9 @@
 #include "vector"
 #include "Point.hpp"
 #include "Color.hpp"
+#include "Arena.hpp"
+#include <cstdint>
+#include <string>
 
 class Photon{
 private:
@@ -18,7 +21,7 @@ public:
     Photon() = delete;
     Photon(const Point &pos, const Vector& incident, const Color& flux);
     ~Photon() = default;
-    double position(std::size_t i) const { return pos[i]; }
+    Real position(std::size_t i) const { return pos[i]; }
     Color getFlux() const { return flux; }
     Vector getIncident() const { return incident; }
     Point getPosition() const { return pos; }
@@ -26,7 +29,7 @@ public:
 };
 
 struct PhotonAxisPosition {
-    double operator()(const Photon& p, std::size_t i) const {
+    Real operator()(const Photon& p, std::size_t i) const {
         return p.position(i);
     }
 };
@@ -36,6 +39,17 @@ using PhotonMap = nn::KDTree<Photon, 3, PhotonAxisPosition>;
 PhotonMap newPhotonMap(const std::vector<Photon>& photons);
 std::vector<const Photon*> search_nearest(const PhotonMap& map, const Point& query_position, unsigned long nphotons_estimate, float radius_estimate);
 std::vector<const Photon*> search_nearest(const PhotonMap& map, const Point& query_position, unsigned long nphotons_estimate);
+// Igual, sobre nearest (se vacia antes): con capacidad para nphotons_estimate + 1
+// fotones no reserva memoria
+void search_nearest(const PhotonMap& map, const Point& query_position, unsigned long nphotons_estimate, float radius_estimate, ArenaVector<const Photon*>& nearest);
+
+/* SERIALIZATION */
+// Fichero binario versionado: cabecera, fotones en el orden del kd-tree y eje de cada nodo.
+// Al cargarlo se proyecta en memoria y el arbol se reconstruye sin volver a ordenar.
+const uint32_t PHOTON_MAP_FILE_VERSION = 1;
+
+void savePhotonMap(const PhotonMap& map, const std::string& fileName);
+PhotonMap loadPhotonMap(const std::string& fileName);
 
 
 
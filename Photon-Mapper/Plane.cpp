@@ -1,11 +1,13 @@
 #include "Plane.hpp"
+#include "AffineMatrix.hpp"
+#include "SceneGeometry.hpp"
 
 
 Plane::~Plane(){
     this->normal.~Vector();
 }
 
-Plane::Plane(const Vector& normal, const double dist, const std::shared_ptr<Material>& material): Figure(material){
+Plane::Plane(const Vector& normal, const Real dist, const std::shared_ptr<Material>& material): Figure(material){
     this->normal = normal;
     this->dist = dist;
 }
@@ -21,21 +23,21 @@ Plane::Plane(const Vector& normal){
 }
 */
 
-bool Plane::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const{
+bool Plane::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
     if(!this->visible){
         return false;
     }
 
-    double denom = dotProduct(ray.dir, this->normal);
+    Real denom = dotProduct(ray.dir, this->normal);
     if(denom == 0){
         return false;
     }
-    double div = this->dist + (ray.origin * (this->normal));
+    Real div = this->dist + (ray.origin * (this->normal));
     
     intersection.t = -(div/denom);
     intersection.normal = this->normal;
     intersection.intersectionPoint = ray.at(intersection.t);
-    intersection.material = this->material;
+    intersection.material = this->material.get();
     intersection.figureName = typeid(this).name();
 
 
@@ -50,10 +52,16 @@ void Plane::applyTransform(const Matrix& m) {
     Point newPoint = m * pointOnPlane;
 
     // Transformar la normal usando el inverso transpuesto (solo válido si m es afín)
-    Matrix inverseTransposed = transpose(inverse(m));
-    Vector newNormal = normalize(Vector(inverseTransposed * normal));
+    AffineMatrix inverseTransposed = transposeLinear(inverse(AffineMatrix(m)));
+    Vector newNormal = normalize(inverseTransposed.transformVector(normal));
 
     // Recalcular la nueva distancia al origen
     dist = -dotProduct(newNormal, newPoint);
     normal = newNormal;
 }
+
+bool Plane::storeIn(SceneGeometry& geometry) const{
+    if(!visible) return false;
+    geometry.addPlane(normal, dist, material);
+    return true;
+}
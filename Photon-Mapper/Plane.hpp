@@ -7,10 +7,10 @@
 class Plane: public Figure{
 private:
     Vector normal;
-    double dist;
+    Real dist;
 
 public:
-    Plane(const Vector& normal, const double dist, const std::shared_ptr<Material>& material);
+    Plane(const Vector& normal, const Real dist, const std::shared_ptr<Material>& material);
     /*
     Plane(const Point& p1, const Point& p2, const Point& p3);
     Plane(const Vector& t1, const Vector& t2);
@@ -18,8 +18,9 @@ public:
     */
     Plane() = default;
     ~Plane();
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
     virtual void applyTransform(const Matrix& t) override;
+    virtual bool storeIn(SceneGeometry& geometry) const override;
 };
 
    
@@ -12,23 +12,23 @@ Vector operator-(Point const &p1, Point const &p2){
     return Vector(p1.x-p2.x, p1.y-p2.y, p1.z-p2.z);
 }
 
-Point operator+(double const s, Point const &p){
+Point operator+(Real const s, Point const &p){
     return Point(s+p.x, s+p.y, s+p.z);
 }
 
-Point operator+(Point const &p, double const s){
+Point operator+(Point const &p, Real const s){
     return s+p;
 }
 
-double operator*(const Point& p, const Vector &v){
+Real operator*(const Point& p, const Vector &v){
     return v*p;
 }
 
-double operator*(const Vector &v, const Point& p){
+Real operator*(const Vector &v, const Point& p){
     return dotProduct(v, p - Point(0, 0, 0));
 }
 
-double& Point::operator[](std::size_t idx){
+Real& Point::operator[](std::size_t idx){
     switch (idx){
         case 0:
             return this->x;
@@ -45,7 +45,7 @@ double& Point::operator[](std::size_t idx){
     }
 }
 
-const double& Point::operator[](std::size_t idx) const{
+const Real& Point::operator[](std::size_t idx) const{
     switch (idx){
         case 0:
             return this->x;
@@ -1,4 +1,6 @@
 #include "Ray.hpp"
+#include <algorithm>
+#include <cmath>
 
 Ray::Ray(const Point& origin, const Vector& dir){
     this->origin = origin;
@@ -15,7 +17,7 @@ std::ostream& operator<<(std::ostream& os, const Ray &r){
     return os;
 }
 
-Point Ray::at(double t) const{
+Point Ray::at(Real t) const{
     return Point(
         this->origin.x + t*this->dir.x,
         this->origin.y + t*this->dir.y,
@@ -23,3 +25,7 @@ Point Ray::at(double t) const{
     );
 }
 
+Real Ray::epsilon() const{
+    Real scale = std::max({Real(1), std::abs(origin.x), std::abs(origin.y), std::abs(origin.z)});
+    return RAY_EPSILON * scale;
+}
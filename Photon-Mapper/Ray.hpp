@@ -12,7 +12,10 @@ public:
     Ray(/* args */) = default;
     ~Ray();
     friend std::ostream& operator<<(std::ostream& os, const Ray &r);
-    Point at(double t) const;
+    Point at(Real t) const;
+    // tMin para no volver a chocar con la superficie de la que sale (RAY_EPSILON
+    // escalado por la mayor coordenada del origen)
+    Real epsilon() const;
 };
 
 #endif /* RAY_HPP */
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "RayBinning.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const uint32_t MORTON_BITS = 9;
+    const uint32_t MORTON_CELLS = 1u << MORTON_BITS;
+
+    // 9 bits -> cada bit separado por dos ceros
+    uint32_t spreadBits(uint32_t v){
+        v &= 0x1ff;
+        v = (v | (v << 16)) & 0x030000ff;
+        v = (v | (v << 8)) & 0x0300f00f;
+        v = (v | (v << 4)) & 0x030c30c3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
+
+    uint32_t cell(double u){
+        return uint32_t(std::min(std::max(u, 0.0) * MORTON_CELLS, double(MORTON_CELLS - 1)));
+    }
+}
+
+uint32_t mortonCode(double x, double y, double z){
+    return (spreadBits(cell(x)) << 2) | (spreadBits(cell(y)) << 1) | spreadBits(cell(z));
+}
+
+void rayBinKeys(size_t n, const Real* ox, const Real* oy, const Real* oz,
+                const Real* dx, const Real* dy, const Real* dz, uint32_t* keys){
+    Real min[3], max[3];
+    std::fill(min, min + 3, std::numeric_limits<Real>::infinity());
+    std::fill(max, max + 3, -std::numeric_limits<Real>::infinity());
+    for (size_t i = 0; i < n; i++){
+        min[0] = std::min(min[0], ox[i]); max[0] = std::max(max[0], ox[i]);
+        min[1] = std::min(min[1], oy[i]); max[1] = std::max(max[1], oy[i]);
+        min[2] = std::min(min[2], oz[i]); max[2] = std::max(max[2], oz[i]);
+    }
+    Real scale[3];
+    for (int a = 0; a < 3; a++){
+        scale[a] = max[a] > min[a] ? 1 / (max[a] - min[a]) : 0;
+    }
+    for (size_t i = 0; i < n; i++){
+        uint32_t octant = (dx[i] < 0 ? 4u : 0u) | (dy[i] < 0 ? 2u : 0u) | (dz[i] < 0 ? 1u : 0u);
+        keys[i] = (octant << (3 * MORTON_BITS)) | mortonCode((ox[i] - min[0]) * scale[0], (oy[i] - min[1]) * scale[1], (oz[i] - min[2]) * scale[2]);
+    }
+}
+
+std::vector<uint32_t> sortByKey(const std::vector<uint32_t>& keys){
+    const size_t n = keys.size();
+    std::vector<uint32_t> order(n), next(n);
+    for (size_t i = 0; i < n; i++) order[i] = uint32_t(i);
+
+    uint32_t used = 0;
+    for (uint32_t key : keys) used |= key;
+    for (uint32_t shift = 0; shift < 32; shift += 8){
+        // Se salta la pasada si ninguna clave tiene bits en este byte
+        if(((used >> shift) & 0xff) == 0) continue;
+        size_t counts[257] = {};
+        for (size_t i = 0; i < n; i++){
+            counts[((keys[i] >> shift) & 0xff) + 1]++;
+        }
+        for (size_t b = 1; b < 257; b++){
+            counts[b] += counts[b - 1];
+        }
+        for (size_t i = 0; i < n; i++){
+            uint32_t index = order[i];
+            next[counts[(keys[index] >> shift) & 0xff]++] = index;
+        }
+        order.swap(next);
+    }
+    return order;
+}
+
+std::vector<uint32_t> binRays(const std::vector<Ray>& rays){
+    const size_t n = rays.size();
+    std::vector<Real> components(6 * n);
+    Real* ox = components.data();
+    Real* oy = ox + n;
+    Real* oz = oy + n;
+    Real* dx = oz + n;
+    Real* dy = dx + n;
+    Real* dz = dy + n;
+    for (size_t i = 0; i < n; i++){
+        ox[i] = rays[i].origin.x; oy[i] = rays[i].origin.y; oz[i] = rays[i].origin.z;
+        dx[i] = rays[i].dir.x; dy[i] = rays[i].dir.y; dz[i] = rays[i].dir.z;
+    }
+    std::vector<uint32_t> keys(n);
+    rayBinKeys(n, ox, oy, oz, dx, dy, dz, keys.data());
+    return sortByKey(keys);
+}
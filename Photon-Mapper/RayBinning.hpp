@@ -0,0 +1,28 @@
+#ifndef RAYBINNING_HPP
+#define RAYBINNING_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Ray.hpp"
+
+// Reordenacion de lotes de rayos secundarios. La clave de cada rayo es el
+// octante de su direccion (3 bits altos) seguido del codigo de Morton de la
+// celda de su origen (9 bits por eje) dentro de la caja de los origenes del
+// lote: rayos consecutivos salen de la misma zona hacia el mismo octante, asi
+// que recorren las mismas figuras y sus impactos (y las busquedas en el mapa
+// de fotones que siguen) caen cerca unos de otros.
+
+// Intercala 9 bits por eje; x, y, z en [0, 1]
+uint32_t mortonCode(double x, double y, double z);
+
+// Claves de n rayos dados por componentes
+void rayBinKeys(size_t n, const Real* ox, const Real* oy, const Real* oz,
+                const Real* dx, const Real* dy, const Real* dz, uint32_t* keys);
+
+// Permutacion estable que ordena las claves (radix sort, 8 bits por pasada)
+std::vector<uint32_t> sortByKey(const std::vector<uint32_t>& keys);
+
+// Orden en el que trazar un lote de rayos
+std::vector<uint32_t> binRays(const std::vector<Ray>& rays);
+
+#endif /* RAYBINNING_HPP */
@@ -0,0 +1,37 @@
+#ifndef REAL_HPP
+#define REAL_HPP
+
+// Tipo escalar de la geometria, los colores y las intersecciones. Por defecto
+// double; compilando con -DREAL_FLOAT todo el nucleo pasa a float (mitad de
+// memoria en mapas de fotones y framebuffers, el doble de ancho SIMD).
+#ifdef REAL_FLOAT
+typedef float Real;
+#else
+typedef double Real;
+#endif
+
+// Distancia minima de un rayo que sale de una superficie. Es relativa al
+// tamaño de las coordenadas del origen: el error de redondeo de un punto de
+// impacto crece con su magnitud, y en float es unas 10^9 veces mayor.
+#ifdef REAL_FLOAT
+const Real RAY_EPSILON = 1e-4f;
+#else
+const Real RAY_EPSILON = 1e-5;
+#endif
+
+// Coseno minimo entre un rayo unitario y el plano de un triangulo para no
+// considerarlo paralelo. Es relativo: el determinante de Möller-Trumbore crece
+// con |e1| |e2|, asi que un umbral absoluto descartaria los triangulos pequeños.
+#ifdef REAL_FLOAT
+const Real PARALLEL_EPSILON = 1e-5f;
+#else
+const Real PARALLEL_EPSILON = 1e-6;
+#endif
+
+// det = d . (e2 x e1) con aristas de longitud al cuadrado edge1Squared y
+// edge2Squared. Tambien descarta los triangulos degenerados (det = 0)
+inline bool isParallelToTriangle(Real det, Real edge1Squared, Real edge2Squared){
+    return det * det <= PARALLEL_EPSILON * PARALLEL_EPSILON * edge1Squared * edge2Squared;
+}
+
+#endif /* REAL_HPP */
@@ -0,0 +1,134 @@
+#include "RenderSettings.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    std::string trim(const std::string& s){
+        size_t begin = s.find_first_not_of(" \t\r\n");
+        if(begin == std::string::npos){
+            return "";
+        }
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    // Entero sin signo >= minimum
+    size_t toSize(const std::string& key, const std::string& value, size_t minimum = 0){
+        size_t pos = 0;
+        unsigned long long n = 0;
+        try{
+            n = std::stoull(value, &pos);
+        }catch(const std::exception&){
+            pos = 0;
+        }
+        if(pos != value.size() || value.empty() || value[0] == '-' || n < minimum){
+            throw std::runtime_error("Invalid value for " + key + ": " + value);
+        }
+        return static_cast<size_t>(n);
+    }
+
+    bool toBool(const std::string& key, const std::string& value){
+        if(value == "1" || value == "true" || value == "on" || value == "yes") return true;
+        if(value == "0" || value == "false" || value == "off" || value == "no") return false;
+        throw std::runtime_error("Invalid value for " + key + ": " + value);
+    }
+}
+
+bool RenderSettings::set(const std::string& key, const std::string& value){
+    if(key == "bounces") maxBounces = toSize(key, value);
+    else if(key == "paths") maxPaths = toSize(key, value);
+    else if(key == "roulette") rouletteDepth = toSize(key, value);
+    else if(key == "spp") raysPerPixel = toSize(key, value, 1);
+    else if(key == "width") width = toSize(key, value, 1);
+    else if(key == "height") height = toSize(key, value, 1);
+    else if(key == "resolution") width = height = toSize(key, value, 1);
+    else if(key == "photons") photons = toSize(key, value);
+    else if(key == "k") neighbors = toSize(key, value, 1);
+    else if(key == "threads") threads = toSize(key, value);
+    else if(key == "affinity") affinity = parseAffinity(value);
+    else if(key == "seed") seed = static_cast<unsigned int>(toSize(key, value));
+    else if(key == "progress") showProgress = toBool(key, value);
+    else if(key == "wavefront") wavefront = toBool(key, value);
+    else if(key == "raysort") raySorting = toBool(key, value);
+    else if(key == "pipeline") pipelined = toBool(key, value);
+    else if(key == "writequeue") writeQueue = toSize(key, value);
+    else if(key == "tonemap") toneMapping = value;
+    else return false;
+    return true;
+}
+
+void RenderSettings::loadFile(const std::string& fileName){
+    std::ifstream inFile(fileName);
+    if(!inFile.is_open()){
+        throw std::runtime_error("Cannot open config file: " + fileName);
+    }
+    std::string line;
+    size_t lineNumber = 0;
+    while(std::getline(inFile, line)){
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if(line.empty()){
+            continue;
+        }
+        size_t eq = line.find('=');
+        if(eq == std::string::npos){
+            throw std::runtime_error(fileName + ":" + std::to_string(lineNumber) + ": expected key = value");
+        }
+        std::string key = trim(line.substr(0, eq));
+        if(!set(key, trim(line.substr(eq + 1)))){
+            throw std::runtime_error(fileName + ":" + std::to_string(lineNumber) + ": unknown setting " + key);
+        }
+    }
+}
+
+std::vector<std::string> RenderSettings::parseArgs(int argc, char* argv[]){
+    std::vector<std::string> rest;
+    for (int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if(arg.rfind("--", 0) != 0){
+            rest.push_back(arg);
+            continue;
+        }
+        std::string key = arg.substr(2);
+        std::string value;
+        bool inlineValue = false;
+        size_t eq = key.find('=');
+        if(eq != std::string::npos){
+            value = key.substr(eq + 1);
+            key = key.substr(0, eq);
+            inlineValue = true;
+        }else if(i + 1 < argc){
+            value = argv[i + 1];
+        }
+
+        if(key == "config"){
+            loadFile(value);
+        }else if(!set(key, value)){
+            rest.push_back(arg);
+            continue;
+        }
+        if(!inlineValue){
+            i++;
+        }
+    }
+    return rest;
+}
+
+std::ostream& operator<<(std::ostream& os, const RenderSettings& settings){
+    os << "RenderSettings(" << settings.width << "x" << settings.height
+       << ", spp: " << settings.raysPerPixel
+       << ", bounces: " << settings.maxBounces
+       << ", paths: " << settings.maxPaths
+       << ", roulette: " << settings.rouletteDepth
+       << ", photons: " << settings.photons
+       << ", k: " << settings.neighbors
+       << ", threads: " << settings.threads
+       << ", affinity: " << affinityName(settings.affinity)
+       << ", wavefront: " << (settings.wavefront ? (settings.raySorting ? "on, sorted" : "on") : "off")
+       << ", pipeline: " << (settings.pipelined ? "on" : "off")
+       << ", writequeue: " << settings.writeQueue
+       << ", seed: " << settings.seed
+       << ", tonemap: " << settings.toneMapping << ")";
+    return os;
+}
@@ -0,0 +1,41 @@
+#ifndef RENDERSETTINGS_HPP
+#define RENDERSETTINGS_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Utils.hpp"
+#include "Numa.hpp"
+
+// Ajustes de calidad/rendimiento en tiempo de ejecucion. Los valores por defecto
+// son las constantes de Utils.hpp; se sobreescriben con un fichero de
+// configuracion (lineas "clave = valor", '#' para comentarios) o con la linea
+// de comandos (--clave valor, --clave=valor, --config fichero).
+struct RenderSettings{
+    size_t maxBounces = MAX_BOUNCES;
+    size_t maxPaths = MAX_PATHS;
+    size_t rouletteDepth = ROULETTE_DEPTH;
+    size_t raysPerPixel = MAX_RAYS_PER_PIXEL;
+    size_t width = IMAGE_WIDTH;
+    size_t height = IMAGE_HEIGHT;
+    size_t photons = MAX_PHOTONS;
+    size_t neighbors = MAX_NEIGHBORS;
+    size_t threads = 0;         // 0 -> hardware_concurrency
+    ThreadAffinity affinity = AFFINITY_NONE;    // hilos de render fijos por nucleo o por nodo NUMA
+    unsigned int seed = 0;      // 0 -> time(NULL)
+    bool showProgress = true;
+    bool wavefront = false;     // render por oleadas (WavefrontRenderer.hpp)
+    bool raySorting = true;     // reordena los rayos secundarios del render por oleadas
+    bool pipelined = false;     // G-buffer de camara mientras se construye el mapa de fotones
+    size_t writeQueue = WRITE_QUEUE;  // imagenes pendientes de guardar en segundo plano (0 -> sincrono)
+    std::string toneMapping = "clamp:1,gamma:2.2";  // ver ToneMappingPipeline::parse
+
+    // Devuelve false si la clave no es un ajuste; lanza si el valor no es valido
+    bool set(const std::string& key, const std::string& value);
+    void loadFile(const std::string& fileName);
+    // Consume los ajustes reconocidos y devuelve el resto de argumentos en orden
+    std::vector<std::string> parseArgs(int argc, char* argv[]);
+    friend std::ostream& operator<<(std::ostream& os, const RenderSettings& settings);
+};
+
+#endif /* RENDERSETTINGS_HPP */
@@ -0,0 +1,149 @@
+#include "RenderStats.hpp"
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+    // Los bloques nunca se liberan (direcciones estables en el deque); cuando un
+    // hilo termina su bloque queda libre para el siguiente hilo que se cree,
+    // conservando lo ya contado.
+    std::mutex statsMutex;
+    std::deque<RenderStats> statsBlocks;
+    std::vector<RenderStats*> freeBlocks;
+
+    struct ThreadStatsHolder{
+        RenderStats* block = nullptr;
+        ~ThreadStatsHolder(){
+            if(block != nullptr){
+                std::lock_guard<std::mutex> lock(statsMutex);
+                freeBlocks.push_back(block);
+            }
+        }
+    };
+
+    const char* RR_EVENT_NAMES[4] = {"diffuse", "specular", "refractive", "absorption"};
+
+    void writeEvents(std::ostream& os, const uint64_t events[4]){
+        os << "{";
+        for (size_t i = 0; i < 4; i++){
+            os << "\"" << RR_EVENT_NAMES[i] << "\": " << events[i] << (i < 3 ? ", " : "");
+        }
+        os << "}";
+    }
+
+    double ratio(uint64_t a, uint64_t b){
+        return b == 0 ? 0.0 : double(a) / double(b);
+    }
+}
+
+RenderStats& RenderStats::operator+=(const RenderStats& other){
+    primaryRays += other.primaryRays;
+    secondaryRays += other.secondaryRays;
+    shadowRays += other.shadowRays;
+    photonRays += other.photonRays;
+    sceneQueries += other.sceneQueries;
+    primitiveTests += other.primitiveTests;
+    photonQueries += other.photonQueries;
+    kdNodesVisited += other.kdNodesVisited;
+    photonsEmitted += other.photonsEmitted;
+    photonsStored += other.photonsStored;
+    photonsAbsorbed += other.photonsAbsorbed;
+    for (size_t i = 0; i < 4; i++){
+        rrEvents[i] += other.rrEvents[i];
+        photonRREvents[i] += other.photonRREvents[i];
+    }
+    for (size_t i = 0; i <= STATS_MAX_BOUNCES; i++){
+        photonBounces[i] += other.photonBounces[i];
+        pathBounces[i] += other.pathBounces[i];
+    }
+    pathsTerminated += other.pathsTerminated;
+    return *this;
+}
+
+RenderStats& threadStats(){
+    thread_local ThreadStatsHolder holder;
+    if(holder.block == nullptr){
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if(freeBlocks.empty()){
+            statsBlocks.emplace_back();
+            holder.block = &statsBlocks.back();
+        }else{
+            holder.block = freeBlocks.back();
+            freeBlocks.pop_back();
+        }
+    }
+    return *holder.block;
+}
+
+// Solo debe llamarse cuando no hay hilos renderizando
+RenderStats collectStats(){
+    std::lock_guard<std::mutex> lock(statsMutex);
+    RenderStats total;
+    for (const RenderStats& block : statsBlocks){
+        total += block;
+    }
+    return total;
+}
+
+void resetStats(){
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (RenderStats& block : statsBlocks){
+        block = RenderStats();
+    }
+}
+
+void saveStatsJson(const RenderStats& stats, double photonMapSeconds, double renderSeconds, const std::string& fileName){
+    std::ofstream outFile(fileName);
+    if(!outFile.is_open()){
+        throw std::runtime_error("Cannot write stats file: " + fileName);
+    }
+
+    uint64_t renderRays = stats.primaryRays + stats.secondaryRays + stats.shadowRays;
+
+    outFile << "{" << std::endl;
+    outFile << "  \"photon_map_seconds\": " << photonMapSeconds << "," << std::endl;
+    outFile << "  \"render_seconds\": " << renderSeconds << "," << std::endl;
+    outFile << "  \"rays\": {" << std::endl;
+    outFile << "    \"primary\": " << stats.primaryRays << "," << std::endl;
+    outFile << "    \"secondary\": " << stats.secondaryRays << "," << std::endl;
+    outFile << "    \"shadow\": " << stats.shadowRays << "," << std::endl;
+    outFile << "    \"photon\": " << stats.photonRays << "," << std::endl;
+    outFile << "    \"render_rays_per_second\": " << (renderSeconds > 0 ? renderRays / renderSeconds : 0.0) << "," << std::endl;
+    outFile << "    \"photon_rays_per_second\": " << (photonMapSeconds > 0 ? stats.photonRays / photonMapSeconds : 0.0) << std::endl;
+    outFile << "  }," << std::endl;
+    outFile << "  \"intersections\": {" << std::endl;
+    outFile << "    \"scene_queries\": " << stats.sceneQueries << "," << std::endl;
+    outFile << "    \"primitive_tests\": " << stats.primitiveTests << "," << std::endl;
+    outFile << "    \"primitive_tests_per_ray\": " << ratio(stats.primitiveTests, stats.sceneQueries) << std::endl;
+    outFile << "  }," << std::endl;
+    outFile << "  \"photon_map\": {" << std::endl;
+    outFile << "    \"emitted\": " << stats.photonsEmitted << "," << std::endl;
+    outFile << "    \"stored\": " << stats.photonsStored << "," << std::endl;
+    outFile << "    \"absorbed\": " << stats.photonsAbsorbed << "," << std::endl;
+    outFile << "    \"queries\": " << stats.photonQueries << "," << std::endl;
+    outFile << "    \"kd_nodes_visited\": " << stats.kdNodesVisited << "," << std::endl;
+    outFile << "    \"kd_nodes_per_query\": " << ratio(stats.kdNodesVisited, stats.photonQueries) << std::endl;
+    outFile << "  }," << std::endl;
+    outFile << "  \"russian_roulette\": {" << std::endl;
+    outFile << "    \"render\": ";
+    writeEvents(outFile, stats.rrEvents);
+    outFile << "," << std::endl;
+    outFile << "    \"photons\": ";
+    writeEvents(outFile, stats.photonRREvents);
+    outFile << "," << std::endl;
+    outFile << "    \"photon_bounces\": [";
+    for (size_t i = 0; i <= STATS_MAX_BOUNCES; i++){
+        outFile << stats.photonBounces[i] << (i < STATS_MAX_BOUNCES ? ", " : "");
+    }
+    outFile << "]," << std::endl;
+    outFile << "    \"paths_terminated\": " << stats.pathsTerminated << "," << std::endl;
+    outFile << "    \"path_bounces\": [";
+    for (size_t i = 0; i <= STATS_MAX_BOUNCES; i++){
+        outFile << stats.pathBounces[i] << (i < STATS_MAX_BOUNCES ? ", " : "");
+    }
+    outFile << "]" << std::endl;
+    outFile << "  }" << std::endl;
+    outFile << "}" << std::endl;
+}
@@ -0,0 +1,46 @@
+#ifndef RENDERSTATS_HPP
+#define RENDERSTATS_HPP
+
+#include <cstdint>
+#include <string>
+
+const size_t STATS_MAX_BOUNCES = 16; // Tamaño del histograma de rebotes por camino
+
+// Contadores de un render. Cada hilo escribe en su propio bloque (threadStats)
+// sin sincronizacion; collectStats suma todos los bloques al terminar.
+// Alineado a linea de cache para que bloques contiguos del deque no la compartan.
+struct alignas(64) RenderStats{
+    /* Rayos */
+    uint64_t primaryRays = 0;
+    uint64_t secondaryRays = 0;
+    uint64_t shadowRays = 0;
+    uint64_t photonRays = 0;
+
+    /* Intersecciones */
+    uint64_t sceneQueries = 0;      // Llamadas a la escena (un rayo cualquiera)
+    uint64_t primitiveTests = 0;    // Tests contra figuras/triangulos
+
+    /* Mapa de fotones */
+    uint64_t photonQueries = 0;
+    uint64_t kdNodesVisited = 0;
+    uint64_t photonsEmitted = 0;
+    uint64_t photonsStored = 0;
+    uint64_t photonsAbsorbed = 0;
+
+    /* Ruleta rusa, indexado por RR_EventType */
+    uint64_t rrEvents[4] = {0, 0, 0, 0};
+    uint64_t photonRREvents[4] = {0, 0, 0, 0};
+    uint64_t photonBounces[STATS_MAX_BOUNCES + 1] = {};
+    uint64_t pathsTerminated = 0;   // Caminos cortados por la ruleta rusa de throughput
+    uint64_t pathBounces[STATS_MAX_BOUNCES + 1] = {};
+
+    RenderStats& operator+=(const RenderStats& other);
+};
+
+RenderStats& threadStats();
+RenderStats collectStats();
+void resetStats();
+
+void saveStatsJson(const RenderStats& stats, double photonMapSeconds, double renderSeconds, const std::string& fileName = "render_stats.json");
+
+#endif /* RENDERSTATS_HPP */
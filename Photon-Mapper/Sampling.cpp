@@ -0,0 +1,110 @@
+#define _USE_MATH_DEFINES
+#include "Sampling.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <math.h>
+
+namespace {
+    // Base de Duff et al. por componentes
+    inline void basis(double wx, double wy, double wz, double u[3], double v[3]){
+        double sign = std::copysign(1.0, wz);
+        double a = -1.0 / (sign + wz);
+        double b = wx * wy * a;
+        u[0] = 1.0 + sign * wx * wx * a; u[1] = sign * b; u[2] = -sign * wx;
+        v[0] = b; v[1] = sign + wy * wy * a; v[2] = -wy;
+    }
+
+    // (x, y, z) en la base de la normal
+    inline Vector toWorld(double x, double y, double z, const Vector& normal){
+        double bu[3], bv[3];
+        basis(normal.x, normal.y, normal.z, bu, bv);
+        return Vector(x * bu[0] + y * bv[0] + z * normal.x,
+                      x * bu[1] + y * bv[1] + z * normal.y,
+                      x * bu[2] + y * bv[2] + z * normal.z);
+    }
+
+    // Punto del disco unidad de radio r y angulo 2*pi*u2
+    inline void disk(double r, double u2, double& x, double& y){
+        double phi = 2 * M_PI * u2;
+        x = r * cos(phi);
+        y = r * sin(phi);
+    }
+}
+
+void Sampling::orthonormalBasis(const Vector& w, Vector& u, Vector& v){
+    double bu[3], bv[3];
+    basis(w.x, w.y, w.z, bu, bv);
+    u = Vector(bu[0], bu[1], bu[2]);
+    v = Vector(bv[0], bv[1], bv[2]);
+}
+
+Vector Sampling::uniformSphere(double u1, double u2){
+    double z = 1 - 2 * u1;
+    double x, y;
+    disk(sqrt(std::max(0.0, 1 - z * z)), u2, x, y);
+    return Vector(x, y, z);
+}
+
+Vector Sampling::uniformHemisphere(double u1, double u2){
+    double z = u1;
+    double x, y;
+    disk(sqrt(std::max(0.0, 1 - z * z)), u2, x, y);
+    return Vector(x, y, z);
+}
+
+Vector Sampling::cosineHemisphere(double u1, double u2){
+    // Malley: punto uniforme del disco proyectado a la semiesfera
+    double x, y;
+    disk(sqrt(u1), u2, x, y);
+    return Vector(x, y, sqrt(std::max(0.0, 1 - u1)));
+}
+
+Vector Sampling::uniformHemisphere(const Vector& normal, double u1, double u2){
+    double x, y, z = u1;
+    disk(sqrt(std::max(0.0, 1 - z * z)), u2, x, y);
+    return toWorld(x, y, z, normal);
+}
+
+Vector Sampling::cosineHemisphere(const Vector& normal, double u1, double u2){
+    double x, y, z = sqrt(std::max(0.0, 1 - u1));
+    disk(sqrt(u1), u2, x, y);
+    return toWorld(x, y, z, normal);
+}
+
+double Sampling::uniformSpherePdf(){
+    return 1 / (4 * M_PI);
+}
+
+double Sampling::uniformHemispherePdf(){
+    return 1 / (2 * M_PI);
+}
+
+double Sampling::cosineHemispherePdf(double cosTheta){
+    return std::max(cosTheta, 0.0) / M_PI;
+}
+
+void Sampling::randomNumbers(size_t n, double* out){
+    for (size_t i = 0; i < n; i++) out[i] = randomDouble();
+}
+
+void Sampling::cosineHemisphere(const Vector& normal, size_t n, const double* u1, const double* u2,
+                                double* dx, double* dy, double* dz){
+    // La base se calcula una vez para todo el lote
+    double bu[3], bv[3];
+    basis(normal.x, normal.y, normal.z, bu, bv);
+    for (size_t i = 0; i < n; i++){
+        double x, y, z = sqrt(std::max(0.0, 1 - u1[i]));
+        disk(sqrt(u1[i]), u2[i], x, y);
+        dx[i] = x * bu[0] + y * bv[0] + z * normal.x;
+        dy[i] = x * bu[1] + y * bv[1] + z * normal.y;
+        dz[i] = x * bu[2] + y * bv[2] + z * normal.z;
+    }
+}
+
+void Sampling::uniformSphere(size_t n, const double* u1, const double* u2, double* dx, double* dy, double* dz){
+    for (size_t i = 0; i < n; i++){
+        double z = 1 - 2 * u1[i];
+        disk(sqrt(std::max(0.0, 1 - z * z)), u2[i], dx[i], dy[i]);
+        dz[i] = z;
+    }
+}
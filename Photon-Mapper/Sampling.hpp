@@ -0,0 +1,35 @@
+#ifndef SAMPLING_HPP
+#define SAMPLING_HPP
+#include <cstddef>
+#include "Vector.hpp"
+
+// Muestreo de direcciones a partir de numeros aleatorios ya generados
+// (u1, u2 en [0, 1)), sin trigonometria inversa ni matrices de cambio de base.
+// Las direcciones locales tienen la normal en el eje z.
+namespace Sampling{
+    // Base ortonormal (u, v, w) con w unitario, sin ramas (Duff et al. 2017)
+    void orthonormalBasis(const Vector& w, Vector& u, Vector& v);
+
+    Vector uniformSphere(double u1, double u2);
+    Vector uniformHemisphere(double u1, double u2);
+    Vector cosineHemisphere(double u1, double u2);
+
+    // Semiesfera alrededor de la normal en coordenadas del mundo
+    Vector uniformHemisphere(const Vector& normal, double u1, double u2);
+    Vector cosineHemisphere(const Vector& normal, double u1, double u2);
+
+    // Densidades por angulo solido
+    double uniformSpherePdf();
+    double uniformHemispherePdf();
+    double cosineHemispherePdf(double cosTheta);
+
+    // n numeros de randomDouble()
+    void randomNumbers(size_t n, double* out);
+    // n direcciones con densidad coseno alrededor de la misma normal, por componentes
+    void cosineHemisphere(const Vector& normal, size_t n, const double* u1, const double* u2,
+                          double* dx, double* dy, double* dz);
+    // n direcciones uniformes en la esfera, por componentes
+    void uniformSphere(size_t n, const double* u1, const double* u2, double* dx, double* dy, double* dz);
+}
+
+#endif /* SAMPLING_HPP */
@@ -0,0 +1,256 @@
+#include "SceneGeometry.hpp"
+#include "RenderStats.hpp"
+#include <cmath>
+
+void SceneGeometry::addSphere(const Point& center, Real radius, const std::shared_ptr<Material>& material){
+    spheres.cx.push_back(center.x);
+    spheres.cy.push_back(center.y);
+    spheres.cz.push_back(center.z);
+    spheres.radius2.push_back(radius * radius);
+    spheres.material.push_back(materials.add(material));
+}
+
+void SceneGeometry::addPlane(const Vector& normal, Real dist, const std::shared_ptr<Material>& material){
+    planes.nx.push_back(normal.x);
+    planes.ny.push_back(normal.y);
+    planes.nz.push_back(normal.z);
+    planes.dist.push_back(dist);
+    planes.material.push_back(materials.add(material));
+}
+
+void SceneGeometry::addCylinder(const Point& baseCenter, const Vector& axis, Real radius, Real height, const std::shared_ptr<Material>& material){
+    cylinders.bx.push_back(baseCenter.x);
+    cylinders.by.push_back(baseCenter.y);
+    cylinders.bz.push_back(baseCenter.z);
+    cylinders.ax.push_back(axis.x);
+    cylinders.ay.push_back(axis.y);
+    cylinders.az.push_back(axis.z);
+    cylinders.radius.push_back(radius);
+    cylinders.height.push_back(height);
+    cylinders.material.push_back(materials.add(material));
+}
+
+void SceneGeometry::addTriangle(const Point& v0, const Point& v1, const Point& v2, const std::shared_ptr<Material>& material){
+    triangles.px.push_back(v0.x);
+    triangles.py.push_back(v0.y);
+    triangles.pz.push_back(v0.z);
+    triangles.e1x.push_back(v1.x - v0.x);
+    triangles.e1y.push_back(v1.y - v0.y);
+    triangles.e1z.push_back(v1.z - v0.z);
+    triangles.e2x.push_back(v2.x - v0.x);
+    triangles.e2y.push_back(v2.y - v0.y);
+    triangles.e2z.push_back(v2.z - v0.z);
+    triangles.material.push_back(materials.add(material));
+}
+
+void SceneGeometry::add(const std::shared_ptr<Figure>& figure){
+    if(!figure->storeIn(*this)){
+        figure->registerMaterials(materials);
+        std::shared_ptr<Material> material = figure->uniformMaterial();
+        figureMaterials.push_back(material ? materials.add(material) : NO_MATERIAL);
+        figures.push_back(figure);
+    }
+}
+
+size_t SceneGeometry::size() const{
+    return spheres.cx.size() + planes.nx.size() + cylinders.bx.size() + triangles.px.size() + figures.size();
+}
+
+long SceneGeometry::closestSphere(const Ray& ray, Real tMin, Real& closest) const{
+    const Real ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+    const Real dx = ray.dir.x, dy = ray.dir.y, dz = ray.dir.z;
+    const Real a = dx * dx + dy * dy + dz * dz;
+    const Real invA = 1 / a;
+    long best = -1;
+    for (size_t i = 0; i < spheres.cx.size(); i++){
+        Real cx = ox - spheres.cx[i], cy = oy - spheres.cy[i], cz = oz - spheres.cz[i];
+        Real halfB = cx * dx + cy * dy + cz * dz;
+        Real c = cx * cx + cy * cy + cz * cz - spheres.radius2[i];
+        Real delta = halfB * halfB - a * c;
+        // Con delta < 0 la raiz es NaN y ninguna comparacion se cumple
+        Real root = std::sqrt(delta);
+        Real t0 = (-halfB - root) * invA;
+        Real t = t0 > tMin ? t0 : (-halfB + root) * invA;
+        if(t > tMin && t < closest){
+            closest = t;
+            best = long(i);
+        }
+    }
+    return best;
+}
+
+long SceneGeometry::closestPlane(const Ray& ray, Real tMin, Real& closest) const{
+    const Real ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+    const Real dx = ray.dir.x, dy = ray.dir.y, dz = ray.dir.z;
+    long best = -1;
+    for (size_t i = 0; i < planes.nx.size(); i++){
+        Real denom = dx * planes.nx[i] + dy * planes.ny[i] + dz * planes.nz[i];
+        // Rayo paralelo: t infinito o NaN, se descarta en la comparacion
+        Real t = -(planes.dist[i] + ox * planes.nx[i] + oy * planes.ny[i] + oz * planes.nz[i]) / denom;
+        if(t >= 0 && t > tMin && t < closest){
+            closest = t;
+            best = long(i);
+        }
+    }
+    return best;
+}
+
+long SceneGeometry::closestCylinder(const Ray& ray, Real tMin, Real& closest, int& part) const{
+    const Real ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+    const Real dx = ray.dir.x, dy = ray.dir.y, dz = ray.dir.z;
+    long best = -1;
+    // Mismo orden de pruebas que Cylinder::isIntersectedBy: cuerpo y despues tapas
+    for (size_t i = 0; i < cylinders.bx.size(); i++){
+        const Real ax = cylinders.ax[i], ay = cylinders.ay[i], az = cylinders.az[i];
+        const Real r = cylinders.radius[i], h = cylinders.height[i];
+        Real deltaX = ox - cylinders.bx[i], deltaY = oy - cylinders.by[i], deltaZ = oz - cylinders.bz[i];
+        Real dirAxis = dx * ax + dy * ay + dz * az;
+        Real deltaAxis = deltaX * ax + deltaY * ay + deltaZ * az;
+        Real wx = dx - ax * dirAxis, wy = dy - ay * dirAxis, wz = dz - az * dirAxis;
+        Real qx = deltaX - ax * deltaAxis, qy = deltaY - ay * deltaAxis, qz = deltaZ - az * deltaAxis;
+
+        Real a = wx * wx + wy * wy + wz * wz;
+        Real b = 2 * (wx * qx + wy * qy + wz * qz);
+        Real c = qx * qx + qy * qy + qz * qz - r * r;
+        Real discriminant = b * b - 4 * a * c;
+
+        bool found = false;
+        if(discriminant >= 0){
+            Real root = std::sqrt(discriminant);
+            for (Real t : {(-b - root) / (2 * a), (-b + root) / (2 * a)}){
+                if(t > tMin && t < closest){
+                    // Altura del punto sobre el eje
+                    Real height = deltaAxis + t * dirAxis;
+                    if(height >= 0 && height <= h){
+                        closest = t;
+                        best = long(i);
+                        part = 0;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        for (int cap = 0; cap < 2 && !found; cap++){
+            Real capHeight = cap == 0 ? 0 : h;
+            Real t = (capHeight - deltaAxis) / dirAxis;
+            if(t > tMin && t < closest){
+                Real px = deltaX + t * dx - ax * capHeight;
+                Real py = deltaY + t * dy - ay * capHeight;
+                Real pz = deltaZ + t * dz - az * capHeight;
+                if(std::sqrt(px * px + py * py + pz * pz) <= r){
+                    closest = t;
+                    best = long(i);
+                    part = cap + 1;
+                    found = true;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+long SceneGeometry::closestTriangle(const Ray& ray, Real tMin, Real& closest) const{
+    const Real ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+    const Real dx = ray.dir.x, dy = ray.dir.y, dz = ray.dir.z;
+    long best = -1;
+    // Möller-Trumbore, igual que Triangle::isIntersectedBy
+    for (size_t i = 0; i < triangles.px.size(); i++){
+        const Real e1x = triangles.e1x[i], e1y = triangles.e1y[i], e1z = triangles.e1z[i];
+        const Real e2x = triangles.e2x[i], e2y = triangles.e2y[i], e2z = triangles.e2z[i];
+
+        Real hx = dy * e2z - dz * e2y;
+        Real hy = dz * e2x - dx * e2z;
+        Real hz = dx * e2y - dy * e2x;
+        Real det = e1x * hx + e1y * hy + e1z * hz;
+        if(isParallelToTriangle(det, e1x * e1x + e1y * e1y + e1z * e1z, e2x * e2x + e2y * e2y + e2z * e2z)) continue;
+        Real invDet = 1.0 / det;
+
+        Real sx = ox - triangles.px[i], sy = oy - triangles.py[i], sz = oz - triangles.pz[i];
+        Real u = (sx * hx + sy * hy + sz * hz) * invDet;
+        if(u < 0.0 || u > 1.0) continue;
+
+        Real qx = sy * e1z - sz * e1y;
+        Real qy = sz * e1x - sx * e1z;
+        Real qz = sx * e1y - sy * e1x;
+        Real v = (dx * qx + dy * qy + dz * qz) * invDet;
+        if(v < 0.0 || u + v > 1.0) continue;
+
+        Real t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+        if(t < tMin || t > closest) continue;
+
+        closest = t;
+        best = long(i);
+    }
+    return best;
+}
+
+bool SceneGeometry::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
+    RenderStats& stats = threadStats();
+    stats.sceneQueries++;
+    stats.primitiveTests += size();
+
+    Real closest = tMax;
+    int cylinderPart = 0;
+    // Cada tipo recibe como limite el impacto mas cercano de los anteriores:
+    // solo el ultimo indice valido es el ganador
+    long sphere = closestSphere(ray, tMin, closest);
+    long plane = closestPlane(ray, tMin, closest);
+    long cylinder = closestCylinder(ray, tMin, closest, cylinderPart);
+    long triangle = closestTriangle(ray, tMin, closest);
+
+    long figure = -1;
+    for (size_t i = 0; i < figures.size(); i++){
+        if(figures[i]->isIntersectedBy(ray, tMin, closest, intersection)){
+            closest = intersection.t;
+            figure = long(i);
+        }
+    }
+    if(figure >= 0){
+        // Solo las figuras con varios materiales lo buscan en la tabla
+        uint32_t id = figureMaterials[size_t(figure)];
+        intersection.materialId = id != NO_MATERIAL ? id : materials.find(intersection.material);
+        return true;
+    }
+
+    if(triangle >= 0){
+        size_t i = size_t(triangle);
+        Vector edge1(triangles.e1x[i], triangles.e1y[i], triangles.e1z[i]);
+        Vector edge2(triangles.e2x[i], triangles.e2y[i], triangles.e2z[i]);
+        intersection.normal = normalize(crossProduct(edge1, edge2));
+        intersection.materialId = triangles.material[i];
+        intersection.figureName = "Triangle";
+    }else if(cylinder >= 0){
+        size_t i = size_t(cylinder);
+        Vector axis(cylinders.ax[i], cylinders.ay[i], cylinders.az[i]);
+        if(cylinderPart == 0){
+            Point p = ray.at(closest);
+            Point base(cylinders.bx[i], cylinders.by[i], cylinders.bz[i]);
+            Vector fromBase = p - base;
+            Vector outwardNormal = normalize(fromBase - axis * dotProduct(fromBase, axis));
+            intersection.normal = dotProduct(outwardNormal, ray.dir) < 0 ? outwardNormal : -outwardNormal;
+        }else{
+            intersection.normal = cylinderPart == 1 ? -axis : axis;
+        }
+        intersection.materialId = cylinders.material[i];
+        intersection.figureName = "Cylinder";
+    }else if(plane >= 0){
+        size_t i = size_t(plane);
+        intersection.normal = Vector(planes.nx[i], planes.ny[i], planes.nz[i]);
+        intersection.materialId = planes.material[i];
+        intersection.figureName = "Plane";
+    }else if(sphere >= 0){
+        size_t i = size_t(sphere);
+        Point center(spheres.cx[i], spheres.cy[i], spheres.cz[i]);
+        Point p = ray.at(closest);
+        intersection.normal = normalize(p - center);
+        intersection.materialId = spheres.material[i];
+        intersection.figureName = "Sphere";
+    }else{
+        return false;
+    }
+    intersection.material = &materials[intersection.materialId];
+    intersection.t = closest;
+    intersection.intersectionPoint = ray.at(closest);
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef SCENEGEOMETRY_HPP
+#define SCENEGEOMETRY_HPP
+#include <memory>
+#include <vector>
+#include "Figure.hpp"
+#include "MaterialTable.hpp"
+
+// Geometria de una escena, propietaria de todo lo que contiene. Esferas,
+// planos, cilindros y triangulos se copian a arrays contiguos por tipo (un
+// array por componente) y cada tipo se interseca con su propio bucle, sin
+// llamadas virtuales ni punteros por figura; al final se rellena solo la
+// interseccion mas cercana. El resto de figuras (mallas, instancias...) se
+// guardan tal cual y se intersecan por su metodo virtual; el id de su material
+// se guarda al añadirlas, igual que en las primitivas.
+// Todos los impactos llevan el id de su material en la tabla de la escena.
+// Las primitivas se copian al añadirlas: las transformaciones se aplican antes.
+class SceneGeometry: public IntersectableFigure{
+private:
+    struct Spheres{
+        std::vector<Real> cx, cy, cz, radius2;
+        std::vector<uint32_t> material;        // id en la tabla
+    };
+    struct Planes{
+        std::vector<Real> nx, ny, nz, dist;
+        std::vector<uint32_t> material;        // id en la tabla
+    };
+    struct Cylinders{
+        std::vector<Real> bx, by, bz, ax, ay, az, radius, height;
+        std::vector<uint32_t> material;        // id en la tabla
+    };
+    struct Triangles{
+        // Vertice v0 y aristas v1 - v0, v2 - v0 (Möller-Trumbore)
+        std::vector<Real> px, py, pz, e1x, e1y, e1z, e2x, e2y, e2z;
+        std::vector<uint32_t> material;        // id en la tabla
+    };
+
+    MaterialTable materials;
+    Spheres spheres;
+    Planes planes;
+    Cylinders cylinders;
+    Triangles triangles;
+    std::vector<std::shared_ptr<Figure>> figures;
+    std::vector<uint32_t> figureMaterials;     // id en la tabla, NO_MATERIAL si mezcla varios
+
+    // Cada una devuelve el indice del impacto mas cercano en (tMin, closest) y
+    // actualiza closest; -1 si no hay ninguno. En los cilindros part es 0 para
+    // el cuerpo y 1 o 2 para la tapa de la base o la de arriba
+    long closestSphere(const Ray& ray, Real tMin, Real& closest) const;
+    long closestPlane(const Ray& ray, Real tMin, Real& closest) const;
+    long closestCylinder(const Ray& ray, Real tMin, Real& closest, int& part) const;
+    long closestTriangle(const Ray& ray, Real tMin, Real& closest) const;
+public:
+    SceneGeometry() = default;
+
+    void addSphere(const Point& center, Real radius, const std::shared_ptr<Material>& material);
+    void addPlane(const Vector& normal, Real dist, const std::shared_ptr<Material>& material);
+    void addCylinder(const Point& baseCenter, const Vector& axis, Real radius, Real height, const std::shared_ptr<Material>& material);
+    void addTriangle(const Point& v0, const Point& v1, const Point& v2, const std::shared_ptr<Material>& material);
+    // Primitivas visibles a sus arrays (Figure::storeIn), el resto como figura
+    void add(const std::shared_ptr<Figure>& figure);
+
+    size_t size() const;
+    const MaterialTable& materialTable() const { return materials; }
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
+};
+
+#endif /* SCENEGEOMETRY_HPP */
@@ -0,0 +1,277 @@
+#define _USE_MATH_DEFINES
+#include "SceneLoader.hpp"
+#include "MeshLoader.hpp"
+#include "Sphere.hpp"
+#include "Plane.hpp"
+#include "Cylinder.hpp"
+#include "Triangle.hpp"
+#include "Instance.hpp"
+#include "Lights.hpp"
+#include "Matrix.hpp"
+#include <fstream>
+#include <map>
+#include <math.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    class SceneParser{
+    private:
+        std::string fileName;
+        size_t lineNumber = 0;
+        std::istringstream tokens;
+    public:
+        SceneParser(const std::string& fileName) : fileName(fileName){}
+
+        void setLine(const std::string& line, size_t number){
+            tokens.clear();
+            tokens.str(line);
+            lineNumber = number;
+        }
+
+        [[noreturn]] void fail(const std::string& message) const{
+            throw std::runtime_error(fileName + ":" + std::to_string(lineNumber) + ": " + message);
+        }
+
+        bool next(std::string& word){
+            return bool(tokens >> word);
+        }
+
+        std::string word(const char* what){
+            std::string value;
+            if(!(tokens >> value)) fail(std::string("expected ") + what);
+            return value;
+        }
+
+        double number(){
+            double value;
+            if(!(tokens >> value)) fail("expected a number");
+            return value;
+        }
+
+        Point point(){
+            double x = number(), y = number(), z = number();
+            return Point(x, y, z);
+        }
+
+        Vector vector(){
+            double x = number(), y = number(), z = number();
+            return Vector(x, y, z);
+        }
+
+        Color color(){
+            double r = number(), g = number(), b = number();
+            return Color(r, g, b);
+        }
+
+        void end(){
+            std::string extra;
+            if(tokens >> extra) fail("unexpected " + extra);
+        }
+    };
+
+    std::string directoryOf(const std::string& fileName){
+        size_t slash = fileName.find_last_of("/\\");
+        return slash == std::string::npos ? "" : fileName.substr(0, slash + 1);
+    }
+}
+
+std::unique_ptr<Scene> loadScene(const std::string& fileName, size_t threads){
+    std::ifstream inFile(fileName);
+    if(!inFile.is_open()){
+        throw std::runtime_error("Cannot open scene file: " + fileName);
+    }
+
+    // Camara por defecto: la de la caja de Cornell de main.cpp
+    Camera camera(Vector(0, 1, 0), Vector(-1, 0, 0), Vector(0, 0, 3), Point(0, 0, -3.5));
+    auto scene = std::make_unique<Scene>(fileName, camera);
+    std::map<std::string, std::shared_ptr<Material>> materials;
+    std::vector<Matrix> transforms = {identity()};
+    bool transformed = false;
+
+    SceneParser parser(fileName);
+    auto material = [&](){
+        std::string name = parser.word("material name");
+        auto it = materials.find(name);
+        if(it == materials.end()) parser.fail("unknown material " + name);
+        return it->second;
+    };
+    auto addFigure = [&](const std::shared_ptr<Figure>& figure){
+        if(transformed) figure->applyTransform(transforms.back());
+        scene->add(figure);
+    };
+    // Figuras basicas; nullptr si la orden no es una figura
+    auto parseFigure = [&](const std::string& command) -> std::shared_ptr<Figure> {
+        if(command == "sphere"){
+            auto m = material();
+            Point center = parser.point();
+            double radius = parser.number();
+            parser.end();
+            return std::make_shared<Sphere>(center, radius, m);
+        }else if(command == "plane"){
+            auto m = material();
+            Vector normal = parser.vector();
+            double dist = parser.number();
+            parser.end();
+            return std::make_shared<Plane>(normal, dist, m);
+        }else if(command == "cylinder"){
+            auto m = material();
+            Point base = parser.point();
+            Vector axis = parser.vector();
+            double radius = parser.number();
+            double height = parser.number();
+            parser.end();
+            return std::make_shared<Cylinder>(base, axis, radius, height, m);
+        }else if(command == "triangle"){
+            auto m = material();
+            auto v0 = std::make_shared<Point>(parser.point());
+            auto v1 = std::make_shared<Point>(parser.point());
+            auto v2 = std::make_shared<Point>(parser.point());
+            parser.end();
+            return std::make_shared<Triangle>(v0, v1, v2, m);
+        }else if(command == "mesh"){
+            auto m = material();
+            std::string meshFile = parser.word("mesh file");
+            parser.end();
+            if(meshFile[0] != '/') meshFile = directoryOf(fileName) + meshFile;
+            try{
+                return loadMesh(meshFile, m, threads);
+            }catch(const std::exception& e){
+                parser.fail(e.what());
+            }
+        }
+        return nullptr;
+    };
+    std::map<std::string, std::shared_ptr<const Figure>> objects;
+
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(inFile, line); lineNumber++){
+        parser.setLine(line.substr(0, line.find('#')), lineNumber);
+        std::string command;
+        if(!parser.next(command)) continue;
+
+        if(command == "camera"){
+            Point origin = camera.getO();
+            Vector up = camera.getUp(), left = camera.getLeft(), front = camera.getFront();
+            std::string key;
+            while(parser.next(key)){
+                if(key == "origin") origin = parser.point();
+                else if(key == "up") up = parser.vector();
+                else if(key == "left") left = parser.vector();
+                else if(key == "front") front = parser.vector();
+                else parser.fail("unknown camera field " + key);
+            }
+            scene->camera = Camera(up, left, front, origin);
+        }else if(command == "material"){
+            std::string name = parser.word("material name");
+            Color kd(0, 0, 0), ks(0, 0, 0), kt(0, 0, 0);
+            double ior = 1.0;
+            std::string key;
+            while(parser.next(key)){
+                if(key == "kd") kd = parser.color();
+                else if(key == "ks") ks = parser.color();
+                else if(key == "kt") kt = parser.color();
+                else if(key == "ior") ior = parser.number();
+                else parser.fail("unknown material field " + key);
+            }
+            materials[name] = std::make_shared<Material>(kd, ks, kt, ior);
+        }else if(command == "light"){
+            Point center = parser.point();
+            Color power = parser.color();
+            parser.end();
+            scene->addLight(std::make_shared<Light>(center, power));
+        }else if(command == "spherelight"){
+            const Matrix& m = transforms.back();
+            Point center = parser.point();
+            double radius = parser.number();
+            Color radiance = parser.color();
+            parser.end();
+            // Radio escalado como el eje x (escalados uniformes)
+            scene->addLight(std::make_shared<Lights::SphereLight>(Point(m * center), radius * module(Vector(m * Vector(1, 0, 0))), radiance));
+        }else if(command == "rectlight"){
+            const Matrix& m = transforms.back();
+            Point corner = parser.point();
+            Vector edge1 = parser.vector();
+            Vector edge2 = parser.vector();
+            Color radiance = parser.color();
+            parser.end();
+            // Una transformacion con cizalla tambien deja aristas no perpendiculares
+            try{
+                scene->addLight(std::make_shared<Lights::RectangleLight>(Point(m * corner), Vector(m * edge1), Vector(m * edge2), radiance));
+            }catch(const std::exception& e){
+                parser.fail(e.what());
+            }
+        }else if(command == "meshlight"){
+            std::string meshFile = parser.word("mesh file");
+            Color radiance = parser.color();
+            parser.end();
+            if(meshFile[0] != '/') meshFile = directoryOf(fileName) + meshFile;
+            try{
+                MeshData mesh = loadMeshData(meshFile, threads);
+                if(transformed){
+                    const Matrix& m = transforms.back();
+                    for (size_t i = 0; i < mesh.positions.size(); i += 3){
+                        Point p(m * Point(mesh.positions[i], mesh.positions[i + 1], mesh.positions[i + 2]));
+                        mesh.positions[i] = p.x;
+                        mesh.positions[i + 1] = p.y;
+                        mesh.positions[i + 2] = p.z;
+                    }
+                }
+                scene->addLight(std::make_shared<Lights::MeshLight>(std::move(mesh.positions), std::move(mesh.indices), radiance));
+            }catch(const std::exception& e){
+                parser.fail(e.what());
+            }
+        }else if(command == "object"){
+            std::string name = parser.word("object name");
+            std::shared_ptr<Figure> figure = parseFigure(parser.word("figure"));
+            if(!figure) parser.fail("object " + name + " is not a figure");
+            objects[name] = figure;
+        }else if(command == "instance"){
+            std::string name = parser.word("object name");
+            auto it = objects.find(name);
+            if(it == objects.end()) parser.fail("unknown object " + name);
+            std::string materialName;
+            std::shared_ptr<Material> m;
+            if(parser.next(materialName)){
+                if(materials.find(materialName) == materials.end()) parser.fail("unknown material " + materialName);
+                m = materials[materialName];
+            }
+            parser.end();
+            scene->add(std::make_shared<Instance>(it->second, transforms.back(), m));
+        }else if(std::shared_ptr<Figure> figure = parseFigure(command)){
+            addFigure(figure);
+        }else if(command == "translate"){
+            Vector t = parser.vector();
+            parser.end();
+            transforms.back() = transforms.back() * translation(t.x, t.y, t.z);
+            transformed = true;
+        }else if(command == "scale"){
+            Vector s = parser.vector();
+            parser.end();
+            transforms.back() = transforms.back() * scale(s.x, s.y, s.z);
+            transformed = true;
+        }else if(command == "rotate"){
+            std::string axis = parser.word("rotation axis");
+            double angle = parser.number() * M_PI / 180.0;
+            parser.end();
+            if(axis == "x") transforms.back() = transforms.back() * rotationX(angle);
+            else if(axis == "y") transforms.back() = transforms.back() * rotationY(angle);
+            else if(axis == "z") transforms.back() = transforms.back() * rotationZ(angle);
+            else parser.fail("unknown rotation axis " + axis);
+            transformed = true;
+        }else if(command == "push"){
+            parser.end();
+            transforms.push_back(transforms.back());
+        }else if(command == "pop"){
+            parser.end();
+            if(transforms.size() == 1) parser.fail("pop without push");
+            transforms.pop_back();
+        }else if(command == "identity"){
+            parser.end();
+            transforms.back() = identity();
+        }else{
+            parser.fail("unknown command " + command);
+        }
+    }
+    return scene;
+}
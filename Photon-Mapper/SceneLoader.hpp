@@ -0,0 +1,32 @@
+#ifndef SCENELOADER_HPP
+#define SCENELOADER_HPP
+
+#include <memory>
+#include <string>
+#include "Scenes.hpp"
+
+/*
+    Fichero de escena en texto, una orden por linea ('#' para comentarios):
+
+        camera origin 0 0 -3.5 up 0 1 0 left -1 0 0 front 0 0 3
+        material NOMBRE kd r g b [ks r g b] [kt r g b] [ior n]
+        light x y z r g b
+        spherelight cx cy cz radio r g b        (radiancia; emite hacia fuera)
+        rectlight x y z e1x e1y e1z e2x e2y e2z r g b   (e1 y e2 perpendiculares; emite hacia e1 x e2)
+        meshlight fichero.obj|fichero.ply r g b (emite por la cara antihoraria)
+        sphere MATERIAL cx cy cz radio
+        plane MATERIAL nx ny nz distancia
+        cylinder MATERIAL bx by bz ax ay az radio altura
+        triangle MATERIAL x0 y0 z0 x1 y1 z1 x2 y2 z2
+        mesh MATERIAL fichero.obj|fichero.ply   (relativo al fichero de escena)
+
+    Transformaciones para las figuras y luces de area que vienen a continuacion:
+        translate x y z | scale x y z | rotate x|y|z grados | push | pop | identity
+
+    Instancias: la geometria se define una vez y cada copia solo guarda su matriz
+        object NOMBRE sphere|plane|cylinder|triangle|mesh ...
+        instance NOMBRE [MATERIAL]
+*/
+std::unique_ptr<Scene> loadScene(const std::string& fileName, size_t threads = 0);
+
+#endif /* SCENELOADER_HPP */
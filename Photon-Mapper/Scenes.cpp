@@ -0,0 +1,152 @@
+#define _USE_MATH_DEFINES
+#include "Scenes.hpp"
+#include "Sphere.hpp"
+#include "Plane.hpp"
+#include "Cylinder.hpp"
+#include "TriangleMesh.hpp"
+#include "Material.hpp"
+#include "Lights.hpp"
+#include <math.h>
+#include <stdexcept>
+
+Scene::Scene(const std::string& name, const Camera& camera) : name(name), camera(camera){
+}
+
+void Scene::add(const std::shared_ptr<Figure>& figure){
+    this->figures.add(figure);
+}
+
+void Scene::addLight(const std::shared_ptr<Light>& light){
+    this->lights.push_back(light);
+}
+
+namespace {
+    /*
+        x -> left(-)-right(+)
+        y -> down(-)-up(+)
+        z -> front(-)-back(+)
+    */
+    std::unique_ptr<Scene> cornellBox(const std::string& name){
+        Camera camera(Vector(0, 1, 0), Vector(-1, 0, 0), Vector(0, 0, 3), Point(0, 0, -3.5));
+        auto scene = std::make_unique<Scene>(name, camera);
+
+        Color gris = Color::fromRGB(211, 211, 211);
+        scene->add(std::make_shared<Plane>(Vector(1, 0, 0), 1, std::make_shared<Material>(Color::fromRGB(255, 0, 0))));
+        scene->add(std::make_shared<Plane>(Vector(-1, 0, 0), 1, std::make_shared<Material>(Color::fromRGB(0, 255, 0))));
+        scene->add(std::make_shared<Plane>(Vector(0, 1, 0), 1, std::make_shared<Material>(gris)));
+        scene->add(std::make_shared<Plane>(Vector(0, -1, 0), 1, std::make_shared<Material>(gris)));
+        scene->add(std::make_shared<Plane>(Vector(0, 0, -1), 1, std::make_shared<Material>(gris)));
+        return scene;
+    }
+
+    std::shared_ptr<Material> glass(){
+        return std::make_shared<Material>(Color(0, 0, 0), Color(0.1, 0.1, 0.1), Color(0.9, 0.9, 0.9), 1.5);
+    }
+
+    // Caja de Cornell de main.cpp: esfera difusa+especular y esfera de vidrio
+    std::unique_ptr<Scene> cornell(){
+        auto scene = cornellBox("cornell");
+        scene->add(std::make_shared<Sphere>(Point(-0.5, -0.7, 0.25), 0.3,
+            std::make_shared<Material>(Color(0.0, 0.7, 0.7), Color(0.3, 0.3, 0.3), Color(0, 0, 0), 1.0)));
+        scene->add(std::make_shared<Sphere>(Point(0.5, -0.7, -0.25), 0.3, glass()));
+        scene->addLight(std::make_shared<Light>(Point(0, 0.5, 0), Color(1, 1, 1)));
+        return scene;
+    }
+
+    // Solo difusos: el caso mas barato, mide sobre todo el mapa de fotones
+    std::unique_ptr<Scene> cornellDiffuse(){
+        auto scene = cornellBox("cornell-diffuse");
+        scene->add(std::make_shared<Sphere>(Point(-0.5, -0.7, 0.25), 0.3, std::make_shared<Material>(Color::fromRGB(255, 0, 255))));
+        scene->add(std::make_shared<Sphere>(Point(0.5, -0.7, -0.25), 0.3, std::make_shared<Material>(Color::fromRGB(0, 255, 255))));
+        scene->addLight(std::make_shared<Light>(Point(0, 0.5, 0), Color(1, 1, 1)));
+        return scene;
+    }
+
+    // Causticas: esfera y cilindro de vidrio bajo una luz cercana
+    std::unique_ptr<Scene> caustics(){
+        auto scene = cornellBox("caustics");
+        scene->add(std::make_shared<Sphere>(Point(-0.35, -0.6, 0.1), 0.4, glass()));
+        scene->add(std::make_shared<Cylinder>(Point(0.5, -1.0, -0.2), Vector(0, 1, 0), 0.2, 0.7, glass()));
+        scene->addLight(std::make_shared<Light>(Point(0, 0.8, -0.2), Color(1, 1, 1)));
+        return scene;
+    }
+
+    // Esfera teselada (rings * segments * 2 triangulos)
+    std::shared_ptr<TriangleMesh> sphereMesh(const Point& center, double radius, size_t rings, size_t segments, const std::shared_ptr<Material>& material){
+        std::vector<std::shared_ptr<Point>> vertices;
+        std::vector<int> indices;
+        for (size_t i = 0; i <= rings; i++){
+            double theta = M_PI * double(i) / double(rings);
+            for (size_t j = 0; j <= segments; j++){
+                double phi = 2 * M_PI * double(j) / double(segments);
+                vertices.push_back(std::make_shared<Point>(
+                    center.x + radius * sin(theta) * cos(phi),
+                    center.y + radius * cos(theta),
+                    center.z + radius * sin(theta) * sin(phi)
+                ));
+            }
+        }
+        for (size_t i = 0; i < rings; i++){
+            for (size_t j = 0; j < segments; j++){
+                int a = i * (segments + 1) + j;
+                int b = a + segments + 1;
+                indices.insert(indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+            }
+        }
+        return std::make_shared<TriangleMesh>(vertices, indices, material);
+    }
+
+    // Dos esferas teseladas con 118784 triangulos en total (102400 + 16384)
+    std::unique_ptr<Scene> denseMesh(){
+        auto scene = cornellBox("mesh");
+        scene->add(sphereMesh(Point(-0.45, -0.6, 0.2), 0.4, 160, 320, std::make_shared<Material>(Color(0.8, 0.6, 0.2))));
+        scene->add(sphereMesh(Point(0.45, -0.7, -0.2), 0.3, 64, 128,
+            std::make_shared<Material>(Color(0.2, 0.2, 0.2), Color(0.6, 0.6, 0.6), Color(0, 0, 0), 1.0)));
+        scene->addLight(std::make_shared<Light>(Point(0, 0.5, 0), Color(1, 1, 1)));
+        return scene;
+    }
+
+    // Rejilla de 8x8 luces puntuales bajo el techo con la misma potencia total
+    std::unique_ptr<Scene> manyLights(){
+        auto scene = cornellBox("many-lights");
+        scene->add(std::make_shared<Sphere>(Point(-0.5, -0.7, 0.25), 0.3, std::make_shared<Material>(Color(0.7, 0.7, 0.7))));
+        scene->add(std::make_shared<Sphere>(Point(0.5, -0.7, -0.25), 0.3, glass()));
+        const size_t GRID = 8;
+        for (size_t i = 0; i < GRID; i++){
+            for (size_t j = 0; j < GRID; j++){
+                double x = -0.8 + 1.6 * (i + 0.5) / GRID;
+                double z = -0.8 + 1.6 * (j + 0.5) / GRID;
+                Color power = Color(0.5 + 0.5 * i / GRID, 0.75, 1.0 - 0.5 * j / GRID) / double(GRID * GRID);
+                scene->addLight(std::make_shared<Light>(Point(x, 0.9, z), power));
+            }
+        }
+        return scene;
+    }
+
+    // Luces de area: panel en el techo, esfera y triangulo emisor en la pared del fondo
+    std::unique_ptr<Scene> areaLights(){
+        auto scene = cornellBox("area-lights");
+        scene->add(std::make_shared<Sphere>(Point(-0.5, -0.7, 0.25), 0.3, std::make_shared<Material>(Color(0.7, 0.7, 0.7))));
+        scene->add(std::make_shared<Sphere>(Point(0.5, -0.7, -0.25), 0.3, glass()));
+        scene->addLight(std::make_shared<Lights::RectangleLight>(Point(-0.3, 0.99, -0.3), Vector(0.6, 0, 0), Vector(0, 0, 0.6), Color(3, 3, 3)));
+        scene->addLight(std::make_shared<Lights::SphereLight>(Point(0.5, 0.3, 0.3), 0.1, Color(4, 3, 2)));
+        scene->addLight(std::make_shared<Lights::MeshLight>(
+            std::vector<Real>{-0.8, -0.2, 0.99,  -0.4, -0.2, 0.99,  -0.6, 0.2, 0.99},
+            std::vector<uint32_t>{0, 2, 1}, Color(2, 3, 4)));
+        return scene;
+    }
+}
+
+std::vector<std::string> benchmarkSceneNames(){
+    return {"cornell", "cornell-diffuse", "caustics", "mesh", "many-lights", "area-lights"};
+}
+
+std::unique_ptr<Scene> buildBenchmarkScene(const std::string& name){
+    if(name == "cornell") return cornell();
+    if(name == "cornell-diffuse") return cornellDiffuse();
+    if(name == "caustics") return caustics();
+    if(name == "mesh") return denseMesh();
+    if(name == "many-lights") return manyLights();
+    if(name == "area-lights") return areaLights();
+    throw std::runtime_error("Unknown scene: " + name);
+}
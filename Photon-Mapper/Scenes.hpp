@@ -0,0 +1,28 @@
+#ifndef SCENES_HPP
+#define SCENES_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "SceneGeometry.hpp"
+#include "Light.hpp"
+#include "Camera.hpp"
+
+// Escena completa; sus figuras pertenecen a la SceneGeometry
+class Scene{
+public:
+    std::string name;
+    SceneGeometry figures;
+    std::vector<std::shared_ptr<Light>> lights;
+    Camera camera;
+
+    Scene(const std::string& name, const Camera& camera);
+    void add(const std::shared_ptr<Figure>& figure);
+    void addLight(const std::shared_ptr<Light>& light);
+};
+
+/* ESCENAS DE REFERENCIA (benchmarks) */
+std::vector<std::string> benchmarkSceneNames();
+std::unique_ptr<Scene> buildBenchmarkScene(const std::string& name);
+
+#endif /* SCENES_HPP */
@@ -2,6 +2,9 @@
 
 ScopedTimer::ScopedTimer(const std::string& name) 
     : timer_name(name), start_time(std::chrono::high_resolution_clock::now()) {}
+
+ScopedTimer::ScopedTimer(const std::string& name, double& elapsed) 
+    : timer_name(name), start_time(std::chrono::high_resolution_clock::now()), elapsed_out(&elapsed) {}
 /*
 ScopedTimer::~ScopedTimer() {
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -13,6 +16,7 @@ ScopedTimer::~ScopedTimer() {
 ScopedTimer::~ScopedTimer() {
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration_sec = std::chrono::duration<double>(end_time - start_time).count();
+    if (elapsed_out != nullptr) *elapsed_out = duration_sec;
 
     int hours = static_cast<int>(duration_sec / 3600);
     int minutes = static_cast<int>((duration_sec - hours * 3600) / 60);
@@ -8,8 +8,11 @@ class ScopedTimer {
 private:
     std::string timer_name;
     std::chrono::time_point<std::chrono::high_resolution_clock> start_time;
+    double* elapsed_out = nullptr;
 public:
     explicit ScopedTimer(const std::string& name);
+    // Ademas de imprimirlo, deja el tiempo (en segundos) en elapsed al destruirse
+    ScopedTimer(const std::string& name, double& elapsed);
     ~ScopedTimer();
 
 };
@@ -1,7 +1,8 @@
 #include "Sphere.hpp"
+#include "SceneGeometry.hpp"
 #include <math.h>
 
-Sphere::Sphere(const Point &origin, double r, const std::shared_ptr<Material>& material): Figure(material){
+Sphere::Sphere(const Point &origin, Real r, const std::shared_ptr<Material>& material): Figure(material){
     this->origin = origin;
     this->r = r;
 }
@@ -10,39 +11,39 @@ Sphere::~Sphere(){
     origin.~Point();
 }
 
-bool Sphere::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const{
+bool Sphere::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
     if(!this->visible){
         return false;
     }
 
     Vector vectorToCenter = ray.origin - this->origin;
-    double a = dotProduct(ray.dir, ray.dir);
-    double b = 2 * dotProduct(vectorToCenter, ray.dir);
-    double c = dotProduct(vectorToCenter, vectorToCenter) - this->r * this->r;
+    Real a = dotProduct(ray.dir, ray.dir);
+    Real b = 2 * dotProduct(vectorToCenter, ray.dir);
+    Real c = dotProduct(vectorToCenter, vectorToCenter) - this->r * this->r;
     //std::cout << "a: " << a << "; b: " << b << "; c: " << c << std::endl;
-    double delta = b*b - 4 * a * c;
+    Real delta = b*b - 4 * a * c;
     //std::cout << "delta: " << delta << std::endl;
 
     if(delta < 0){
         return false;
     }
     
-    double t0 = (-b - sqrt(delta)) / (2 * a);
+    Real t0 = (-b - sqrt(delta)) / (2 * a);
     if(t0 < tMax && t0 > tMin){
         intersection.t = t0;
         intersection.intersectionPoint = ray.at(intersection.t);
         intersection.normal = normalize(intersection.intersectionPoint - this->origin);
-        intersection.material = this->material;
+        intersection.material = this->material.get();
         intersection.figureName = "Sphere";
         return true;
     }
     
-    double t1 = (-b + sqrt(delta)) / (2 * a);
+    Real t1 = (-b + sqrt(delta)) / (2 * a);
     if(t1 < tMax && t1 > tMin){
         intersection.t = t1;
         intersection.intersectionPoint = ray.at(intersection.t);
         intersection.normal = normalize(intersection.intersectionPoint - this->origin);
-        intersection.material = this->material;
+        intersection.material = this->material.get();
         intersection.figureName = typeid(this).name();
         return true;
     }
@@ -55,7 +56,7 @@ bool Sphere::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersect
     intersection.t = (t0 > 0 && t1 > 0) ? std::min(t0, t1) : (t0 > 0 ? t0 : (t1 > 0 ? t1 : -1));
     intersection.intersectionPoint = ray.at(intersection.t);
     intersection.normal = normalize(intersection.intersectionPoint - this->origin);
-    intersection.material = this->material;
+    intersection.material = this->material.get();
 
     //std::cout << "t0: " << t0 << "; t1: " << t1 << std::endl;
     return (intersection.t >= tMin && intersection.t <= tMax);
@@ -66,11 +67,16 @@ void Sphere::applyTransform(const Matrix& m) {
     origin = Point(m * origin);
 
     // Extraer escalas en cada eje
-    double sx = module(Vector(m * Vector(1, 0, 0)));
-    double sy = module(Vector(m * Vector(0, 1, 0)));
-    double sz = module(Vector(m * Vector(0, 0, 1)));
+    Real sx = module(Vector(m * Vector(1, 0, 0)));
+    Real sy = module(Vector(m * Vector(0, 1, 0)));
+    Real sz = module(Vector(m * Vector(0, 0, 1)));
 
-    double scale = (sx + sy + sz) / 3.0;
+    Real scale = (sx + sy + sz) / 3.0;
     r *= scale;
 }
 
+bool Sphere::storeIn(SceneGeometry& geometry) const{
+    if(!visible) return false;
+    geometry.addSphere(origin, r, material);
+    return true;
+}
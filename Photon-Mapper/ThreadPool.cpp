@@ -1,8 +1,9 @@
 #include "ThreadPool.hpp"
 
-ThreadPool::ThreadPool(size_t numThreads){
+ThreadPool::ThreadPool(size_t numThreads, ThreadAffinity affinity){
     for (size_t i = 0; i < numThreads; ++i) {
-        workers.emplace_back([this]() {
+        workers.emplace_back([this, affinity, i]() {
+            pinCurrentThread(affinity, i);
             while (true) {
                 std::function<void()> task;
                 {
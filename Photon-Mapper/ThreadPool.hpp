@@ -9,6 +9,9 @@
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <algorithm>
+#include <atomic>
+#include "Numa.hpp"
 
 // ThreadPool para paralelizar trabajos
 class ThreadPool {
@@ -21,7 +24,8 @@ private:
     bool stop = false;
 
 public:
-    ThreadPool(size_t numThreads);
+    // Con affinity cada worker se fija al arrancar (ver pinCurrentThread)
+    ThreadPool(size_t numThreads, ThreadAffinity affinity = AFFINITY_NONE);
 
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
@@ -42,8 +46,49 @@ public:
         return res;
     }
 
+    size_t size() const { return workers.size(); }
+
     ~ThreadPool();
 
 };
 
+// Ejecuta f(i) para i en [0, n) en un pool ya creado: no crea hilos. Se encola una
+// tarea por hilo y cada una toma indices en orden de un contador comun, asi que
+// encolar (std::function, packaged_task, future) no cuesta una reserva por indice
+template<typename F>
+void parallelFor(ThreadPool& pool, size_t n, const F& f){
+    std::atomic<size_t> next{0};
+    const size_t tasks = std::min(n, std::max<size_t>(pool.size(), 1));
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks);
+    for (size_t t = 0; t < tasks; t++){
+        futures.emplace_back(pool.enqueue([&f, &next, n]() {
+            for (size_t i = next++; i < n; i = next++){
+                f(i);
+            }
+        }));
+    }
+    // Todas terminan antes de relanzar una excepcion: usan next y f
+    for (auto& future : futures){
+        future.wait();
+    }
+    for (auto& future : futures){
+        future.get();
+    }
+}
+
+// Igual, repartido entre threads hilos nuevos (0 -> todos los nucleos)
+template<class F>
+void parallelFor(size_t n, size_t threads, const F& f){
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(n <= 1 || threads <= 1){
+        for (size_t i = 0; i < n; i++) f(i);
+        return;
+    }
+    ThreadPool pool(std::min(n, threads));
+    parallelFor(pool, n, f);
+}
+
 #endif /* THREADPOOL_HPP */
\ No newline at end of file
@@ -1,7 +1,60 @@
 #ifndef TONE_MAPPING_HPP
 #define TONE_MAPPING_HPP
 
-#include "PPM.hpp" 
+#include <string>
+#include <vector>
+#include "PPM.hpp"
+
+// Operador de tono sobre cada canal. Los valores entran en [0, maximo actual]
+// y cada operador actualiza ese maximo (clamp lo recorta, el resto lo deja en 1).
+struct ToneOperator{
+    enum Type{
+        EXPOSURE,       // v * 2^value
+        CLAMP,          // min(v, value)
+        EQUALIZE,       // v / maximo
+        GAMMA,          // (v / maximo)^(1/value), con tabla
+        REINHARD,       // v (1 + v/w^2) / (1 + v), w = value (0 -> sin punto blanco)
+        ACES            // curva filmica ACES (aproximacion de Narkowicz), value = exposicion
+    };
+    Type type;
+    double value;
+
+    static ToneOperator exposure(double stops);
+    static ToneOperator clamp(double clampValue = 1.0);
+    static ToneOperator equalize();
+    static ToneOperator gamma(double gammaValue);
+    static ToneOperator reinhard(double white = 0.0);
+    static ToneOperator aces(double exposure = 1.0);
+};
+
+// Lista de operadores aplicados en una sola pasada: la imagen se recorre por
+// bloques que caben en cache, cada operador es un bucle simple sobre el bloque
+// (vectorizable) y los bloques se reparten entre hilos.
+class ToneMappingPipeline{
+private:
+    std::vector<ToneOperator> operators;
+    std::vector<std::vector<double>> gammaTables;   // una tabla por operador GAMMA
+
+    double computeScales(double maxValue, std::vector<double>& scales) const;
+    void applyBlock(Real* values, size_t count, const std::vector<double>& scales) const;
+public:
+    ToneMappingPipeline() = default;
+    ToneMappingPipeline(const std::vector<ToneOperator>& operators);
+
+    ToneMappingPipeline& add(const ToneOperator& op);
+    bool empty() const { return operators.empty(); }
+    const std::vector<ToneOperator>& getOperators() const { return operators; }
+
+    // Maximo de salida para una entrada en [0, maxValue] (no depende de los datos)
+    double outputMax(double maxValue) const;
+    // Aplica sobre count valores en [0, maxValue]; devuelve el nuevo maximo
+    double apply(Real* values, size_t count, double maxValue, size_t threads = 0) const;
+    void apply(PPM& image, size_t threads = 0) const;
+
+    // "clamp:1,gamma:2.2", "exposure:1,aces", "reinhard:4,gamma:2.2"...
+    static ToneMappingPipeline parse(const std::string& description);
+    std::string toString() const;
+};
 
 void clamping(PPM& image, double clampValue = 1.0);
 void equalization(PPM& image);
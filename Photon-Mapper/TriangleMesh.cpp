@@ -1,49 +1,239 @@
 #include "TriangleMesh.hpp"
+#include "AffineMatrix.hpp"
+#include "RenderStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
 TriangleMesh::TriangleMesh(const std::vector<std::shared_ptr<Point>>& vertices, 
                            const std::vector<int>& indices, 
                            const std::shared_ptr<Material>& material) 
-    : vertices(vertices), indices(indices), material(material) {
+    : Figure(material) {
 
-    // Crear triángulos a partir de la lista de índices
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        auto v0 = vertices[indices[i]];
-        auto v1 = vertices[indices[i + 1]];
-        auto v2 = vertices[indices[i + 2]];
-        triangles.push_back(std::make_shared<Triangle>(v0, v1, v2, material));
+    this->positions.reserve(vertices.size() * 3);
+    for (const auto& vertex : vertices) {
+        this->positions.insert(this->positions.end(), {vertex->x, vertex->y, vertex->z});
     }
+    this->indices.reserve(indices.size());
+    for (int index : indices) {
+        if (index < 0 || size_t(index) >= vertices.size()) {
+            throw std::runtime_error("TriangleMesh: vertex index out of range");
+        }
+        this->indices.push_back(uint32_t(index));
+    }
+    buildBVH();
 }
 
-TriangleMesh::~TriangleMesh(){
-    for(size_t i = 0; i < triangles.size(); i++){
-        triangles[i]->~Triangle();
+TriangleMesh::TriangleMesh(std::vector<Real>&& positions,
+                           std::vector<uint32_t>&& indices,
+                           const std::shared_ptr<Material>& material)
+    : Figure(material), positions(std::move(positions)), indices(std::move(indices)) {
+    if (this->positions.size() % 3 != 0 || this->indices.size() % 3 != 0) {
+        throw std::runtime_error("TriangleMesh: buffers are not a multiple of 3");
     }
-    triangles.clear();
-    indices.clear();
+    buildBVH();
+}
+
+TriangleMesh::~TriangleMesh(){
 }
 
 void TriangleMesh::addTriangle(const std::shared_ptr<Point>& v0, const std::shared_ptr<Point>& v1, const std::shared_ptr<Point>& v2) {
-    triangles.push_back(std::make_shared<Triangle>(v0, v1, v2, material));
+    uint32_t first = uint32_t(vertexCount());
+    for (const auto& vertex : {v0, v1, v2}) {
+        positions.insert(positions.end(), {vertex->x, vertex->y, vertex->z});
+    }
+    indices.insert(indices.end(), {first, first + 1, first + 2});
+    // Los triangulos nuevos se recorren uno a uno hasta que son tantos como
+    // los de la BVH; reconstruirla entonces mantiene el coste total en O(n log n)
+    if (triangleCount() - indexedTriangles > std::max(indexedTriangles, BVH_LEAF_SIZE)) {
+        buildBVH();
+    }
+}
+
+bool TriangleMesh::closestInRange(const Ray& ray, Real tMin, size_t first, size_t last, Real& closest, size_t& hit) const {
+    const Real ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+    const Real dx = ray.dir.x, dy = ray.dir.y, dz = ray.dir.z;
+    const Real* p = positions.data();
+    bool found = false;
+
+    // Möller-Trumbore sobre los buffers, igual que Triangle::isIntersectedBy
+    for (size_t i = 3 * first; i < 3 * last; i += 3) {
+        const Real* v0 = p + 3 * indices[i];
+        const Real* v1 = p + 3 * indices[i + 1];
+        const Real* v2 = p + 3 * indices[i + 2];
+
+        Real e1x = v1[0] - v0[0], e1y = v1[1] - v0[1], e1z = v1[2] - v0[2];
+        Real e2x = v2[0] - v0[0], e2y = v2[1] - v0[1], e2z = v2[2] - v0[2];
+
+        Real hx = dy * e2z - dz * e2y;
+        Real hy = dz * e2x - dx * e2z;
+        Real hz = dx * e2y - dy * e2x;
+        Real det = e1x * hx + e1y * hy + e1z * hz;
+        if (isParallelToTriangle(det, e1x * e1x + e1y * e1y + e1z * e1z, e2x * e2x + e2y * e2y + e2z * e2z)) continue;
+        Real invDet = 1.0 / det;
+
+        Real sx = ox - v0[0], sy = oy - v0[1], sz = oz - v0[2];
+        Real u = (sx * hx + sy * hy + sz * hz) * invDet;
+        if (u < 0.0 || u > 1.0) continue;
+
+        Real qx = sy * e1z - sz * e1y;
+        Real qy = sz * e1x - sx * e1z;
+        Real qz = sx * e1y - sy * e1x;
+        Real v = (dx * qx + dy * qy + dz * qz) * invDet;
+        if (v < 0.0 || u + v > 1.0) continue;
+
+        Real t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+        if (t < tMin || t > closest) continue;
+
+        found = true;
+        closest = t;
+        hit = i;
+    }
+    return found;
 }
 
-bool TriangleMesh::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const {
+bool TriangleMesh::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const {
     bool hitAnything = false;
-    double closestSoFar = tMax;
-
-    for (const auto& triangle : triangles) {
-        Intersection tempIntersection;
-        if (triangle->isIntersectedBy(ray, tMin, closestSoFar, tempIntersection)) {
-            hitAnything = true;
-            closestSoFar = tempIntersection.t;
-            intersection = tempIntersection;
+    Real closestSoFar = tMax;
+    size_t closest = 0;
+    size_t tests = 0;
+
+    const Real origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+    const Real invDir[3] = {Real(1) / ray.dir.x, Real(1) / ray.dir.y, Real(1) / ray.dir.z};
+
+    // Recorrido de la BVH con pila; el hijo del lado por el que entra el rayo
+    // se visita primero para que su impacto descarte las cajas mas lejanas
+    uint32_t stack[64];
+    size_t top = 0;
+    if (!nodes.empty()) stack[top++] = 0;
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const BVHNode& node = nodes[index];
+        // Slab test; si el origen esta en el plano de una cara con direccion 0
+        // sale NaN, que std::min/std::max ignoran (la caja no se descarta)
+        Real tNear = tMin, tFar = closestSoFar;
+        for (int axis = 0; axis < 3; axis++) {
+            Real t0 = (node.min[axis] - origin[axis]) * invDir[axis];
+            Real t1 = (node.max[axis] - origin[axis]) * invDir[axis];
+            tNear = std::max(tNear, std::min(t0, t1));
+            tFar = std::min(tFar, std::max(t0, t1));
         }
+        if (tNear > tFar) continue;
+
+        if (node.count > 0) {
+            tests += node.count;
+            hitAnything |= closestInRange(ray, tMin, node.first, node.first + node.count, closestSoFar, closest);
+        } else if (invDir[node.axis] < 0) {
+            stack[top++] = index + 1;
+            stack[top++] = node.first;
+        } else {
+            stack[top++] = node.first;
+            stack[top++] = index + 1;
+        }
+    }
+    // Triangulos añadidos despues de construir la BVH
+    tests += triangleCount() - indexedTriangles;
+    hitAnything |= closestInRange(ray, tMin, indexedTriangles, triangleCount(), closestSoFar, closest);
+    threadStats().primitiveTests += tests;
+
+    if (hitAnything) {
+        // Solo se construye la interseccion del triangulo mas cercano
+        const Real* p = positions.data();
+        const Real* v0 = p + 3 * indices[closest];
+        const Real* v1 = p + 3 * indices[closest + 1];
+        const Real* v2 = p + 3 * indices[closest + 2];
+        Vector edge1(v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2]);
+        Vector edge2(v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2]);
+
+        intersection.t = closestSoFar;
+        intersection.intersectionPoint = ray.at(closestSoFar);
+        intersection.normal = normalize(crossProduct(edge1, edge2));
+        intersection.material = this->material.get();
+        intersection.figureName = "Triangle";
     }
 
     return hitAnything;
 }
 
-void TriangleMesh::applyTransform(const Matrix& t) {
-    for (auto& triangle : triangles) {
-        triangle->applyTransform(t);
+void TriangleMesh::applyTransform(const Matrix& m) {
+    // Cada vertice se transforma una sola vez aunque lo compartan varios triangulos
+    AffineMatrix(m).transformPoints(positions.data(), positions.data(), vertexCount());
+    buildBVH();
+}
+
+uint32_t TriangleMesh::buildNode(std::vector<uint32_t>& order, const std::vector<Real>& centroids, size_t begin, size_t end) {
+    const uint32_t index = uint32_t(nodes.size());
+    nodes.emplace_back();
+    BVHNode node;
+    Real centroidMin[3], centroidMax[3];
+    for (int axis = 0; axis < 3; axis++) {
+        node.min[axis] = centroidMin[axis] = std::numeric_limits<Real>::max();
+        node.max[axis] = centroidMax[axis] = std::numeric_limits<Real>::lowest();
+    }
+    for (size_t i = begin; i < end; i++) {
+        const uint32_t triangle = order[i];
+        for (size_t k = 0; k < 3; k++) {
+            const Real* v = positions.data() + 3 * indices[3 * triangle + k];
+            for (int axis = 0; axis < 3; axis++) {
+                node.min[axis] = std::min(node.min[axis], v[axis]);
+                node.max[axis] = std::max(node.max[axis], v[axis]);
+            }
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            centroidMin[axis] = std::min(centroidMin[axis], centroids[3 * triangle + axis]);
+            centroidMax[axis] = std::max(centroidMax[axis], centroids[3 * triangle + axis]);
+        }
+    }
+
+    // Se parte por la mediana de los centroides en su eje mas largo
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (centroidMax[a] - centroidMin[a] > centroidMax[axis] - centroidMin[axis]) axis = a;
+    }
+    if (end - begin <= BVH_LEAF_SIZE || centroidMax[axis] <= centroidMin[axis]) {
+        node.first = uint32_t(begin);
+        node.count = uint32_t(end - begin);
+        node.axis = 0;
+        nodes[index] = node;
+        return index;
+    }
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+        [&](uint32_t a, uint32_t b) { return centroids[3 * a + axis] < centroids[3 * b + axis]; });
+    // El hijo izquierdo va justo detras del nodo; se guarda el derecho
+    buildNode(order, centroids, begin, middle);
+    node.first = buildNode(order, centroids, middle, end);
+    node.count = 0;
+    node.axis = uint32_t(axis);
+    nodes[index] = node;
+    return index;
+}
+
+void TriangleMesh::buildBVH() {
+    const size_t count = triangleCount();
+    nodes.clear();
+    indexedTriangles = count;
+    if (count == 0) return;
+
+    std::vector<uint32_t> order(count);
+    std::vector<Real> centroids(3 * count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = uint32_t(i);
+        for (size_t k = 0; k < 3; k++) {
+            const Real* v = positions.data() + 3 * indices[3 * i + k];
+            for (int axis = 0; axis < 3; axis++) {
+                centroids[3 * i + axis] += v[axis] / 3;
+            }
+        }
+    }
+    nodes.reserve(2 * count / BVH_LEAF_SIZE + 1);
+    buildNode(order, centroids, 0, count);
+
+    // Los triangulos de cada hoja quedan seguidos en indices
+    std::vector<uint32_t> sorted(indices.size());
+    for (size_t i = 0; i < count; i++) {
+        std::copy(indices.begin() + 3 * order[i], indices.begin() + 3 * order[i] + 3, sorted.begin() + 3 * i);
     }
+    indices.swap(sorted);
 }
@@ -1,29 +1,56 @@
 #ifndef TRIANGLEMESH_HPP
 #define TRIANGLEMESH_HPP
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include "Triangle.hpp"
 #include "Figure.hpp"
 
+// Malla de triangulos en buffers contiguos: xyz de cada vertice seguidos en
+// "positions" y 3 indices por triangulo en "indices" (sin un objeto por vertice).
+// Una BVH sobre los triangulos evita probarlos todos en cada rayo; al
+// construirla se reordenan los triangulos para que cada hoja quede seguida.
 class TriangleMesh : public Figure {
 private:
-    std::vector<std::shared_ptr<Point>> vertices;          // Lista de vértices
-    std::vector<int> indices;            // Índices que definen triángulos
-    std::vector<std::shared_ptr<Triangle>> triangles; // Triángulos individuales
-    std::shared_ptr<Material> material;  // Material para toda la malla
+    static constexpr size_t BVH_LEAF_SIZE = 4;
+
+    struct BVHNode{
+        Real min[3], max[3];    // caja de los triangulos del nodo
+        uint32_t first;         // hoja: primer triangulo; interior: hijo derecho (el izquierdo va detras del nodo)
+        uint32_t count;         // triangulos de la hoja, 0 en los nodos interiores
+        uint32_t axis;          // eje por el que se parte un nodo interior
+    };
+
+    std::vector<Real> positions;       // x0 y0 z0 x1 y1 z1 ...
+    std::vector<uint32_t> indices;       // Índices que definen triángulos
+    std::vector<BVHNode> nodes;          // el nodo 0 es la raiz
+    size_t indexedTriangles = 0;         // triangulos dentro de la BVH; los siguientes se prueban uno a uno
+
+    void buildBVH();
+    uint32_t buildNode(std::vector<uint32_t>& order, const std::vector<Real>& centroids, size_t begin, size_t end);
+    // Triangulos [first, last): impacto mas cercano en (tMin, closest), actualiza
+    // closest y hit (posicion en indices del primer vertice)
+    bool closestInRange(const Ray& ray, Real tMin, size_t first, size_t last, Real& closest, size_t& hit) const;
 
 public:
     TriangleMesh(const std::vector<std::shared_ptr<Point>>& vertices, 
                  const std::vector<int>& indices, 
                  const std::shared_ptr<Material>& material);
+    TriangleMesh(std::vector<Real>&& positions,
+                 std::vector<uint32_t>&& indices,
+                 const std::shared_ptr<Material>& material);
 
     virtual ~TriangleMesh();
 
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
     virtual void applyTransform(const Matrix& t) override;
 
     void addTriangle(const std::shared_ptr<Point>& v0, const std::shared_ptr<Point>& v1, const std::shared_ptr<Point>& v2);
+    size_t vertexCount() const { return positions.size() / 3; }
+    size_t triangleCount() const { return indices.size() / 3; }
+    const std::vector<Real>& getPositions() const { return positions; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
 };
 
 #endif /* TRIANGLEMESH_HPP */
@@ -9,6 +9,7 @@
 
 const size_t MAX_BOUNCES = 6;
 const size_t MAX_PATHS = 1;
+const size_t ROULETTE_DEPTH = 3;   // Rebotes antes de aplicar ruleta rusa por throughput
 
 const size_t MAX_RAYS_PER_PIXEL = 64;
 const size_t IMAGE_WIDTH = 512;
@@ -16,6 +17,8 @@ const size_t IMAGE_HEIGHT = 512;
 
 const size_t MAX_PHOTONS = 100000;
 const size_t MAX_NEIGHBORS = 100; // Nearest neighbors for photon search
+const size_t GBUFFER_MAX_SAMPLES = 1 << 22;    // Muestras que el render en tuberia guarda como mucho
+const size_t WRITE_QUEUE = 2;   // Imagenes esperando a guardarse en segundo plano (OutputWriter)
 
 /* FUNCTIONS */
 double randomDouble(double min, double max);
@@ -21,27 +21,27 @@ Vector crossProduct(const Vector &v1, const Vector &v2){
                       (v1.x * v2.y - v1.y * v2.x));
 }
 
-double dotProduct(const Vector &v1, const Vector &v2){
+Real dotProduct(const Vector &v1, const Vector &v2){
     return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z);
 }
 
-Vector operator*(const Vector &v, const double s){
+Vector operator*(const Vector &v, const Real s){
     return Vector(v.x * s, v.y * s, v.z * s);
 }
 
-Vector operator*(const double s, const Vector &v){
+Vector operator*(const Real s, const Vector &v){
     return v*s;
 }
 
-Vector operator/(const Vector &v, const double s){
+Vector operator/(const Vector &v, const Real s){
     return Vector(v.x / s, v.y / s, v.z / s);
 }
 
-double module(const Vector &v){
+Real module(const Vector &v){
     return sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
 }
 
-double angle(const Vector &v1, const Vector &v2){
+Real angle(const Vector &v1, const Vector &v2){
     return acos((dotProduct(v1,v2))/(module(v1)*module(v2)));
 }
 
@@ -53,23 +53,23 @@ Vector reflect(const Vector& incident, const Vector& normal) {
     return incident - 2.0f * dotProduct(incident, normal) * normal;
 }
 
-Vector refract(const Vector& incident, const Vector& normal, double ior_ratio) {
+Vector refract(const Vector& incident, const Vector& normal, Real ior_ratio) {
     Vector incidentNorm = normalize(incident);
     Vector normalNorm = normalize(normal);
 
-    double cosi = dotProduct(incidentNorm, normalNorm);
+    Real cosi = dotProduct(incidentNorm, normalNorm);
     if (cosi < -1.0) cosi = -1.0;
     if (cosi > 1.0) cosi = 1.0;
 
-    double etai = 1.0;
-    double etat = ior_ratio;
+    Real etai = 1.0;
+    Real etat = ior_ratio;
     if (cosi > 0) {
         normalNorm = -normalNorm;
         std::swap(etai, etat);
     }
 
-    double eta = etai / etat;
-    double k = 1.0 - eta * eta * (1.0 - cosi * cosi);
+    Real eta = etai / etat;
+    Real k = 1.0 - eta * eta * (1.0 - cosi * cosi);
 
     if (k < 0.0) {
         return Vector(0, 0, 0);  // Reflexión total interna
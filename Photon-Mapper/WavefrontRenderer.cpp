@@ -0,0 +1,293 @@
+#include "WavefrontRenderer.hpp"
+#include "Material.hpp"
+#include "RenderStats.hpp"
+#include "RayBinning.hpp"
+#include "progressbar.hpp"
+#include <algorithm>
+#include <limits.h>
+
+namespace {
+    // Caminos por lote: colas de unos 16 MB, mucho mayores que una tarea
+    const size_t BATCH_PATHS = 1 << 16;
+    // Elementos por tarea en cada etapa
+    const size_t CHUNK = 1024;
+}
+
+void WavefrontRenderer::RayQueue::resize(size_t n){
+    ox.resize(n); oy.resize(n); oz.resize(n);
+    dx.resize(n); dy.resize(n); dz.resize(n);
+    tMax.resize(n);
+    path.resize(n);
+    valid.assign(n, 0);
+}
+
+void WavefrontRenderer::RayQueue::set(size_t i, const Ray& ray, Real t, uint32_t pathIndex){
+    ox[i] = ray.origin.x; oy[i] = ray.origin.y; oz[i] = ray.origin.z;
+    dx[i] = ray.dir.x; dy[i] = ray.dir.y; dz[i] = ray.dir.z;
+    tMax[i] = t;
+    path[i] = pathIndex;
+    valid[i] = 1;
+}
+
+Ray WavefrontRenderer::RayQueue::ray(size_t i) const{
+    return Ray(Point(ox[i], oy[i], oz[i]), Vector(dx[i], dy[i], dz[i]));
+}
+
+// Quita los huecos conservando el orden
+void WavefrontRenderer::RayQueue::compact(){
+    size_t n = 0;
+    for (size_t i = 0; i < size(); i++){
+        if(!valid[i]) continue;
+        ox[n] = ox[i]; oy[n] = oy[i]; oz[n] = oz[i];
+        dx[n] = dx[i]; dy[n] = dy[i]; dz[n] = dz[i];
+        tMax[n] = tMax[i];
+        path[n] = path[i];
+        n++;
+    }
+    resize(n);
+    std::fill(valid.begin(), valid.end(), 1);
+}
+
+void WavefrontRenderer::RayQueue::permute(const std::vector<uint32_t>& order){
+    std::vector<Real> buffer(order.size());
+    for (std::vector<Real>* component : {&ox, &oy, &oz, &dx, &dy, &dz, &tMax}){
+        for (size_t i = 0; i < order.size(); i++) buffer[i] = (*component)[order[i]];
+        component->swap(buffer);
+    }
+    std::vector<uint32_t> paths(order.size());
+    for (size_t i = 0; i < order.size(); i++) paths[i] = path[order[i]];
+    path.swap(paths);
+}
+
+void WavefrontRenderer::HitQueue::resize(size_t n){
+    px.resize(n); py.resize(n); pz.resize(n);
+    nx.resize(n); ny.resize(n); nz.resize(n);
+    materialId.assign(n, NO_MATERIAL);
+}
+
+Intersection WavefrontRenderer::HitQueue::intersection(size_t i) const{
+    Intersection result;
+    result.intersectionPoint = Point(px[i], py[i], pz[i]);
+    result.normal = Vector(nx[i], ny[i], nz[i]);
+    return result;
+}
+
+void WavefrontRenderer::PathQueue::reset(size_t n){
+    throughputR.assign(n, 1); throughputG.assign(n, 1); throughputB.assign(n, 1);
+    radianceR.assign(n, 0); radianceG.assign(n, 0); radianceB.assign(n, 0);
+}
+
+Color WavefrontRenderer::PathQueue::throughput(size_t i) const{
+    return Color(throughputR[i], throughputG[i], throughputB[i]);
+}
+
+void WavefrontRenderer::PathQueue::setThroughput(size_t i, const Color& c){
+    throughputR[i] = c.r; throughputG[i] = c.g; throughputB[i] = c.b;
+}
+
+void WavefrontRenderer::PathQueue::addRadiance(size_t i, const Color& c){
+    radianceR[i] += c.r; radianceG[i] += c.g; radianceB[i] += c.b;
+}
+
+WavefrontRenderer::WavefrontRenderer(const SceneGeometry& scene, const LightSampler& lights, const PhotonMap& photonMap, const RenderSettings& settings)
+    : scene(scene), settings(settings),
+      sceneCopies(scene, settings.affinity != AFFINITY_NONE), photonMapCopies(photonMap, settings.affinity != AFFINITY_NONE),
+      pool(settings.threads > 0 ? settings.threads : std::max(1u, std::thread::hardware_concurrency()), settings.affinity){
+    for (size_t node = 0; node < sceneCopies.size(); node++){
+        integrators.emplace_back(sceneCopies.at(node), lights, photonMapCopies.at(node), settings);
+    }
+}
+
+// Integrador del nodo del hilo actual
+const PathIntegrator& WavefrontRenderer::localIntegrator() const{
+    return integrators[currentNumaNode() % integrators.size()];
+}
+
+// f(begin, end) sobre trozos de CHUNK elementos repartidos en el pool
+template<typename F>
+void WavefrontRenderer::forEach(size_t n, const F& f) const{
+    size_t tasks = (n + CHUNK - 1) / CHUNK;
+    parallelFor(pool, tasks, [&](size_t t){
+        f(t * CHUNK, std::min(n, (t + 1) * CHUNK));
+    });
+}
+
+void WavefrontRenderer::cameraStage(Camera& camera, size_t firstPixel, size_t samplesPerPixel, RayQueue& rays) const{
+    const size_t width = camera.getWidth();
+    forEach(rays.size(), [&](size_t begin, size_t end){
+        RenderStats& stats = threadStats();
+        for (size_t i = begin; i < end; i++){
+            size_t pixel = firstPixel + i / samplesPerPixel;
+            rays.set(i, camera.getRayToPixel(pixel % width, pixel / width), INT_MAX, uint32_t(i));
+            stats.primaryRays++;
+        }
+    });
+}
+
+void WavefrontRenderer::binStage(RayQueue& rays) const{
+    std::vector<uint32_t> keys(rays.size());
+    rayBinKeys(rays.size(), rays.ox.data(), rays.oy.data(), rays.oz.data(), rays.dx.data(), rays.dy.data(), rays.dz.data(), keys.data());
+    rays.permute(sortByKey(keys));
+}
+
+void WavefrontRenderer::extendStage(const RayQueue& rays, HitQueue& hits) const{
+    hits.resize(rays.size());
+    forEach(rays.size(), [&](size_t begin, size_t end){
+        const SceneGeometry& localScene = sceneCopies.local();
+        Intersection intersection;
+        for (size_t i = begin; i < end; i++){
+            Ray ray = rays.ray(i);
+            if(!localScene.isIntersectedBy(ray, ray.epsilon(), rays.tMax[i], intersection)) continue;
+            hits.px[i] = intersection.intersectionPoint.x;
+            hits.py[i] = intersection.intersectionPoint.y;
+            hits.pz[i] = intersection.intersectionPoint.z;
+            hits.nx[i] = intersection.normal.x;
+            hits.ny[i] = intersection.normal.y;
+            hits.nz[i] = intersection.normal.z;
+            hits.materialId[i] = intersection.materialId;
+        }
+    });
+}
+
+// Indices de los rayos que chocan, agrupados por id de material (counting sort estable)
+std::vector<uint32_t> WavefrontRenderer::sortByMaterial(const RayQueue& rays, const HitQueue& hits, size_t bounce) const{
+    RenderStats& stats = threadStats();
+    std::vector<uint32_t> offsets(scene.materialTable().size() + 1, 0);
+    for (size_t i = 0; i < rays.size(); i++){
+        uint32_t id = hits.materialId[i];
+        if(id == NO_MATERIAL){
+            // Camino que se pierde: termino en el rebote anterior
+            if(bounce > 0) stats.pathBounces[std::min(bounce - 1, STATS_MAX_BOUNCES)]++;
+            continue;
+        }
+        offsets[id + 1]++;
+    }
+    for (size_t m = 1; m < offsets.size(); m++){
+        offsets[m] += offsets[m - 1];
+    }
+    std::vector<uint32_t> order(offsets.back());
+    for (size_t i = 0; i < rays.size(); i++){
+        uint32_t id = hits.materialId[i];
+        if(id != NO_MATERIAL) order[offsets[id]++] = uint32_t(i);
+    }
+    return order;
+}
+
+// Cada impacto pide su rayo de sombra y, si el camino sigue, su siguiente rayo.
+// Las colas de salida tienen un hueco por impacto: no hace falta sincronizar.
+// El material (y si usa luz directa) se resuelve al empezar cada grupo
+void WavefrontRenderer::shadeStage(const std::vector<uint32_t>& order, const RayQueue& rays, const HitQueue& hits, size_t bounce,
+                                   PathQueue& paths, RayQueue& nextRays, RayQueue& shadowRays, std::vector<Color>& shadowContributions) const{
+    nextRays.resize(order.size());
+    shadowRays.resize(order.size());
+    shadowContributions.resize(order.size());
+    forEach(order.size(), [&](size_t begin, size_t end){
+        RenderStats& stats = threadStats();
+        const MaterialTable& materials = scene.materialTable();
+        const PathIntegrator& integrator = localIntegrator();
+        uint32_t groupId = NO_MATERIAL;
+        const Material* groupMaterial = nullptr;
+        bool nextEvent = false;
+        for (size_t k = begin; k < end; k++){
+            const size_t i = order[k];
+            const uint32_t path = rays.path[i];
+            if(hits.materialId[i] != groupId){
+                groupId = hits.materialId[i];
+                groupMaterial = &materials[groupId];
+                nextEvent = groupMaterial->usesNextEvent();
+            }
+            const Material& material = *groupMaterial;
+            Intersection intersection = hits.intersection(i);
+            intersection.material = groupMaterial;
+            intersection.materialId = groupId;
+            Ray ray = rays.ray(i);
+
+            Color throughput = paths.throughput(path);
+            Ray shadowRay;
+            double distance;
+            if(nextEvent && integrator.sampleDirect(material, intersection, shadowRay, distance, shadowContributions[k])){
+                shadowContributions[k] = shadowContributions[k] * throughput;
+                shadowRays.set(k, shadowRay, distance, path);
+            }
+
+            Color result(0, 0, 0);
+            Vector direction;
+            bool alive = integrator.scatter(material, ray, intersection, bounce, throughput, result, direction);
+            paths.addRadiance(path, result);
+            if(alive && bounce + 1 < settings.maxBounces){
+                paths.setThroughput(path, throughput);
+                nextRays.set(k, Ray(intersection.intersectionPoint, direction), INT_MAX, path);
+                stats.secondaryRays++;
+            }else{
+                stats.pathBounces[std::min(bounce + (alive ? 1 : 0), STATS_MAX_BOUNCES)]++;
+            }
+        }
+    });
+}
+
+void WavefrontRenderer::shadowStage(const RayQueue& shadowRays, const std::vector<Color>& shadowContributions, PathQueue& paths) const{
+    forEach(shadowRays.size(), [&](size_t begin, size_t end){
+        RenderStats& stats = threadStats();
+        const SceneGeometry& localScene = sceneCopies.local();
+        Intersection intersection;
+        for (size_t k = begin; k < end; k++){
+            if(!shadowRays.valid[k]) continue;
+            stats.shadowRays++;
+            Ray shadowRay = shadowRays.ray(k);
+            if(!localScene.isIntersectedBy(shadowRay, shadowRay.epsilon(), shadowRays.tMax[k], intersection)){
+                paths.addRadiance(shadowRays.path[k], shadowContributions[k]);
+            }
+        }
+    });
+}
+
+// Los caminos de un pixel son consecutivos en el lote
+void WavefrontRenderer::accumulateStage(const PathQueue& paths, size_t firstPixel, size_t pixels, size_t samplesPerPixel, size_t width, PPM& image) const{
+    forEach(pixels, [&](size_t begin, size_t end){
+        for (size_t p = begin; p < end; p++){
+            Color color(0, 0, 0);
+            for (size_t s = p * samplesPerPixel; s < (p + 1) * samplesPerPixel; s++){
+                color += Color(paths.radianceR[s], paths.radianceG[s], paths.radianceB[s]);
+            }
+            size_t pixel = firstPixel + p;
+            image[pixel / width][pixel % width] = PPM::Pixel(color / double(samplesPerPixel));
+        }
+    });
+}
+
+PPM WavefrontRenderer::render(Camera& camera) const{
+    const size_t width = camera.getWidth();
+    const size_t height = camera.getHeight();
+    PPM image(height, width);
+    const size_t samplesPerPixel = std::max<size_t>(settings.raysPerPixel * settings.maxPaths, 1);
+    const size_t totalPixels = width * height;
+    const size_t pixelsPerBatch = std::max<size_t>(BATCH_PATHS / samplesPerPixel, 1);
+    progressbar pb(static_cast<int>(totalPixels));
+
+    RayQueue rays, nextRays, shadowRays;
+    HitQueue hits;
+    PathQueue paths;
+    std::vector<Color> shadowContributions;
+    for (size_t firstPixel = 0; firstPixel < totalPixels; firstPixel += pixelsPerBatch){
+        const size_t pixels = std::min(pixelsPerBatch, totalPixels - firstPixel);
+        const size_t batch = pixels * samplesPerPixel;
+        paths.reset(batch);
+        rays.resize(batch);
+        cameraStage(camera, firstPixel, samplesPerPixel, rays);
+
+        for (size_t bounce = 0; bounce < settings.maxBounces && rays.size() > 0; bounce++){
+            // Los rayos de camara ya salen en orden de pixel
+            if(settings.raySorting && bounce > 0) binStage(rays);
+            extendStage(rays, hits);
+            std::vector<uint32_t> order = sortByMaterial(rays, hits, bounce);
+            shadeStage(order, rays, hits, bounce, paths, nextRays, shadowRays, shadowContributions);
+            shadowStage(shadowRays, shadowContributions, paths);
+            nextRays.compact();
+            std::swap(rays, nextRays);
+        }
+        accumulateStage(paths, firstPixel, pixels, samplesPerPixel, width, image);
+        if(settings.showProgress) pb.setProgress(int(firstPixel + pixels), int(totalPixels));
+    }
+    if(settings.showProgress) pb.finish();
+    return image;
+}
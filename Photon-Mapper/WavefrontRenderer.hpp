@@ -0,0 +1,85 @@
+#ifndef WAVEFRONTRENDERER_HPP
+#define WAVEFRONTRENDERER_HPP
+#include <cstdint>
+#include <vector>
+#include "Camera.hpp"
+#include "Numa.hpp"
+#include "PathIntegrator.hpp"
+#include "SceneGeometry.hpp"
+#include "ThreadPool.hpp"
+
+// Render por oleadas (settings.wavefront): en vez de seguir cada camino de
+// principio a fin, un lote grande de caminos avanza etapa a etapa sobre colas
+// con un array por componente:
+//     camara -> [reordenacion] -> extension -> sombreado por material -> sombras -> acumulacion
+// Cada etapa recorre su cola en paralelo y antes de sombrear los impactos se
+// agrupan por su id en la tabla de materiales de la escena, asi cada tarea
+// trabaja con un solo material seguido y lo resuelve una vez por grupo.
+// Con settings.raySorting los rayos secundarios se reordenan antes de la
+// extension por octante y celda del origen (RayBinning.hpp).
+// El estimador es el de PathIntegrator (usa sus funciones de vertice y de luz
+// directa); cada muestra de pixel lanza settings.maxPaths caminos.
+// Con afinidad, como en Camera::render, cada nodo NUMA lee su copia de la
+// escena y del mapa de fotones.
+class WavefrontRenderer{
+private:
+    // Rayos pendientes de trazar
+    struct RayQueue{
+        std::vector<Real> ox, oy, oz, dx, dy, dz;
+        std::vector<Real> tMax;
+        std::vector<uint32_t> path;     // camino del lote al que pertenece
+        std::vector<uint8_t> valid;     // huecos de las etapas que no generan rayo
+
+        void resize(size_t n);
+        size_t size() const { return path.size(); }
+        void set(size_t i, const Ray& ray, Real t, uint32_t pathIndex);
+        Ray ray(size_t i) const;
+        void compact();
+        void permute(const std::vector<uint32_t>& order);
+    };
+
+    // Impacto de cada rayo de la cola de extension (NO_MATERIAL si no choca)
+    struct HitQueue{
+        std::vector<Real> px, py, pz, nx, ny, nz;
+        std::vector<uint32_t> materialId;
+
+        void resize(size_t n);
+        Intersection intersection(size_t i) const;
+    };
+
+    // Estado de cada camino del lote
+    struct PathQueue{
+        std::vector<Real> throughputR, throughputG, throughputB;
+        std::vector<Real> radianceR, radianceG, radianceB;
+
+        void reset(size_t n);
+        Color throughput(size_t i) const;
+        void setThroughput(size_t i, const Color& c);
+        void addRadiance(size_t i, const Color& c);
+    };
+
+    const SceneGeometry& scene;
+    const RenderSettings& settings;
+    NodeReplicas<SceneGeometry> sceneCopies;
+    NodeReplicas<PhotonMap> photonMapCopies;
+    std::vector<PathIntegrator> integrators;    // uno por copia
+    mutable ThreadPool pool;
+
+    template<typename F>
+    void forEach(size_t n, const F& f) const;
+    const PathIntegrator& localIntegrator() const;
+
+    void cameraStage(Camera& camera, size_t firstPixel, size_t samplesPerPixel, RayQueue& rays) const;
+    void binStage(RayQueue& rays) const;
+    void extendStage(const RayQueue& rays, HitQueue& hits) const;
+    std::vector<uint32_t> sortByMaterial(const RayQueue& rays, const HitQueue& hits, size_t bounce) const;
+    void shadeStage(const std::vector<uint32_t>& order, const RayQueue& rays, const HitQueue& hits, size_t bounce,
+                    PathQueue& paths, RayQueue& nextRays, RayQueue& shadowRays, std::vector<Color>& shadowContributions) const;
+    void shadowStage(const RayQueue& shadowRays, const std::vector<Color>& shadowContributions, PathQueue& paths) const;
+    void accumulateStage(const PathQueue& paths, size_t firstPixel, size_t pixels, size_t samplesPerPixel, size_t width, PPM& image) const;
+public:
+    WavefrontRenderer(const SceneGeometry& scene, const LightSampler& lights, const PhotonMap& photonMap, const RenderSettings& settings);
+    PPM render(Camera& camera) const;
+};
+
+#endif /* WAVEFRONTRENDERER_HPP */
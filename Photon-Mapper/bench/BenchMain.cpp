@@ -0,0 +1,656 @@
+#define _USE_MATH_DEFINES
+#include "Benchmark.hpp"
+#include "AffineMatrix.hpp"
+#include "PathTracing.hpp"
+#include "PhotonMap.hpp"
+#include "Scenes.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <limits>
+#include <new>
+#include <random>
+#include <math.h>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+
+// Microbenchmarks de los kernels del render. Compilacion (desde Photon-Mapper/):
+//     g++ --std=c++17 -O3 -DNDEBUG -I. bench/*.cpp $(ls *.cpp | grep -v main.cpp) -o bench.out -pthread
+// Uso:
+//     ./bench.out [--warmup N] [--reps N] [--filter nombre] [--json salida.json]
+
+using namespace std;
+
+// Contador global de reservas: cada new del programa pasa por aqui (sin
+// inline, GCC avisaria de free sobre memoria de new al ver ambos)
+static atomic<size_t> allocations{0};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(size_t size){
+    allocations.fetch_add(1, memory_order_relaxed);
+    if(void* p = malloc(size == 0 ? 1 : size)) return p;
+    throw bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept{
+    free(p);
+}
+
+BENCH_NOINLINE void operator delete(void* p, size_t) noexcept{
+    free(p);
+}
+
+namespace {
+    const size_t RAYS = 4096;
+
+    // Reservas por operacion de f (ya en estado estacionario)
+    template<typename F>
+    void allocationBench(const BenchOptions& options, const string& name, size_t ops, const F& f){
+        if(!options.filter.empty() && name.find(options.filter) == string::npos){
+            return;
+        }
+        f();
+        size_t before = allocations.load();
+        f();
+        size_t count = allocations.load() - before;
+        cout << left << setw(40) << name << right << setw(14) << fixed << setprecision(3)
+             << double(count) / double(ops) << " allocs/op  (" << count << " in " << ops << " ops)" << endl;
+    }
+
+    // Rayos desde delante de la escena hacia puntos aleatorios de [-1,1]^3
+    vector<Ray> randomRays(size_t n){
+        vector<Ray> rays;
+        rays.reserve(n);
+        for (size_t i = 0; i < n; i++){
+            Point origin(randomDouble(-0.5, 0.5), randomDouble(-0.5, 0.5), -3.5);
+            Point target(randomDouble(-1, 1), randomDouble(-1, 1), randomDouble(-1, 1));
+            rays.push_back(Ray(origin, target - origin));
+        }
+        return rays;
+    }
+
+    template<typename F>
+    void intersectionBench(BenchmarkSuite& suite, const string& name, const vector<Ray>& rays, const F& figure){
+        suite.run(name, rays.size(), [&]() {
+            size_t hits = 0;
+            Intersection intersection;
+            for (const Ray& ray : rays){
+                hits += figure.isIntersectedBy(ray, 0.00001f, INT_MAX, intersection);
+            }
+            doNotOptimize(hits);
+        });
+    }
+
+    size_t fileSize(const string& fileName){
+        ifstream inFile(fileName, ios::binary | ios::ate);
+        return size_t(inFile.tellg());
+    }
+
+    vector<Photon> randomPhotons(size_t n){
+        vector<Photon> photons;
+        photons.reserve(n);
+        for (size_t i = 0; i < n; i++){
+            photons.emplace_back(
+                Point(randomDouble(-1, 1), randomDouble(-1, 1), randomDouble(-1, 1)),
+                randomDirection(),
+                Color(1, 1, 1)
+            );
+        }
+        return photons;
+    }
+
+    // Referencia: muestreo coseno anterior (acos para elegir eje, dos productos vectoriales y matriz de cambio de base)
+    Vector baseChangeCosineDirection(const Point& point, const Vector& normal, double u1, double u2){
+        double phi = 2 * M_PI * u1;
+        double theta = asin(sqrt(u2));
+        Vector random(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+        Vector randomBaseVector(0, 1, 0);
+        double alpha = angle(normal, randomBaseVector);
+        if (std::abs(alpha - M_PI) < 1e-6 || std::abs(alpha) < 1e-6) {
+            randomBaseVector = Vector(1, 0, 0);
+        }
+        Vector T = normalize(crossProduct(normal, randomBaseVector));
+        Vector B = normalize(crossProduct(normal, T));
+        return baseChange(point, T, B, normal) * random;
+    }
+
+    // Referencia: integrador recursivo (version anterior, una llamada y una copia de la interseccion por rebote)
+    Color recursiveRadiance(const Ray& ray, const Intersection& intersection, const IntersectableFigure& scene, const RenderSettings& settings, size_t depth){
+        if(depth >= settings.maxBounces) return Color(0, 0, 0);
+        BSDFSample sample = intersection.material->sample(ray, intersection);
+        if(sample.eventType == ABSORTION || sample.eventType == DIFUSSE) return Color(0, 0, 0);
+        Ray next(intersection.intersectionPoint, sample.direction);
+        Intersection nextIntersection;
+        Color incoming(0, 0, 0);
+        if(scene.isIntersectedBy(next, 0.00001f, INT_MAX, nextIntersection)){
+            incoming = recursiveRadiance(next, nextIntersection, scene, settings, depth + 1);
+        }
+        return incoming * sample.weight;
+    }
+}
+
+int main(int argc, char* argv[]){
+    BenchOptions options;
+    try{
+        options = parseBenchOptions(argc, argv);
+    }catch(const std::exception& e){
+        cerr << e.what() << endl;
+        return 1;
+    }
+    // Semilla fija: todas las ejecuciones miden los mismos datos
+    srand(1234);
+    cout << "Real: " << (sizeof(Real) == sizeof(float) ? "float" : "double")
+         << " (Photon " << sizeof(Photon) << " B, pixel " << sizeof(PPM::Pixel) << " B)" << endl;
+    BenchmarkSuite suite(options);
+
+    auto gray = make_shared<Material>(Color(0.8, 0.8, 0.8));
+    vector<Ray> rays = randomRays(RAYS);
+
+    /* INTERSECCIONES */
+    Sphere sphere(Point(0, 0, 0), 0.5, gray);
+    Plane plane(Vector(0, 0, -1), 1, gray);
+    Cylinder cylinder(Point(0, -0.5, 0), Vector(0, 1, 0), 0.3, 1.0, gray);
+    Triangle triangle(make_shared<Point>(-1, -1, 0), make_shared<Point>(1, -1, 0), make_shared<Point>(0, 1, 0), gray);
+
+    intersectionBench(suite, "Sphere::isIntersectedBy", rays, sphere);
+    intersectionBench(suite, "Plane::isIntersectedBy", rays, plane);
+    intersectionBench(suite, "Cylinder::isIntersectedBy", rays, cylinder);
+    intersectionBench(suite, "Triangle::isIntersectedBy", rays, triangle);
+
+    // Misma esfera como instancia escalada de una esfera unidad: coste del cambio de espacio
+    Instance sphereInstance(make_shared<Sphere>(Point(0, 0, 0), 1, gray), scale(0.5, 0.5, 0.5));
+    intersectionBench(suite, "Instance(Sphere)::isIntersectedBy", rays, sphereInstance);
+
+    // Caja de Cornell de main.cpp
+    Plane leftPlane(Vector(1, 0, 0), 1, gray);
+    Plane rightPlane(Vector(-1, 0, 0), 1, gray);
+    Plane floorPlane(Vector(0, 1, 0), 1, gray);
+    Plane ceilingPlane(Vector(0, -1, 0), 1, gray);
+    Plane backPlane(Vector(0, 0, -1), 1, gray);
+    Sphere leftSphere(Point(-0.5, -0.7, 0.25), 0.3, gray);
+    Sphere rightSphere(Point(0.5, -0.7, -0.25), 0.3, gray);
+    FigureCollection cornell(vector<Figure*>({
+        &leftPlane, &rightPlane, &floorPlane, &ceilingPlane, &backPlane, &leftSphere, &rightSphere
+    }));
+    intersectionBench(suite, "FigureCollection::isIntersectedBy", rays, cornell);
+    // La misma caja en arrays por tipo
+    SceneGeometry cornellGeometry;
+    for (Figure* figure : cornell){
+        cornellGeometry.add(shared_ptr<Figure>(shared_ptr<Figure>(), figure));
+    }
+    intersectionBench(suite, "SceneGeometry::isIntersectedBy", rays, cornellGeometry);
+    cornell.deleteAll(); // Las figuras son de la pila
+
+    // 256 esferas y 256 triangulos sueltos: coste por primitiva de cada contenedor
+    {
+        vector<shared_ptr<Figure>> loose;
+        for (size_t i = 0; i < 256; i++){
+            Point c(randomDouble(-1, 1), randomDouble(-1, 1), randomDouble(-1, 1));
+            loose.push_back(make_shared<Sphere>(c, 0.05, gray));
+            loose.push_back(make_shared<Triangle>(make_shared<Point>(c.x, c.y, c.z), make_shared<Point>(c.x + 0.1, c.y, c.z),
+                                                  make_shared<Point>(c.x, c.y + 0.1, c.z), gray));
+        }
+        FigureCollection looseCollection;
+        SceneGeometry looseGeometry;
+        for (const auto& figure : loose){
+            looseCollection.add(figure.get());
+            looseGeometry.add(figure);
+        }
+        intersectionBench(suite, "FigureCollection::isIntersectedBy (512 primitives)", rays, looseCollection);
+        intersectionBench(suite, "SceneGeometry::isIntersectedBy (512 primitives)", rays, looseGeometry);
+    }
+
+    /* KD-TREE */
+    const size_t PHOTONS = 100000;
+    vector<Photon> photons = randomPhotons(PHOTONS);
+    suite.run("KDTree build (100k photons)", 1, [&]() {
+        PhotonMap map = newPhotonMap(photons);
+        doNotOptimize(map);
+    });
+
+    PhotonMap photonMap = newPhotonMap(photons);
+    vector<Point> queries;
+    for (size_t i = 0; i < 1024; i++){
+        queries.push_back(Point(randomDouble(-1, 1), randomDouble(-1, 1), randomDouble(-1, 1)));
+    }
+    suite.run("KDTree nearest_neighbors (k=100)", queries.size(), [&]() {
+        size_t found = 0;
+        for (const Point& q : queries){
+            found += search_nearest(photonMap, q, MAX_NEIGHBORS).size();
+        }
+        doNotOptimize(found);
+    });
+    suite.run("KDTree nearest_neighbors (k=50, r=0.2)", queries.size(), [&]() {
+        size_t found = 0;
+        for (const Point& q : queries){
+            found += search_nearest(photonMap, q, 50, 0.2).size();
+        }
+        doNotOptimize(found);
+    });
+    // Mismo k=100 sobre un vector de la arena del hilo con la capacidad reservada
+    suite.run("KDTree nearest_neighbors (k=100, arena)", queries.size(), [&]() {
+        ArenaScope scope;
+        ArenaVector<const Photon*> nearest;
+        nearest.reserve(MAX_NEIGHBORS + 1);
+        size_t found = 0;
+        for (const Point& q : queries){
+            search_nearest(photonMap, q, MAX_NEIGHBORS, numeric_limits<float>::infinity(), nearest);
+            found += nearest.size();
+        }
+        doNotOptimize(found);
+    });
+
+    /* MUESTREO */
+    suite.run("randomDirection()", RAYS, [&]() {
+        Vector sum(0, 0, 0);
+        for (size_t i = 0; i < RAYS; i++){
+            sum = sum + randomDirection();
+        }
+        doNotOptimize(sum);
+    });
+    Vector normal = normalize(Vector(0.3, 0.9, -0.2));
+    Point origin(0, 0, 0);
+    suite.run("randomDirection(point, normal)", RAYS, [&]() {
+        Vector sum(0, 0, 0);
+        for (size_t i = 0; i < RAYS; i++){
+            sum = sum + randomDirection(origin, normal);
+        }
+        doNotOptimize(sum);
+    });
+
+    // Mismos numeros aleatorios para todas las variantes: solo se mide la transformacion
+    vector<double> u1(RAYS), u2(RAYS);
+    Sampling::randomNumbers(RAYS, u1.data());
+    Sampling::randomNumbers(RAYS, u2.data());
+    suite.run("cosine direction, acos + baseChange (reference)", RAYS, [&]() {
+        Vector sum(0, 0, 0);
+        for (size_t i = 0; i < RAYS; i++){
+            sum = sum + baseChangeCosineDirection(origin, normal, u1[i], u2[i]);
+        }
+        doNotOptimize(sum);
+    });
+    suite.run("Sampling::cosineHemisphere(normal, u1, u2)", RAYS, [&]() {
+        Vector sum(0, 0, 0);
+        for (size_t i = 0; i < RAYS; i++){
+            sum = sum + Sampling::cosineHemisphere(normal, u1[i], u2[i]);
+        }
+        doNotOptimize(sum);
+    });
+    vector<double> dx(RAYS), dy(RAYS), dz(RAYS);
+    suite.run("Sampling::cosineHemisphere batch", RAYS, [&]() {
+        Sampling::cosineHemisphere(normal, RAYS, u1.data(), u2.data(), dx.data(), dy.data(), dz.data());
+        doNotOptimize(dx);
+    });
+    suite.run("Sampling::uniformSphere(u1, u2)", RAYS, [&]() {
+        Vector sum(0, 0, 0);
+        for (size_t i = 0; i < RAYS; i++){
+            sum = sum + Sampling::uniformSphere(u1[i], u2[i]);
+        }
+        doNotOptimize(sum);
+    });
+    suite.run("Sampling::uniformSphere batch", RAYS, [&]() {
+        Sampling::uniformSphere(RAYS, u1.data(), u2.data(), dx.data(), dy.data(), dz.data());
+        doNotOptimize(dx);
+    });
+
+    /* LUZ DIRECTA */
+    // Un solo oclusor para que domine el coste de elegir y muestrear la luz
+    FigureCollection occluders(vector<Figure*>({&sphere}));
+    Intersection shadingPoint;
+    shadingPoint.intersectionPoint = Point(0, -0.9, 0);
+    shadingPoint.normal = Vector(0, 1, 0);
+    auto shadingMaterial = make_shared<Materials::Lambertian>(Color(0.8, 0.8, 0.8));
+    shadingPoint.material = shadingMaterial.get();
+    const size_t NEE_SAMPLES = 1024;
+    const PhotonMap emptyPhotonMap = newPhotonMap({});
+    const RenderSettings defaultSettings;
+    auto lightGrid = [](size_t n, bool area){
+        vector<shared_ptr<Light>> lights;
+        for (size_t i = 0; i < n; i++){
+            Point center(randomDouble(-0.9, 0.9), 0.9, randomDouble(-0.9, 0.9));
+            Color power(randomDouble(), randomDouble(), randomDouble());
+            if(area){
+                lights.push_back(make_shared<Lights::RectangleLight>(center, Vector(0.05, 0, 0), Vector(0, 0, 0.05), power));
+            }else{
+                lights.push_back(make_shared<Light>(center, power));
+            }
+        }
+        return lights;
+    };
+    {
+        vector<shared_ptr<Light>> lights = lightGrid(4096, true);
+        suite.run("LightTree build (4096 rect lights)", 1, [&]() {
+            LightTree tree(lights);
+            doNotOptimize(tree);
+        });
+    }
+    for (size_t count : {1, 16, 256, 4096}){
+        for (bool area : {false, true}){
+            LightSampler lights(lightGrid(count, area));
+            PathIntegrator integrator(occluders, lights, emptyPhotonMap, defaultSettings);
+            string name = "PathIntegrator::nextEvent (" + to_string(count) + (area ? " rect lights)" : " point lights)");
+            suite.run(name, NEE_SAMPLES, [&]() {
+                Color sum(0, 0, 0);
+                for (size_t i = 0; i < NEE_SAMPLES; i++){
+                    sum += integrator.nextEvent(shadingPoint);
+                }
+                doNotOptimize(sum);
+            });
+        }
+    }
+    // Referencia: una muestra y un rayo de sombra por luz (version anterior)
+    {
+        vector<shared_ptr<Light>> lights = lightGrid(256, false);
+        suite.run("nextEvent loop over all (256 point lights)", NEE_SAMPLES, [&]() {
+            Color sum(0, 0, 0);
+            for (size_t i = 0; i < NEE_SAMPLES; i++){
+                for (const auto& light : lights){
+                    LightSample sample;
+                    Intersection shadow;
+                    if(light->sample(shadingPoint.intersectionPoint, 0.5, 0.5, sample) &&
+                       !occluders.isIntersectedBy(Ray(shadingPoint.intersectionPoint, sample.direction), 0.00001f, sample.distance, shadow)){
+                        sum += sample.radiance;
+                    }
+                }
+            }
+            doNotOptimize(sum);
+        });
+    }
+    occluders.deleteAll();
+
+    /* CAMINOS */
+    // Caja de espejos: todos los caminos llegan a settings.maxBounces rebotes especulares
+    auto mirror = make_shared<Material>(Color(0, 0, 0), Color(0.9, 0.9, 0.9), Color(0, 0, 0), 0);
+    FigureCollection mirrorBox(vector<Figure*>({
+        new Plane(Vector(1, 0, 0), 1, mirror), new Plane(Vector(-1, 0, 0), 1, mirror),
+        new Plane(Vector(0, 1, 0), 1, mirror), new Plane(Vector(0, -1, 0), 1, mirror),
+        new Plane(Vector(0, 0, 1), 1, mirror), new Plane(Vector(0, 0, -1), 1, mirror)
+    }));
+    vector<Ray> pathRays;
+    for (size_t i = 0; i < RAYS; i++){
+        pathRays.push_back(Ray(Point(0, 0, 0), randomDirection()));
+    }
+    const LightSampler noLights(vector<shared_ptr<Light>>{});
+    RenderSettings noRoulette;
+    noRoulette.rouletteDepth = noRoulette.maxBounces + 1;
+    suite.run("recursive radiance (mirror box, 6 bounces)", RAYS, [&]() {
+        Color sum(0, 0, 0);
+        Intersection intersection;
+        for (const Ray& ray : pathRays){
+            if(mirrorBox.isIntersectedBy(ray, 0.00001f, INT_MAX, intersection)){
+                sum += recursiveRadiance(ray, intersection, mirrorBox, noRoulette, 0);
+            }
+        }
+        doNotOptimize(sum);
+    });
+    vector<pair<string, const RenderSettings*>> pathSettings = {
+        {"PathIntegrator::radiance (mirror box, 6 bounces)", &noRoulette},
+        {"PathIntegrator::radiance (mirror box, roulette)", &defaultSettings}
+    };
+    for (const auto& [name, settings] : pathSettings){
+        PathIntegrator integrator(mirrorBox, noLights, emptyPhotonMap, *settings);
+        suite.run(name, RAYS, [&]() {
+            Color sum(0, 0, 0);
+            for (const Ray& ray : pathRays){
+                sum += integrator.radiance(ray);
+            }
+            doNotOptimize(sum);
+        });
+    }
+    mirrorBox.deleteAll();
+
+    /* RESERVAS POR MUESTRA */
+    // Con el contador de operator new: una muestra de camara (camino completo,
+    // luz directa y estimacion con el mapa de fotones) no debe reservar memoria
+    {
+        unique_ptr<Scene> cornellScene = buildBenchmarkScene("cornell");
+        RenderSettings sampleSettings;
+        sampleSettings.photons = 20000;
+        sampleSettings.threads = 1;
+        sampleSettings.showProgress = false;
+        sampleSettings.raysPerPixel = 4;
+        sampleSettings.width = sampleSettings.height = 32;
+        Camera& camera = cornellScene->camera;
+        camera.setWidth(sampleSettings.width);
+        camera.setHeight(sampleSettings.height);
+        PhotonMap cornellMap = camera.generatePhotonMap(cornellScene->figures, cornellScene->lights, sampleSettings);
+        const LightSampler cornellLights(cornellScene->lights);
+        PathIntegrator integrator(cornellScene->figures, cornellLights, cornellMap, sampleSettings);
+        auto samples = [&]() {
+            Color sum(0, 0, 0);
+            for (size_t i = 0; i < RAYS; i++){
+                sum += integrator.radiance(camera.getRayToPixel(i % 32, (i / 32) % 32));
+            }
+            doNotOptimize(sum);
+        };
+        suite.run("PathIntegrator::radiance (cornell, photon map)", RAYS, samples);
+        allocationBench(options, "PathIntegrator::radiance allocations", RAYS, samples);
+        // Lo que queda es fijo por imagen: hilos del pool, imagen y copias por nodo
+        allocationBench(options, "Camera::render allocations per sample", 32 * 32 * sampleSettings.raysPerPixel, [&]() {
+            PPM image = camera.render(cornellScene->figures, cornellScene->lights, cornellMap, sampleSettings);
+            doNotOptimize(image);
+        });
+    }
+
+    /* REORDENACION DE RAYOS */
+    // Rebotes difusos desde los impactos de camara en la escena de malla densa,
+    // barajados como quedan tras agrupar por material
+    {
+        const size_t SECONDARY = 16384;
+        unique_ptr<Scene> meshScene = buildBenchmarkScene("mesh");
+        vector<Ray> secondary;
+        Intersection hit;
+        while(secondary.size() < SECONDARY){
+            Point origin(randomDouble(-0.2, 0.2), randomDouble(-0.2, 0.2), -3.5);
+            Point target(randomDouble(-1, 1), randomDouble(-1, 1), 0);
+            if(meshScene->figures.isIntersectedBy(Ray(origin, target - origin), 0.00001f, INT_MAX, hit)){
+                secondary.push_back(Ray(hit.intersectionPoint, randomDirection(hit.intersectionPoint, hit.normal)));
+            }
+        }
+        shuffle(secondary.begin(), secondary.end(), mt19937(1234));
+        auto trace = [&](const vector<uint32_t>* order, bool lookup){
+            size_t found = 0;
+            Intersection intersection;
+            for (size_t i = 0; i < secondary.size(); i++){
+                const Ray& ray = secondary[order ? (*order)[i] : i];
+                if(meshScene->figures.isIntersectedBy(ray, 0.00001f, INT_MAX, intersection) && lookup){
+                    found += search_nearest(photonMap, intersection.intersectionPoint, 50, 0.2).size();
+                }
+            }
+            return found;
+        };
+        suite.run("binRays (16k rays)", SECONDARY, [&]() {
+            doNotOptimize(binRays(secondary));
+        });
+        for (bool lookup : {false, true}){
+            string what = lookup ? "intersect + photon lookup" : "intersect";
+            suite.run(what + " (mesh scene, random order)", SECONDARY, [&]() {
+                doNotOptimize(trace(nullptr, lookup));
+            });
+            suite.run(what + " (mesh scene, binned)", SECONDARY, [&]() {
+                vector<uint32_t> order = binRays(secondary);
+                doNotOptimize(trace(&order, lookup));
+            });
+        }
+    }
+
+    /* MATRICES */
+    Matrix a = translation(1, 2, 3) * rotationX(0.3) * scale(2, 2, 2);
+    Matrix b = rotationY(0.7) * translation(-1, 0, 4);
+    const size_t MATRIX_OPS = 10000;
+    suite.run("Matrix * Matrix", MATRIX_OPS, [&]() {
+        Matrix m = a;
+        for (size_t i = 0; i < MATRIX_OPS; i++){
+            m = b * m;
+            doNotOptimize(m);
+        }
+    });
+    suite.run("inverse(Matrix)", MATRIX_OPS, [&]() {
+        for (size_t i = 0; i < MATRIX_OPS; i++){
+            Matrix m = inverse(a);
+            doNotOptimize(m);
+        }
+    });
+    suite.run("Matrix * Point", MATRIX_OPS, [&]() {
+        Point p(1, 2, 3);
+        for (size_t i = 0; i < MATRIX_OPS; i++){
+            p = Point(a * p);
+            doNotOptimize(p);
+        }
+    });
+    AffineMatrix affineA(a), affineB(b);
+    suite.run("AffineMatrix * AffineMatrix", MATRIX_OPS, [&]() {
+        AffineMatrix m = affineA;
+        for (size_t i = 0; i < MATRIX_OPS; i++){
+            m = affineB * m;
+            doNotOptimize(m);
+        }
+    });
+    suite.run("inverse(AffineMatrix)", MATRIX_OPS, [&]() {
+        for (size_t i = 0; i < MATRIX_OPS; i++){
+            AffineMatrix m = inverse(affineA);
+            doNotOptimize(m);
+        }
+    });
+    suite.run("AffineMatrix::transformPoint", MATRIX_OPS, [&]() {
+        Point p(1, 2, 3);
+        for (size_t i = 0; i < MATRIX_OPS; i++){
+            p = affineA.transformPoint(p);
+            doNotOptimize(p);
+        }
+    });
+
+    // Transformacion de una malla grande: lee y escribe cada vertice una vez
+    // (con b, sin escala, para que las repeticiones no desborden)
+    const size_t VERTICES = 1 << 20;
+    vector<Real> positions(3 * VERTICES);
+    for (Real& v : positions){
+        v = randomDouble(-1, 1);
+    }
+    const size_t vertexBytes = 2 * positions.size() * sizeof(Real);
+    // Referencia: Matrix * Point por vertice (lo que hacia Triangle::applyTransform)
+    suite.run("Matrix * Point per vertex (1M vertices)", VERTICES, [&]() {
+        for (size_t i = 0; i < positions.size(); i += 3){
+            Point p = b * Point(positions[i], positions[i + 1], positions[i + 2]);
+            positions[i] = p.x;
+            positions[i + 1] = p.y;
+            positions[i + 2] = p.z;
+        }
+        doNotOptimize(positions.data());
+    }, vertexBytes);
+    suite.run("AffineMatrix::transformPoints xyz (1M vertices)", VERTICES, [&]() {
+        affineB.transformPoints(positions.data(), positions.data(), VERTICES);
+        doNotOptimize(positions.data());
+    }, vertexBytes);
+    vector<Real> soaX(VERTICES), soaY(VERTICES), soaZ(VERTICES);
+    for (size_t i = 0; i < VERTICES; i++){
+        soaX[i] = positions[3 * i];
+        soaY[i] = positions[3 * i + 1];
+        soaZ[i] = positions[3 * i + 2];
+    }
+    suite.run("AffineMatrix::transformPoints SoA (1M vertices)", VERTICES, [&]() {
+        affineB.transformPoints(VERTICES, soaX.data(), soaY.data(), soaZ.data());
+        doNotOptimize(soaX.data());
+    }, vertexBytes);
+    // Copia pura del mismo volumen: el limite de ancho de banda
+    vector<Real> copyTarget(positions.size());
+    suite.run("memcpy (1M vertices)", VERTICES, [&]() {
+        std::copy(positions.begin(), positions.end(), copyTarget.begin());
+        doNotOptimize(copyTarget.data());
+    }, vertexBytes);
+
+    /* PPM */
+    // Imagen HDR como las de files/ (enteros grandes con #MAX) para medir el parser
+    const int32_t PPM_WIDTH = 1024, PPM_HEIGHT = 768;
+    PPM image(PPM_HEIGHT, PPM_WIDTH);
+    for (int32_t i = 0; i < PPM_HEIGHT; i++){
+        for (int32_t j = 0; j < PPM_WIDTH; j++){
+            image[i][j] = PPM::Pixel(50 * randomDouble(), 50 * randomDouble(), 50 * randomDouble());
+        }
+    }
+    const string tmpFile = "bench_tmp.ppm";
+    {
+        ofstream outFile(tmpFile);
+        outFile << "P3\n#MAX=50\n" << PPM_WIDTH << ' ' << PPM_HEIGHT << "\n10000000\n";
+        for (size_t i = 0; i < 3 * image.getWidth() * size_t(image.getHeight()); i++){
+            outFile << long(image.data()[i] / 50 * 1e7) << (i % 3 == 2 ? '\t' : ' ');
+        }
+    }
+    const size_t ppmBytes = fileSize(tmpFile);
+    // Referencia: lectura con operator>> (version anterior)
+    suite.run("PPM::load istream (1024x768 HDR)", 1, [&]() {
+        ifstream inFile(tmpFile);
+        string version, max;
+        int32_t width, height;
+        double maxColor;
+        inFile >> version >> max >> width >> height >> maxColor;
+        vector<double> values(3 * size_t(width) * height);
+        for (double& v : values){
+            inFile >> v;
+            v *= 50 / maxColor;
+        }
+        doNotOptimize(values);
+    }, ppmBytes);
+    suite.run("PPM::load mmap, 1 thread (1024x768 HDR)", 1, [&]() {
+        PPM loaded(tmpFile, 1);
+        doNotOptimize(loaded);
+    }, ppmBytes);
+    suite.run("PPM::load mmap (1024x768 HDR)", 1, [&]() {
+        PPM loaded(tmpFile);
+        doNotOptimize(loaded);
+    }, ppmBytes);
+    image.save(tmpFile);
+    suite.run("PPM::save (1024x768 HDR)", 1, [&]() {
+        image.save(tmpFile);
+    }, fileSize(tmpFile));
+    const string pfmFile = "bench_tmp.pfm";
+    image.save(pfmFile);
+    const size_t pfmBytes = fileSize(pfmFile);
+    suite.run("PPM::load PFM (1024x768)", 1, [&]() {
+        PPM loaded(pfmFile);
+        doNotOptimize(loaded);
+    }, pfmBytes);
+    suite.run("PPM::save PFM (1024x768)", 1, [&]() {
+        image.save(pfmFile);
+    }, pfmBytes);
+    remove(tmpFile.c_str());
+    remove(pfmFile.c_str());
+
+    /* TONE MAPPING */
+    const int32_t TONE_SIZE = 1024;
+    PPM hdr(TONE_SIZE, TONE_SIZE);
+    for (int32_t i = 0; i < TONE_SIZE; i++){
+        for (int32_t j = 0; j < TONE_SIZE; j++){
+            hdr[i][j] = PPM::Pixel(4 * randomDouble(), 4 * randomDouble(), 4 * randomDouble());
+        }
+    }
+    const size_t toneValues = 3 * size_t(TONE_SIZE) * TONE_SIZE;
+    vector<Real> toneBuffer(toneValues);
+    // Referencia: recorte, normalizado y pow por canal en pasadas separadas (version anterior)
+    suite.run("ToneMapping naive clamp+gamma (1024x1024)", toneValues, [&]() {
+        copy(hdr.data(), hdr.data() + toneValues, toneBuffer.begin());
+        for (Real& v : toneBuffer) v = min<Real>(v, 1);
+        for (Real& v : toneBuffer) v = v / Real(1);
+        for (Real& v : toneBuffer) v = pow(v, Real(1 / 2.2));
+        doNotOptimize(toneBuffer);
+    });
+    for (const char* description : {"clamp:1,gamma:2.2", "reinhard:4,gamma:2.2", "exposure:-1,aces,gamma:2.2"}){
+        ToneMappingPipeline pipeline = ToneMappingPipeline::parse(description);
+        suite.run("ToneMappingPipeline " + string(description) + " (1024x1024)", toneValues, [&]() {
+            copy(hdr.data(), hdr.data() + toneValues, toneBuffer.begin());
+            pipeline.apply(toneBuffer.data(), toneValues, 4.0);
+            doNotOptimize(toneBuffer);
+        });
+    }
+
+    if(!options.jsonFile.empty()){
+        suite.saveJson(options.jsonFile);
+    }
+    return 0;
+}
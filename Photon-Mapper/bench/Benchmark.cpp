@@ -0,0 +1,98 @@
+#include "Benchmark.hpp"
+#include "Real.hpp"
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <stdexcept>
+
+double BenchmarkSuite::percentile(const std::vector<double>& sorted, double p){
+    if(sorted.empty()){
+        return 0;
+    }
+    double pos = p * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double frac = pos - lo;
+    return sorted[lo] * (1 - frac) + sorted[hi] * frac;
+}
+
+void BenchmarkSuite::add(const std::string& name, size_t opsPerRun, std::vector<double> samples, size_t bytesPerRun){
+    std::sort(samples.begin(), samples.end());
+    BenchResult result;
+    result.name = name;
+    result.opsPerRun = opsPerRun;
+    result.repetitions = samples.size();
+    result.median = percentile(samples, 0.5);
+    result.p10 = percentile(samples, 0.1);
+    result.p90 = percentile(samples, 0.9);
+    result.min = samples.empty() ? 0 : samples.front();
+    result.mean = samples.empty() ? 0 : std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    result.bytesPerRun = bytesPerRun;
+    // bytes / ns = GB/s
+    result.mbPerSecond = result.median > 0 ? 1e3 * double(bytesPerRun) / (result.median * double(opsPerRun)) : 0;
+    results.push_back(result);
+    std::cout << std::left << std::setw(40) << name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(2) << result.median << " ns/op"
+              << "  (p10 " << result.p10 << ", p90 " << result.p90 << ")";
+    if(bytesPerRun > 0){
+        std::cout << "  " << result.mbPerSecond << " MB/s";
+    }
+    std::cout << std::endl;
+}
+
+void BenchmarkSuite::saveJson(const std::string& fileName) const{
+    std::ofstream outFile(fileName);
+    if(!outFile.is_open()){
+        throw std::runtime_error("Cannot write benchmark file: " + fileName);
+    }
+    outFile << std::setprecision(6);
+    outFile << "{" << std::endl;
+    outFile << "  \"unit\": \"ns/op\"," << std::endl;
+    outFile << "  \"real\": \"" << (sizeof(Real) == sizeof(float) ? "float" : "double") << "\"," << std::endl;
+    outFile << "  \"warmup\": " << options.warmup << "," << std::endl;
+    outFile << "  \"repetitions\": " << options.repetitions << "," << std::endl;
+    outFile << "  \"benchmarks\": [" << std::endl;
+    for (size_t i = 0; i < results.size(); i++){
+        const BenchResult& r = results[i];
+        outFile << "    {\"name\": \"" << r.name << "\""
+                << ", \"ops_per_run\": " << r.opsPerRun
+                << ", \"median\": " << r.median
+                << ", \"p10\": " << r.p10
+                << ", \"p90\": " << r.p90
+                << ", \"min\": " << r.min
+                << ", \"mean\": " << r.mean;
+        if(r.bytesPerRun > 0){
+            outFile << ", \"bytes_per_run\": " << r.bytesPerRun
+                    << ", \"mb_per_s\": " << r.mbPerSecond;
+        }
+        outFile << "}"
+                << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    outFile << "  ]" << std::endl;
+    outFile << "}" << std::endl;
+}
+
+BenchOptions parseBenchOptions(int argc, char* argv[]){
+    BenchOptions options;
+    for (int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if(i + 1 >= argc){
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+        if(arg == "--warmup"){
+            options.warmup = std::stoul(next());
+        }else if(arg == "--reps"){
+            options.repetitions = std::stoul(next());
+        }else if(arg == "--filter"){
+            options.filter = next();
+        }else if(arg == "--json"){
+            options.jsonFile = next();
+        }else{
+            throw std::runtime_error("Unknown option: " + arg);
+        }
+    }
+    return options;
+}
@@ -0,0 +1,80 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+// Mini harness de microbenchmarks: calentamiento, repeticiones y estadisticas
+// (mediana y percentiles) en nanosegundos por operacion.
+
+struct BenchResult{
+    std::string name;
+    size_t opsPerRun;
+    size_t repetitions;
+    double median;
+    double p10;
+    double p90;
+    double min;
+    double mean;
+    size_t bytesPerRun;     // 0 -> sin throughput
+    double mbPerSecond;     // con la mediana
+};
+
+struct BenchOptions{
+    size_t warmup = 3;
+    size_t repetitions = 15;
+    std::string filter = "";
+    std::string jsonFile = "";
+};
+
+// Evita que el compilador elimine el calculo de un resultado
+template<typename T>
+inline void doNotOptimize(const T& value){
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+class BenchmarkSuite{
+private:
+    BenchOptions options;
+    std::vector<BenchResult> results;
+
+    static double percentile(const std::vector<double>& sorted, double p);
+public:
+    BenchmarkSuite(const BenchOptions& options) : options(options) {}
+
+    // f ejecuta opsPerRun operaciones en cada llamada; con bytesPerRun se informa tambien de MB/s
+    template<typename F>
+    void run(const std::string& name, size_t opsPerRun, F&& f, size_t bytesPerRun = 0){
+        if(!options.filter.empty() && name.find(options.filter) == std::string::npos){
+            return;
+        }
+        for (size_t i = 0; i < options.warmup; i++){
+            f();
+        }
+        std::vector<double> samples;
+        samples.reserve(options.repetitions);
+        for (size_t i = 0; i < options.repetitions; i++){
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / double(opsPerRun));
+        }
+        add(name, opsPerRun, samples, bytesPerRun);
+    }
+
+    void add(const std::string& name, size_t opsPerRun, std::vector<double> samples, size_t bytesPerRun = 0);
+    void saveJson(const std::string& fileName) const;
+    const BenchOptions& getOptions() const { return options; }
+};
+
+BenchOptions parseBenchOptions(int argc, char* argv[]);
+
+#endif /* BENCHMARK_HPP */
@@ -0,0 +1,481 @@
+#include "Scenes.hpp"
+#include "SceneLoader.hpp"
+#include "ToneMapping.hpp"
+#include "ImageMetrics.hpp"
+#include "RenderStats.hpp"
+#include "RenderSettings.hpp"
+#include "OutputWriter.hpp"
+#include "MeshLoader.hpp"
+#include "Triangle.hpp"
+#include "TriangleMesh.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Driver sin interfaz para renderizar las escenas de referencia y validar cambios
+// de rendimiento. Compilacion (desde Photon-Mapper/):
+//     g++ --std=c++17 -O3 -DNDEBUG -I. driver/*.cpp $(ls *.cpp | grep -v main.cpp) -o driver.out -pthread
+// Ejemplos:
+//     ./driver.out --scene all --resolution 256 --spp 16 --reference refs --write-reference
+//     ./driver.out --scene cornell --threads 8 --reference refs --min-psnr 30
+
+using namespace std;
+
+namespace {
+    struct DriverOptions{
+        vector<string> scenes;
+        RenderSettings settings;
+        string outputDir = ".";
+        string referenceDir = "";
+        bool writeReference = false;
+        bool scaling = false;
+        bool checkLoaders = false;
+        bool checkTriangles = false;
+        double minPsnr = 30.0;
+    };
+
+    void usage(){
+        RenderSettings defaults;
+        cout << "Uso: driver.out [opciones]" << endl
+             << "  --scene NOMBRE|all   escena a renderizar (repetible)" << endl
+             << "  --scene FICHERO      escena descrita en un fichero .scene" << endl
+             << "  --list               lista las escenas disponibles" << endl
+             << "  --config FICHERO     ajustes de render en formato clave = valor" << endl
+             << "  --width N            ancho de la imagen (" << defaults.width << ")" << endl
+             << "  --height N           alto de la imagen (" << defaults.height << ")" << endl
+             << "  --resolution N       ancho y alto a la vez" << endl
+             << "  --spp N              rayos por pixel (" << defaults.raysPerPixel << ")" << endl
+             << "  --bounces N          rebotes maximos (" << defaults.maxBounces << ")" << endl
+             << "  --paths N            caminos por muestra (" << defaults.maxPaths << ")" << endl
+             << "  --roulette N         rebotes antes de la ruleta rusa (" << defaults.rouletteDepth << ")" << endl
+             << "  --photons N          fotones emitidos (" << defaults.photons << ")" << endl
+             << "  --k N                vecinos en la estimacion de densidad (" << defaults.neighbors << ")" << endl
+             << "  --threads N          hilos de render (todos)" << endl
+             << "  --wavefront on|off   render por oleadas (off)" << endl
+             << "  --raysort on|off     reordena los rayos secundarios por oleada (on)" << endl
+             << "  --pipeline on|off    G-buffer de camara mientras se construye el mapa de fotones (off)" << endl
+             << "  --writequeue N       imagenes guardandose mientras sigue el render (" << defaults.writeQueue << ", 0 sincrono)" << endl
+             << "  --affinity none|core|socket  fija los hilos de render por nucleo o por nodo NUMA (none)" << endl
+             << "  --scaling            tiempo de render de 1 a N hilos, sin afinidad y con ella" << endl
+             << "  --check-loaders      carga mallas PLY generadas en --output y comprueba sus triangulos" << endl
+             << "  --check-triangles    interseca triangulos de 1 a 1e-4 de lado y rayos paralelos" << endl
+             << "  --tonemap LISTA      operadores de tono (" << defaults.toneMapping << ")" << endl
+             << "  --seed N             semilla (1; reproducible con --threads 1)" << endl
+             << "  --output DIR         directorio de salida (.)" << endl
+             << "  --reference DIR      compara con DIR/<escena>.ppm" << endl
+             << "  --write-reference    guarda las imagenes como referencia en DIR" << endl
+             << "  --min-psnr DB        PSNR minimo para aceptar (30)" << endl;
+    }
+
+    DriverOptions parseOptions(int argc, char* argv[]){
+        DriverOptions options;
+        options.settings.seed = 1;
+        options.settings.showProgress = false;
+        vector<string> args = options.settings.parseArgs(argc, argv);
+        for (size_t i = 0; i < args.size(); i++){
+            const string& arg = args[i];
+            auto next = [&]() -> string {
+                if(i + 1 >= args.size()){
+                    throw runtime_error("Missing value for " + arg);
+                }
+                return args[++i];
+            };
+            if(arg == "--scene"){
+                string name = next();
+                if(name == "all"){
+                    vector<string> all = benchmarkSceneNames();
+                    options.scenes.insert(options.scenes.end(), all.begin(), all.end());
+                }else{
+                    options.scenes.push_back(name);
+                }
+            }else if(arg == "--output") options.outputDir = next();
+            else if(arg == "--reference") options.referenceDir = next();
+            else if(arg == "--write-reference") options.writeReference = true;
+            else if(arg == "--scaling") options.scaling = true;
+            else if(arg == "--check-loaders") options.checkLoaders = true;
+            else if(arg == "--check-triangles") options.checkTriangles = true;
+            else if(arg == "--min-psnr") options.minPsnr = stod(next());
+            else if(arg == "--list"){
+                for (const string& name : benchmarkSceneNames()) cout << name << endl;
+                exit(0);
+            }else if(arg == "--help" || arg == "-h"){
+                usage();
+                exit(0);
+            }else{
+                throw runtime_error("Unknown option: " + arg);
+            }
+        }
+        if(options.scenes.empty()){
+            options.scenes = benchmarkSceneNames();
+        }
+        if(options.writeReference && options.referenceDir.empty()){
+            throw runtime_error("--write-reference needs --reference DIR");
+        }
+        return options;
+    }
+
+    double secondsSince(const chrono::steady_clock::time_point& start){
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    bool fileExists(const string& fileName){
+        return ifstream(fileName).good();
+    }
+
+    bool isSceneFile(const string& name){
+        return name.size() > 6 && name.compare(name.size() - 6, 6, ".scene") == 0;
+    }
+
+    string baseName(const string& fileName){
+        size_t slash = fileName.find_last_of("/\\");
+        string name = slash == string::npos ? fileName : fileName.substr(slash + 1);
+        return name.substr(0, name.find_last_of('.'));
+    }
+
+    // Curva de escalado: render de cada escena con 1, 2, 4... hasta N hilos (N =
+    // --threads o todos los nucleos), sin afinidad y con --affinity (socket si
+    // no se indica). El mapa de fotones se construye una vez por escena
+    int runScaling(const DriverOptions& options){
+        const NumaTopology& topology = NumaTopology::system();
+        RenderSettings settings = options.settings;
+        const size_t maxThreads = settings.threads > 0 ? settings.threads : topology.cpus();
+        vector<size_t> threadCounts;
+        for (size_t threads = 1; threads < maxThreads; threads *= 2){
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        const ThreadAffinity pinned = settings.affinity != AFFINITY_NONE ? settings.affinity : AFFINITY_SOCKET;
+
+        cout << "NUMA: " << topology.nodes() << " nodes, " << topology.cpus() << " cpus" << endl;
+        cout << fixed << setprecision(3);
+        cout << left << setw(18) << "scene" << right << setw(10) << "threads" << setw(10) << "affinity"
+             << setw(10) << "render" << setw(12) << "Mrays/s" << setw(10) << "speedup" << endl;
+        for (const string& sceneArg : options.scenes){
+            const bool fromFile = isSceneFile(sceneArg);
+            const string sceneName = fromFile ? baseName(sceneArg) : sceneArg;
+            try{
+                settings = options.settings;
+                unique_ptr<Scene> scene = fromFile ? loadScene(sceneArg, settings.threads) : buildBenchmarkScene(sceneName);
+                scene->camera.setWidth(settings.width);
+                scene->camera.setHeight(settings.height);
+                srand(settings.seed);
+                PhotonMap photonMap = scene->camera.generatePhotonMap(scene->figures, scene->lights, settings);
+
+                double baseSeconds = 0;
+                for (ThreadAffinity affinity : {AFFINITY_NONE, pinned}){
+                    for (size_t threads : threadCounts){
+                        settings.threads = threads;
+                        settings.affinity = affinity;
+                        srand(settings.seed);
+                        resetStats();
+                        auto start = chrono::steady_clock::now();
+                        scene->camera.render(scene->figures, scene->lights, photonMap, settings);
+                        double seconds = secondsSince(start);
+                        RenderStats stats = collectStats();
+                        double rays = double(stats.primaryRays + stats.secondaryRays + stats.shadowRays);
+                        if(baseSeconds == 0) baseSeconds = seconds;
+                        cout << left << setw(18) << sceneName << right << setw(10) << threads << setw(10) << affinityName(affinity)
+                             << setw(10) << seconds << setw(12) << (seconds > 0 ? rays / seconds / 1e6 : 0.0)
+                             << setw(10) << (seconds > 0 ? baseSeconds / seconds : 0.0) << endl;
+                    }
+                }
+            }catch(const exception& e){
+                cerr << sceneName << ": " << e.what() << endl;
+                return 2;
+            }
+        }
+        return 0;
+    }
+
+    // PLY binario little endian con una rejilla de vertices y las caras dadas
+    // (3 o 4 indices); devuelve la triangulacion en abanico esperada
+    vector<uint32_t> writePly(const string& fileName, uint32_t vertexCount, const vector<vector<int32_t>>& faces){
+        ofstream outFile(fileName, ios::binary);
+        if(!outFile.is_open()){
+            throw runtime_error("Cannot write PLY file: " + fileName);
+        }
+        outFile << "ply\nformat binary_little_endian 1.0\n"
+                << "element vertex " << vertexCount << "\nproperty float x\nproperty float y\nproperty float z\n"
+                << "element face " << faces.size() << "\nproperty list uchar int vertex_indices\nend_header\n";
+        for (uint32_t i = 0; i < vertexCount; i++){
+            float xyz[3] = {float(i % 1024), float(i / 1024), 0};
+            outFile.write(reinterpret_cast<const char*>(xyz), sizeof(xyz));
+        }
+        vector<uint32_t> expected;
+        for (const vector<int32_t>& face : faces){
+            uint8_t count = uint8_t(face.size());
+            outFile.write(reinterpret_cast<const char*>(&count), 1);
+            outFile.write(reinterpret_cast<const char*>(face.data()), face.size() * sizeof(int32_t));
+            for (size_t k = 2; k < face.size(); k++){
+                expected.insert(expected.end(), {uint32_t(face[0]), uint32_t(face[k - 1]), uint32_t(face[k])});
+            }
+        }
+        return expected;
+    }
+
+    // Comprobaciones del importador PLY sobre ficheros generados: solo
+    // triangulos (camino paralelo), triangulos y cuadrilateros mezclados (el
+    // camino paralelo debe ceder al secuencial sin lanzar) e indices fuera de
+    // rango (error en ambos caminos). Con 8 hilos para repartir en rangos.
+    // Los indices son 256 m + 3: tras un cuadrilatero, leer con el paso de un
+    // triangulo da un contador 3 y un indice enorme, que es lo que hacia fallar
+    // al camino paralelo cuando un rango posterior iba por delante
+    int runLoaderChecks(const DriverOptions& options){
+        const size_t THREADS = 8;
+        const uint32_t VERTICES = 65536;
+        const size_t FACES = 100000;
+        bool allPassed = true;
+        auto report = [&](const string& name, bool passed, const string& detail){
+            cout << left << setw(40) << name << (passed ? "OK" : "FAIL") << (detail.empty() ? "" : "  " + detail) << endl;
+            allPassed = allPassed && passed;
+        };
+        auto expectMesh = [&](const string& name, const string& fileName, const vector<uint32_t>& expected){
+            try{
+                MeshData mesh = loadPly(fileName, THREADS);
+                bool passed = mesh.positions.size() == 3 * size_t(VERTICES) && mesh.indices == expected;
+                report(name, passed, to_string(mesh.indices.size() / 3) + " triangles, expected " + to_string(expected.size() / 3));
+            }catch(const exception& e){
+                report(name, false, e.what());
+            }
+        };
+        auto expectError = [&](const string& name, const string& fileName){
+            try{
+                loadPly(fileName, THREADS);
+                report(name, false, "loaded without error");
+            }catch(const exception& e){
+                report(name, true, e.what());
+            }
+        };
+
+        vector<vector<int32_t>> triangles, mixed, oneQuad;
+        for (size_t i = 0; i < FACES; i++){
+            int32_t a = int32_t(256 * (i % 250) + 3);
+            triangles.push_back({a, a + 256, a + 512});
+            // Un cuadrilatero de cada 7 caras, el primero ya en el primer rango
+            if(i % 7 == 3) mixed.push_back({a, a + 256, a + 512, a + 768});
+            else mixed.push_back({a, a + 256, a + 512});
+        }
+        oneQuad = triangles;
+        oneQuad[3].push_back(oneQuad[3][2] + 256);
+        const string dir = options.outputDir + "/";
+        expectMesh("PLY triangles", dir + "check_triangles.ply", writePly(dir + "check_triangles.ply", VERTICES, triangles));
+        expectMesh("PLY triangles and quads", dir + "check_mixed.ply", writePly(dir + "check_mixed.ply", VERTICES, mixed));
+        expectMesh("PLY one quad, then triangles", dir + "check_one_quad.ply", writePly(dir + "check_one_quad.ply", VERTICES, oneQuad));
+        // Cuadrilateros solo al final: el camino paralelo ve triangulos validos hasta alli
+        vector<vector<int32_t>> lateQuads = triangles;
+        lateQuads.back() = {3, 259, 515, 771};
+        expectMesh("PLY triangles, quad last", dir + "check_late_quad.ply", writePly(dir + "check_late_quad.ply", VERTICES, lateQuads));
+
+        vector<vector<int32_t>> badTriangles = triangles;
+        badTriangles[FACES / 2][1] = int32_t(VERTICES);
+        writePly(dir + "check_bad_triangles.ply", VERTICES, badTriangles);
+        expectError("PLY triangles, index out of range", dir + "check_bad_triangles.ply");
+        vector<vector<int32_t>> badMixed = mixed;
+        badMixed[FACES / 2][0] = -1;
+        writePly(dir + "check_bad_mixed.ply", VERTICES, badMixed);
+        expectError("PLY mixed, index out of range", dir + "check_bad_mixed.ply");
+        return allPassed ? 0 : 2;
+    }
+
+    // Comprobaciones de la interseccion con triangulos en los tres caminos
+    // (Triangle, TriangleMesh y los arrays de SceneGeometry): un rayo perpendicular
+    // debe dar con triangulos de cualquier tamaño, y uno contenido en su plano o
+    // un triangulo degenerado no deben dar impacto
+    int runTriangleChecks(){
+        bool allPassed = true;
+        auto material = make_shared<Material>(Color::fromRGB(255, 255, 255));
+        // Impacto esperado (o ninguno si expectedT < 0) en los tres caminos
+        auto check = [&](const string& name, const Point& v0, const Point& v1, const Point& v2, const Ray& ray, Real expectedT){
+            Triangle triangle(make_shared<Point>(v0), make_shared<Point>(v1), make_shared<Point>(v2), material);
+            TriangleMesh mesh({v0.x, v0.y, v0.z, v1.x, v1.y, v1.z, v2.x, v2.y, v2.z}, {0, 1, 2}, material);
+            SceneGeometry geometry;
+            geometry.addTriangle(v0, v1, v2, material);
+            const IntersectableFigure* figures[3] = {&triangle, &mesh, &geometry};
+            const char* paths[3] = {"Triangle", "TriangleMesh", "SceneGeometry"};
+            for (size_t i = 0; i < 3; i++){
+                Intersection intersection;
+                bool hit = figures[i]->isIntersectedBy(ray, RAY_EPSILON, numeric_limits<Real>::max(), intersection);
+                bool passed = expectedT < 0 ? !hit : hit && abs(intersection.t - expectedT) <= Real(1e-3) * expectedT;
+                cout << left << setw(44) << name + ", " + paths[i] << (passed ? "OK" : "FAIL");
+                if(hit) cout << "  t = " << intersection.t;
+                cout << endl;
+                allPassed = allPassed && passed;
+            }
+        };
+
+        const Ray down(Point(0, 0, 0), Vector(0, 0, 1));
+        for (Real side : {Real(1), Real(1e-1), Real(1e-2), Real(1e-3), Real(1e-4)}){
+            ostringstream name;
+            name << "side " << side;
+            check(name.str(), Point(-side, -side, 2), Point(side, -side, 2), Point(0, side, 2), down, 2);
+        }
+        // Rayo en el plano del triangulo y triangulo sin area
+        check("ray in the triangle plane", Point(-1, -1, 2), Point(1, -1, 2), Point(0, 1, 2), Ray(Point(-3, 0, 2), Vector(1, 0, 0)), -1);
+        check("degenerate triangle", Point(0, 0, 2), Point(0, 0, 2), Point(0, 0, 2), down, -1);
+        return allPassed ? 0 : 2;
+    }
+
+    // Escena renderizada cuya imagen aun se esta escribiendo
+    struct PendingScene{
+        string name;
+        double buildSeconds = 0, photonSeconds = 0, renderSeconds = 0;
+        double rays = 0;
+        future<OutputWriter::Result> output;
+    };
+
+    // Espera a la imagen, imprime su fila y la compara con la referencia
+    bool report(PendingScene& scene, const DriverOptions& options){
+        OutputWriter::Result result;
+        try{
+            result = scene.output.get();
+        }catch(const exception& e){
+            cerr << scene.name << ": " << e.what() << endl;
+            return false;
+        }
+
+        cout << left << setw(18) << scene.name << right
+             << setw(10) << scene.buildSeconds << setw(10) << scene.photonSeconds << setw(10) << scene.renderSeconds
+             << setw(10) << result.toneSeconds << setw(10) << result.saveSeconds
+             << setw(12) << (scene.renderSeconds > 0 ? scene.rays / scene.renderSeconds / 1e6 : 0.0);
+
+        string referenceFile = options.referenceDir + "/" + scene.name + ".ppm";
+        if(options.referenceDir.empty() || options.writeReference){
+            cout << setw(10) << "-" << setw(10) << "-" << endl;
+            return true;
+        }
+        if(!fileExists(referenceFile)){
+            cout << setw(10) << "-" << setw(10) << "-" << "  MISSING " << referenceFile << endl;
+            return false;
+        }
+        try{
+            PPM reference(referenceFile);
+            double error = rmse(result.image, reference);
+            double quality = psnr(result.image, reference);
+            bool passed = quality >= options.minPsnr;
+            cout << setw(10) << error << setw(10) << quality << (passed ? "  OK" : "  FAIL") << endl;
+            return passed;
+        }catch(const exception& e){
+            cout << endl;
+            cerr << scene.name << ": " << e.what() << endl;
+            return false;
+        }
+    }
+}
+
+int main(int argc, char* argv[]){
+    DriverOptions options;
+    try{
+        options = parseOptions(argc, argv);
+    }catch(const exception& e){
+        cerr << e.what() << endl;
+        usage();
+        return 1;
+    }
+
+    const RenderSettings& settings = options.settings;
+    ToneMappingPipeline toneMapping;
+    try{
+        toneMapping = ToneMappingPipeline::parse(settings.toneMapping);
+    }catch(const exception& e){
+        cerr << e.what() << endl;
+        return 1;
+    }
+    cout << settings << endl;
+    if(options.checkLoaders){
+        return runLoaderChecks(options);
+    }
+    if(options.checkTriangles){
+        return runTriangleChecks();
+    }
+    if(options.scaling){
+        return runScaling(options);
+    }
+    // Las referencias de una compilacion double comparadas con una -DREAL_FLOAT dan la diferencia entre ambas
+    cout << "Real: " << (sizeof(Real) == sizeof(float) ? "float" : "double") << endl;
+
+    bool allPassed = true;
+    cout << fixed << setprecision(3);
+    cout << left << setw(18) << "scene" << right
+         << setw(10) << "build" << setw(10) << "photons" << setw(10) << "render"
+         << setw(10) << "tonemap" << setw(10) << "save" << setw(12) << "Mrays/s"
+         << setw(10) << "rmse" << setw(10) << "psnr" << endl;
+
+    // El tone mapping y el guardado de cada escena se solapan con el render de
+    // la siguiente; su fila se imprime cuando esta termina
+    OutputWriter writer(toneMapping, settings.threads, settings.writeQueue);
+    unique_ptr<PendingScene> pending;
+    for (const string& sceneArg : options.scenes){
+        // Fichero .scene: se nombra por su nombre base en la salida
+        const bool fromFile = isSceneFile(sceneArg);
+        const string sceneName = fromFile ? baseName(sceneArg) : sceneArg;
+        unique_ptr<PendingScene> current;
+        string error;
+        try{
+            srand(settings.seed);
+            resetStats();
+
+            auto start = chrono::steady_clock::now();
+            unique_ptr<Scene> scene = fromFile ? loadScene(sceneArg, settings.threads) : buildBenchmarkScene(sceneName);
+            scene->camera.setWidth(settings.width);
+            scene->camera.setHeight(settings.height);
+            double buildSeconds = secondsSince(start);
+
+            PhotonMap photonMap;
+            PPM image;
+            double photonSeconds = 0, renderSeconds = 0;
+            if(settings.pipelined && !settings.wavefront){
+                // Los fotones se solapan con el render: "render" es el tiempo total
+                // y "photons" el de la construccion del mapa, ya incluido en el
+                start = chrono::steady_clock::now();
+                image = scene->camera.renderPipelined(scene->figures, scene->lights, photonMap, settings, &photonSeconds);
+                renderSeconds = secondsSince(start);
+            }else{
+                start = chrono::steady_clock::now();
+                photonMap = scene->camera.generatePhotonMap(scene->figures, scene->lights, settings);
+                photonSeconds = secondsSince(start);
+
+                start = chrono::steady_clock::now();
+                image = scene->camera.render(scene->figures, scene->lights, photonMap, settings);
+                renderSeconds = secondsSince(start);
+            }
+
+            RenderStats stats = collectStats();
+            saveStatsJson(stats, photonSeconds, renderSeconds, options.outputDir + "/" + sceneName + "_stats.json");
+
+            current = make_unique<PendingScene>();
+            current->name = sceneName;
+            current->buildSeconds = buildSeconds;
+            current->photonSeconds = photonSeconds;
+            current->renderSeconds = renderSeconds;
+            current->rays = double(stats.primaryRays + stats.secondaryRays + stats.shadowRays);
+            string outputFile = (options.writeReference ? options.referenceDir : options.outputDir) + "/" + sceneName + ".ppm";
+            current->output = writer.submit(move(image), outputFile);
+        }catch(const exception& e){
+            error = e.what();
+        }
+
+        if(pending){
+            allPassed = report(*pending, options) && allPassed;
+        }
+        pending = move(current);
+        if(!error.empty()){
+            cerr << sceneName << ": " << error << endl;
+            allPassed = false;
+        }
+    }
+    if(pending){
+        allPassed = report(*pending, options) && allPassed;
+    }
+
+    return allPassed ? 0 : 2;
+}
@@ -103,9 +103,11 @@ private:
         build_tree(0,elements.size());
     }
     
-    template<typename Norm> //Norm is a norm of a vector (euclidean or any other one, even a weighted one) for std::array<real,N>
-    void nearest_neighbors_impl(std::vector<const T*>& values, std::size_t left, std::size_t right, const std::array<real,N>& p, std::size_t number, float& max_distance, const Norm& norm) const {
+    //Values is any vector-like container of const T* (std::vector with any allocator)
+    template<typename Values, typename Norm> //Norm is a norm of a vector (euclidean or any other one, even a weighted one) for std::array<real,N>
+    void nearest_neighbors_impl(Values& values, std::size_t left, std::size_t right, const std::array<real,N>& p, std::size_t number, float& max_distance, const Norm& norm, std::size_t& visited) const {
         if (right > left) {
+            ++visited; //Number of nodes explored, only for statistics
             std::size_t median = (right+left)/2; //Points to the actual node which is always in the median
             auto distance_comparison = [&] (const T* a, const T* b) { return norm(difference(p,*a))<norm(difference(p,*b)); };
             if (norm(difference(p,elements[median]))<max_distance) {
@@ -125,13 +127,13 @@ private:
                 std::array<real,N> pplane = p; 
                 pplane[nodes[median]] = axis_position(elements[median],nodes[median]);
                 if (p[nodes[median]] < axis_position(elements[median],nodes[median])) {//First left node and then, if needed, right node
-                    nearest_neighbors_impl(values,left,median,p,number,max_distance,norm);
+                    nearest_neighbors_impl(values,left,median,p,number,max_distance,norm,visited);
                     if (norm(difference(p,pplane)) < max_distance) //We still need to explore the other node
-                        nearest_neighbors_impl(values,median+1,right,p,number,max_distance,norm);
+                        nearest_neighbors_impl(values,median+1,right,p,number,max_distance,norm,visited);
                 } else { //First right node and then, if needed, left node
-                    nearest_neighbors_impl(values,median+1,right,p,number,max_distance,norm);
+                    nearest_neighbors_impl(values,median+1,right,p,number,max_distance,norm,visited);
                     if (norm(difference(p,pplane)) < max_distance) //We still need to explore the other node
-                        nearest_neighbors_impl(values,left,median,p,number,max_distance,norm);                      
+                        nearest_neighbors_impl(values,left,median,p,number,max_distance,norm,visited);                      
                 }
             }
         }
@@ -140,15 +142,48 @@ private:
 public:
     KDTree(std::vector<T>&& elements, const A& axis_position = A()) : elements(std::move(elements)), axis_position(axis_position) { build_tree(); }
     KDTree() {}
+    //Constructing from an already built tree: elements and nodes must be in the order left by build_tree, so no rebuild is done
+    KDTree(std::vector<T>&& elements, std::vector<axis_type>&& nodes, const A& axis_position = A()) : axis_position(axis_position), nodes(std::move(nodes)), elements(std::move(elements)) {}
     template<typename C> //Constructing from a general collection if possible
     KDTree(const C& c, const A& axis_position = A(), typename std::enable_if<std::is_same<T,typename C::value_type>::value>::type* sfinae = nullptr) : axis_position(axis_position), elements(c.begin(),c.end()) { build_tree(); }
     
+    //Access to the internal (tree ordered) storage, i.e. for serialization
+    const std::vector<T>& data() const { return elements; }
+    const std::vector<axis_type>& axes() const { return nodes; }
+    std::size_t size() const { return elements.size(); }
+
     template<typename Norm>
     std::vector<const T*> nearest_neighbors(const std::array<real,N>& p, std::size_t number, float max_distance, const Norm& norm) const {
+        std::size_t visited = 0;
+        return nearest_neighbors(p,number,max_distance,norm,visited);
+    }
+
+    //Same search, also accumulating in visited the number of nodes explored
+    template<typename Norm>
+    std::vector<const T*> nearest_neighbors(const std::array<real,N>& p, std::size_t number, float max_distance, const Norm& norm, std::size_t& visited) const {
         std::vector<const T*> sol;
-        nearest_neighbors_impl(sol,0,elements.size(),p,number,max_distance,norm);
+        nearest_neighbors_impl(sol,0,elements.size(),p,number,max_distance,norm,visited);
         return sol;
     }
+
+    template<typename P> //P -> position N dimensional, should have random access
+    std::vector<const T*> nearest_neighbors_counted(const P& p, std::size_t number, float max_distance, std::size_t& visited) const {
+        std::vector<const T*> sol;
+        nearest_neighbors_counted(p,number,max_distance,visited,sol);
+        return sol;
+    }
+
+    //Same search into a caller-provided container (cleared first); with capacity for number+1 elements it does not allocate
+    template<typename P, typename Values>
+    void nearest_neighbors_counted(const P& p, std::size_t number, float max_distance, std::size_t& visited, Values& values) const {
+        std::array<real,N> p_impl;
+        for (std::size_t i = 0; i<N; ++i) p_impl[i] = p[i];
+        values.clear();
+        nearest_neighbors_impl(values,0,elements.size(),p_impl,number,max_distance,
+            [] (const std::array<real,N>& v) {
+                real s(0); for (real r : v) s+=r*r; return std::sqrt(s);
+            }, visited);
+    }
     
 
     std::vector<const T*> nearest_neighbors(const std::array<real,N>& p, std::size_t number = 1, float max_distance = std::numeric_limits<float>::infinity()) const {
@@ -6,8 +6,32 @@
 
 using namespace std;
 
-int main(){
-    srand(time(NULL));
+int main(int argc, char* argv[]){
+    // Ajustes: valores de Utils.hpp, sobreescribibles con --config fichero o --clave valor
+    RenderSettings settings;
+    vector<string> args;
+    ToneMappingPipeline toneMapping;
+    try{
+        args = settings.parseArgs(argc, argv);
+        toneMapping = ToneMappingPipeline::parse(settings.toneMapping);
+    }catch(const std::exception& e){
+        cerr << e.what() << endl;
+        return 1;
+    }
+    // Resto de argumentos: --scene fichero.scene y el mapa de fotones a reutilizar
+    string sceneFile, photonMapFile;
+    for (size_t i = 0; i < args.size(); i++){
+        if(args[i] == "--scene" && i + 1 < args.size()){
+            sceneFile = args[++i];
+        }else if(args[i].rfind("--", 0) == 0){
+            cerr << "Unknown option: " << args[i] << endl;
+            return 1;
+        }else{
+            photonMapFile = args[i];
+        }
+    }
+    srand(settings.seed != 0 ? settings.seed : time(NULL));
+    cout << settings << endl;
     /* FIGURES */
     /*
         x -> left(-)-right(+)
@@ -132,13 +156,14 @@ Cylinder glassCylinder2(
     glassMaterial
 );
 
-    // Integración en el FigureCollection
-    FigureCollection figures(vector<Figure*>(
-        {
-            &leftPlane, &rightPlane, &ceilingPlane, &floorPlane, &backPlane, 
-            &leftSphere, &rightSphere
-        }
-    ));
+    // Integración en la SceneGeometry (guarda su propia copia de cada figura)
+    SceneGeometry figures;
+    for (Plane* plane : {&leftPlane, &rightPlane, &ceilingPlane, &floorPlane, &backPlane}){
+        figures.add(make_shared<Plane>(*plane));
+    }
+    for (Sphere* sphere : {&leftSphere, &rightSphere}){
+        figures.add(make_shared<Sphere>(*sphere));
+    }
 
     /*
     vector<shared_ptr<Point>> vertices = {
@@ -201,8 +226,8 @@ Cylinder glassCylinder2(
     Vector cameraLeftVector(-1, 0, 0);
     Vector cameraUpVector(0, 1, 0);
     Vector cameraForwardVector(0, 0, 3);
-    size_t width = IMAGE_WIDTH;
-    size_t height = IMAGE_WIDTH;
+    size_t width = settings.width;
+    size_t height = settings.height;
     Camera camera(cameraUpVector, cameraLeftVector, cameraForwardVector, cameraOrigin);
     camera.setHeight(height);
     camera.setWidth(width);
@@ -222,22 +247,75 @@ Cylinder glassCylinder2(
     glassCylinder1.setVisible(false);
     glassCylinder2.setVisible(false);
     PPM image;
-    
-    {
-        ScopedTimer timer("Render Timer");
-        image = camera.render(figures, lights);
+
+    // Escena desde fichero en lugar de la definida aqui
+    unique_ptr<Scene> loadedScene;
+    const SceneGeometry* sceneFigures = &figures;
+    const vector<shared_ptr<Light>>* sceneLights = &lights;
+    Camera* sceneCamera = &camera;
+    if(!sceneFile.empty()){
+        try{
+            ScopedTimer timer("Scene Load Timer");
+            loadedScene = loadScene(sceneFile, settings.threads);
+        }catch(const std::exception& e){
+            cerr << e.what() << endl;
+            return 1;
+        }
+        loadedScene->camera.setWidth(width);
+        loadedScene->camera.setHeight(height);
+        sceneFigures = &loadedScene->figures;
+        sceneLights = &loadedScene->lights;
+        sceneCamera = &loadedScene->camera;
     }
 
-    gammaAndClamping(image, 2.2, 1);
-    image.save();
+    // Mapa de fotones: se carga de fichero si se pasa como argumento,
+    // si no se genera y se guarda para poder reutilizarlo en otra ejecucion
+    PhotonMap photonMap;
+    double photonMapSeconds = 0, renderSeconds = 0;
+    resetStats();
+    const bool pipelined = photonMapFile.empty() && settings.pipelined && !settings.wavefront;
+    if(!photonMapFile.empty()){
+        ScopedTimer timer("PhotonMap Load Timer", photonMapSeconds);
+        photonMap = loadPhotonMap(photonMapFile);
+    }else if(pipelined){
+        // El mapa se construye a la vez que el G-buffer de camara
+        {
+            ScopedTimer timer("Render Timer", renderSeconds);
+            image = sceneCamera->renderPipelined(*sceneFigures, *sceneLights, photonMap, settings, &photonMapSeconds);
+        }
+        savePhotonMap(photonMap, "photonmap.bin");
+    }else{
+        {
+            ScopedTimer timer("PhotonMap Generation Timer", photonMapSeconds);
+            photonMap = sceneCamera->generatePhotonMap(*sceneFigures, *sceneLights, settings);
+        }
+        savePhotonMap(photonMap, "photonmap.bin");
+    }
+
+    if(!pipelined){
+        ScopedTimer timer("Render Timer", renderSeconds);
+        image = sceneCamera->render(*sceneFigures, *sceneLights, photonMap, settings);
+    }
+    // El tone mapping y el guardado se hacen en otro hilo mientras se escriben las estadisticas
+    OutputWriter writer(toneMapping, settings.threads, settings.writeQueue);
+    future<OutputWriter::Result> output = writer.submit(move(image), "out.ppm");
+    saveStatsJson(collectStats(), photonMapSeconds, renderSeconds);
+    try{
+        output.get();
+    }catch(const std::exception& e){
+        cerr << e.what() << endl;
+        return 1;
+    }
     
     cout << "Done." << endl;
     
+#ifdef _WIN32
     try{
         system("\"C:/Program Files/GIMP 3/bin/gimp-3.0.exe\" out.ppm");
     }catch(const std::exception& e){
         cerr << "Error opening GIMP: " << e.what() << endl;
     }
+#endif
 
     return 0;
 }   
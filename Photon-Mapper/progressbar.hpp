@@ -76,8 +76,8 @@ class progressbar {
       inline void set_output_stream(const std::ostream& stream) {output.rdbuf(stream.rdbuf());}
       // main function
       inline void update();
-      void setProgress(int done, int total);
-      void finish();
+      inline void setProgress(int done, int total);
+      inline void finish();
 
 
     private:
@@ -205,7 +205,7 @@ inline void progressbar::update() {
  * @param done Número de elementos completados.
  * @param total Número total de elementos a completar.
  */
-void progressbar::setProgress(int done, int total) {
+inline void progressbar::setProgress(int done, int total) {
     std::lock_guard<std::mutex> lock(mtx);
 
     // Calcula porcentaje [0..100]
@@ -233,7 +233,7 @@ void progressbar::setProgress(int done, int total) {
 }
 
 
-void progressbar::finish() {
+inline void progressbar::finish() {
   std::lock_guard<std::mutex> lock(mtx);
   std::cout << '\n';
 }
@@ -9,10 +9,10 @@ class Matrix{
 private:
     double mat[4][4];    
 public:
-    Matrix();
-    ~Matrix();
-    double* operator[](std::size_t idx ){ return mat[idx]; }
-    const double* operator[](std::size_t idx ) const{ return mat[idx]; }
+    // Matriz de ceros; constexpr para poder construir transformaciones en compilacion
+    constexpr Matrix() : mat{} {}
+    constexpr double* operator[](std::size_t idx ){ return mat[idx]; }
+    constexpr const double* operator[](std::size_t idx ) const{ return mat[idx]; }
     friend std::ostream& operator<<(std::ostream& os, const Matrix &m);
     friend std::shared_ptr<Matrix> operator*(const Matrix& m1, const Matrix& m2);
     friend std::shared_ptr<Matrix> operator*(const Matrix& m, const double c);
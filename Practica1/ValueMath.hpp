@@ -0,0 +1,172 @@
+#ifndef VALUEMATH_HPP
+#define VALUEMATH_HPP
+
+#include <cstddef>
+#include "Matrix.hpp"
+#include "Coordinate.hpp"
+#include "Point.hpp"
+#include "Vector.hpp"
+
+// Equivalentes por valor de las operaciones de Matrix, Coordinate, Point y
+// Vector: devuelven el resultado en la pila en vez de un shared_ptr, asi que
+// no reservan memoria, y son constexpr salvo las que usan sin, cos o sqrt
+// (no son constexpr en C++17).
+//     Matrix m = value::multiply(value::translation(4, 5, 2), value::scale(3, 4, 5));
+//     Point q = value::apply(m, p);
+// Los operadores antiguos siguen existiendo y ahora se implementan con estas.
+namespace value{
+
+constexpr Matrix identity(){
+    Matrix m;
+    m[0][0] = 1;
+    m[1][1] = 1;
+    m[2][2] = 1;
+    m[3][3] = 1;
+    return m;
+}
+
+constexpr Matrix translation(double x, double y, double z){
+    Matrix m = identity();
+    m[0][3] = x;
+    m[1][3] = y;
+    m[2][3] = z;
+    return m;
+}
+
+constexpr Matrix scale(double x, double y, double z){
+    Matrix m = identity();
+    m[0][0] = x;
+    m[1][1] = y;
+    m[2][2] = z;
+    return m;
+}
+
+Matrix rotationX(double angle);
+Matrix rotationY(double angle);
+Matrix rotationZ(double angle);
+
+constexpr Matrix baseChange(const Coordinate& origin, const Coordinate& u, const Coordinate& v, const Coordinate& w){
+    Matrix m = identity();
+    const Coordinate* axes[3] = {&u, &v, &w};
+    for (std::size_t j = 0; j < 3; j++){
+        m[0][j] = axes[j]->getX();
+        m[1][j] = axes[j]->getY();
+        m[2][j] = axes[j]->getZ();
+    }
+    m[0][3] = origin.getX();
+    m[1][3] = origin.getY();
+    m[2][3] = origin.getZ();
+    return m;
+}
+
+constexpr Matrix multiply(const Matrix& m1, const Matrix& m2){
+    Matrix result;
+    for (std::size_t i = 0; i < 4; i++){
+        for (std::size_t j = 0; j < 4; j++){
+            for (std::size_t k = 0; k < 4; k++){
+                result[i][j] += m1[i][k] * m2[k][j];
+            }
+        }
+    }
+    return result;
+}
+
+constexpr Matrix multiply(const Matrix& m, double c){
+    Matrix result;
+    for (std::size_t i = 0; i < 4; i++){
+        for (std::size_t j = 0; j < 4; j++){
+            result[i][j] = m[i][j] * c;
+        }
+    }
+    return result;
+}
+
+constexpr Coordinate apply(const Matrix& m, const Coordinate& c){
+    double in[4] = {c.getX(), c.getY(), c.getZ(), c.getW()};
+    double out[4] = {0, 0, 0, 0};
+    for (std::size_t i = 0; i < 4; i++){
+        for (std::size_t k = 0; k < 4; k++){
+            out[i] += m[i][k] * in[k];
+        }
+    }
+    return Coordinate(out[0], out[1], out[2], out[3]);
+}
+
+// Sin la fila de abajo: un punto sigue siendo punto y un vector, vector
+constexpr Point apply(const Matrix& m, const Point& p){
+    return Point(m[0][0] * p.getX() + m[0][1] * p.getY() + m[0][2] * p.getZ() + m[0][3],
+                 m[1][0] * p.getX() + m[1][1] * p.getY() + m[1][2] * p.getZ() + m[1][3],
+                 m[2][0] * p.getX() + m[2][1] * p.getY() + m[2][2] * p.getZ() + m[2][3]);
+}
+
+constexpr Vector apply(const Matrix& m, const Vector& v){
+    return Vector(m[0][0] * v.getX() + m[0][1] * v.getY() + m[0][2] * v.getZ(),
+                  m[1][0] * v.getX() + m[1][1] * v.getY() + m[1][2] * v.getZ(),
+                  m[2][0] * v.getX() + m[2][1] * v.getY() + m[2][2] * v.getZ());
+}
+
+constexpr Vector subtract(const Point& p1, const Point& p2){
+    return Vector(p1.getX() - p2.getX(), p1.getY() - p2.getY(), p1.getZ() - p2.getZ());
+}
+
+constexpr Point add(const Point& p, double s){
+    return Point(p.getX() + s, p.getY() + s, p.getZ() + s);
+}
+
+constexpr Vector add(const Vector& v1, const Vector& v2){
+    return Vector(v1.getX() + v2.getX(), v1.getY() + v2.getY(), v1.getZ() + v2.getZ());
+}
+
+constexpr Vector subtract(const Vector& v1, const Vector& v2){
+    return Vector(v1.getX() - v2.getX(), v1.getY() - v2.getY(), v1.getZ() - v2.getZ());
+}
+
+constexpr Vector multiply(const Vector& v, double s){
+    return Vector(v.getX() * s, v.getY() * s, v.getZ() * s);
+}
+
+constexpr Vector divide(const Vector& v, double s){
+    return Vector(v.getX() / s, v.getY() / s, v.getZ() / s);
+}
+
+constexpr Vector crossProduct(const Vector& v1, const Vector& v2){
+    return Vector(v1.getY() * v2.getZ() - v1.getZ() * v2.getY(),
+                  v1.getZ() * v2.getX() - v1.getX() * v2.getZ(),
+                  v1.getX() * v2.getY() - v1.getY() * v2.getX());
+}
+
+// En double (::dotProduct devuelve int32_t y trunca)
+constexpr double dotProduct(const Vector& v1, const Vector& v2){
+    return v1.getX() * v2.getX() + v1.getY() * v2.getY() + v1.getZ() * v2.getZ();
+}
+
+Vector normalize(const Vector& v);
+
+// Cadena de transformaciones compuesta una sola vez y aplicada a lotes de
+// puntos: then(m) añade m despues de las anteriores, asi
+//     Chain().then(rotationX(a)).then(scale(3, 4, 5)).then(translation(4, 5, 2))
+// equivale a translation * scale * rotationX. Aplicar la cadena a N puntos
+// cuesta una multiplicacion por punto, no una por matriz y punto.
+class Chain{
+private:
+    Matrix composed;
+public:
+    constexpr Chain() : composed(identity()) {}
+    constexpr explicit Chain(const Matrix& m) : composed(m) {}
+
+    constexpr Chain& then(const Matrix& m){
+        composed = multiply(m, composed);
+        return *this;
+    }
+    constexpr const Matrix& matrix() const { return composed; }
+
+    // in y out pueden ser el mismo array
+    void apply(const Point* in, Point* out, std::size_t count) const;
+    void apply(const Vector* in, Vector* out, std::size_t count) const;
+    // Puntos con un array por componente, transformados en su sitio
+    void apply(std::size_t count, double* x, double* y, double* z) const;
+};
+
+}
+
+#endif /* VALUEMATH_HPP */
@@ -1,35 +1,30 @@
 #include "Vector.hpp"
+#include "ValueMath.hpp"
 #include <math.h>
 
-Vector::~Vector(){
-    
-}
-
 std::ostream& operator<<(std::ostream& os, const Vector &v){
     os << "Vector(" << v.x << ", " << v.y << ", " << v.z << ")";
     return os;
 }
 
 std::shared_ptr<Vector> operator+(const Vector &v1, const Vector &v2){
-    return std::make_shared<Vector>(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z);
+    return std::make_shared<Vector>(value::add(v1, v2));
 }
 
 std::shared_ptr<Vector> operator-(const Vector &v1, const Vector &v2){
-    return std::make_shared<Vector>(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z);
+    return std::make_shared<Vector>(value::subtract(v1, v2));
 }
 
 std::shared_ptr<Vector> crossProduct(const Vector &v1, const Vector &v2){
-    return std::make_shared<Vector>((v1.y * v2.z - v1.z * v2.y),
-                      (v1.z * v2.x - v1.x * v2.z),
-                      (v1.x * v2.y - v1.y * v2.x));
+    return std::make_shared<Vector>(value::crossProduct(v1, v2));
 }
 
 int32_t dotProduct(const Vector &v1, const Vector &v2){
-    return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z);
+    return int32_t(value::dotProduct(v1, v2));
 }
 
 std::shared_ptr<Vector> operator*(const Vector &v, const int32_t s){
-    return std::make_shared<Vector>(v.x * s, v.y * s, v.z * s);
+    return std::make_shared<Vector>(value::multiply(v, s));
 }
 
 std::shared_ptr<Vector> operator*(const int32_t s, const Vector &v){
@@ -37,7 +32,7 @@ std::shared_ptr<Vector> operator*(const int32_t s, const Vector &v){
 }
 
 std::shared_ptr<Vector> operator/(const Vector &v, const double s){
-    return std::make_shared<Vector>(v.x / s, v.y / s, v.z / s);
+    return std::make_shared<Vector>(value::divide(v, s));
 }
 
 double module(const Vector &v){
@@ -49,7 +44,7 @@ double angle(const Vector &v1, const Vector &v2){
 }
 
 std::shared_ptr<Vector> normalize(const Vector &v){
-    return v/module(v);
+    return std::make_shared<Vector>(value::normalize(v));
 }
 
 
@@ -0,0 +1,162 @@
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <math.h>
+#include "ValueMath.hpp"
+
+// Compara los operadores que devuelven shared_ptr con los equivalentes por
+// valor de ValueMath.hpp: tiempo y reservas de memoria por operacion.
+// Compilacion (desde Practica1/):
+//     g++ --std=c++17 -O3 -DNDEBUG -I. bench/*.cpp $(ls *.cpp | grep -v main.cpp) -o bench.out
+// Uso:
+//     ./bench.out [--reps N] [--points N]
+
+using namespace std;
+
+// Contador global de reservas: cada new pasa por aqui
+static size_t allocations = 0;
+
+void* operator new(size_t size){
+    allocations++;
+    if(void* p = malloc(size == 0 ? 1 : size)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept{
+    free(p);
+}
+
+namespace {
+    template<typename T>
+    void doNotOptimize(const T& value){
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    struct Options{
+        size_t repetitions = 15;
+        size_t points = 1 << 20;
+    };
+
+    // Mediana de ns por operacion y reservas por operacion de la ultima repeticion
+    template<typename F>
+    void run(const Options& options, const string& name, size_t ops, const F& f){
+        f();
+        vector<double> samples;
+        size_t allocated = 0;
+        for (size_t i = 0; i < options.repetitions; i++){
+            size_t before = allocations;
+            auto start = chrono::steady_clock::now();
+            f();
+            auto end = chrono::steady_clock::now();
+            allocated = allocations - before;
+            samples.push_back(chrono::duration<double, nano>(end - start).count() / ops);
+        }
+        sort(samples.begin(), samples.end());
+        printf("%-46s %10.2f ns/op  %6.2f allocs/op\n", name.c_str(), samples[samples.size() / 2], double(allocated) / ops);
+    }
+}
+
+int main(int argc, char* argv[]){
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2){
+        string arg = argv[i];
+        if(arg == "--reps") options.repetitions = stoul(argv[i + 1]);
+        else if(arg == "--points") options.points = stoul(argv[i + 1]);
+        else{
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    const size_t OPS = 10000;
+    Point p(1, 2, 3);
+    Vector v(0, 2, 0);
+
+    /* OPERACIONES SUELTAS */
+    run(options, "shared_ptr: translation * scale * rotationX", OPS, [&]() {
+        for (size_t i = 0; i < OPS; i++){
+            Matrix m = *(*(*traslation(4, 5, 2) * *scale(3, 4, 5)) * *rotationX(M_PI));
+            doNotOptimize(m);
+        }
+    });
+    run(options, "value: translation * scale * rotationX", OPS, [&]() {
+        for (size_t i = 0; i < OPS; i++){
+            Matrix m = value::multiply(value::multiply(value::translation(4, 5, 2), value::scale(3, 4, 5)), value::rotationX(M_PI));
+            doNotOptimize(m);
+        }
+    });
+    Matrix m = value::multiply(value::translation(4, 5, 2), value::rotationX(0.3));
+    run(options, "shared_ptr: Matrix * Point", OPS, [&]() {
+        for (size_t i = 0; i < OPS; i++){
+            Coordinate c = *(m * p);
+            doNotOptimize(c);
+        }
+    });
+    run(options, "value: apply(Matrix, Point)", OPS, [&]() {
+        for (size_t i = 0; i < OPS; i++){
+            Point q = value::apply(m, p);
+            doNotOptimize(q);
+        }
+    });
+    run(options, "shared_ptr: normalize(v1 + v2)", OPS, [&]() {
+        for (size_t i = 0; i < OPS; i++){
+            Vector n = *normalize(*(v + Vector(1, 0, 0)));
+            doNotOptimize(n);
+        }
+    });
+    run(options, "value: normalize(add(v1, v2))", OPS, [&]() {
+        for (size_t i = 0; i < OPS; i++){
+            Vector n = value::normalize(value::add(v, Vector(1, 0, 0)));
+            doNotOptimize(n);
+        }
+    });
+
+    /* CADENAS SOBRE LOTES DE PUNTOS */
+    // Cadena de 4 transformaciones sobre options.points puntos
+    vector<Point> points(options.points), out(options.points);
+    vector<double> xs(options.points), ys(options.points), zs(options.points);
+    for (size_t i = 0; i < options.points; i++){
+        points[i] = Point(double(i % 101), double(i % 37), double(i % 13));
+        xs[i] = points[i].getX();
+        ys[i] = points[i].getY();
+        zs[i] = points[i].getZ();
+    }
+    Matrix chain[4] = {value::rotationX(0.3), value::scale(2, 2, 2), value::rotationY(0.5), value::translation(1, 2, 3)};
+    string suffix = " (" + to_string(options.points) + " points)";
+    run(options, "shared_ptr: chain per point" + suffix, options.points, [&]() {
+        for (size_t i = 0; i < options.points; i++){
+            shared_ptr<Coordinate> c = chain[0] * points[i];
+            for (size_t k = 1; k < 4; k++){
+                c = chain[k] * *c;
+            }
+            out[i] = Point(c->getX(), c->getY(), c->getZ());
+        }
+        doNotOptimize(out.data());
+    });
+    run(options, "value::Chain::apply Point[]" + suffix, options.points, [&]() {
+        value::Chain composed;
+        for (const Matrix& step : chain){
+            composed.then(step);
+        }
+        composed.apply(points.data(), out.data(), options.points);
+        doNotOptimize(out.data());
+    });
+    run(options, "value::Chain::apply x[], y[], z[]" + suffix, options.points, [&]() {
+        value::Chain composed;
+        for (const Matrix& step : chain){
+            composed.then(step);
+        }
+        composed.apply(options.points, xs.data(), ys.data(), zs.data());
+        doNotOptimize(xs.data());
+    });
+    return 0;
+}
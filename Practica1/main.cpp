@@ -5,6 +5,7 @@
 #include "Point.hpp"
 #include "Coordinate.hpp"
 #include "Matrix.hpp"
+#include "ValueMath.hpp"
 using namespace std;
 
 int main(){
@@ -13,15 +14,17 @@ int main(){
     Vector v1 = Vector(1,0,0);
     Vector v2 = Vector(0,2,0);
     
-    Matrix m1 = (*(*(*traslation(4,5,2) * *scale(3,4,5)) * *rotationX(M_PI)));
+    // Traslacion y escala se componen en compilacion
+    constexpr Matrix translateScale = value::multiply(value::translation(4, 5, 2), value::scale(3, 4, 5));
+    Matrix m1 = value::multiply(translateScale, value::rotationX(M_PI));
 
-    cout << *(m1 * p1) << endl;
+    cout << value::apply(m1, Coordinate(p1)) << endl;
 
     cout << (Coordinate)p1 <<endl;
     cout << p2 <<endl;
     cout << v1 << endl;
-    cout << *(2+p1) <<endl;
+    cout << value::add(p1, 2) <<endl;
     cout << *(p1+2) <<endl;
-    cout << *normalize(v2) << endl;
+    cout << value::normalize(v2) << endl;
 
-}
\ No newline at end of file
+}
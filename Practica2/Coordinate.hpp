@@ -10,9 +10,12 @@ private:
 protected:
     double x, y, z, w;
 public:
-    Coordinate(double x, double y, double z, double w);
+    constexpr Coordinate(double x, double y, double z, double w) : x(x), y(y), z(z), w(w) {}
     Coordinate() = default;
-    ~Coordinate();
+    constexpr double getX() const { return x; }
+    constexpr double getY() const { return y; }
+    constexpr double getZ() const { return z; }
+    constexpr double getW() const { return w; }
     friend std::ostream& operator<<(std::ostream& os, const Coordinate &c);
     friend std::shared_ptr<Matrix> baseChange(const Coordinate& origin, const Coordinate& u, const Coordinate& v, const Coordinate& w);
     friend std::shared_ptr<Coordinate> operator*(const Matrix& m, const Coordinate& c);
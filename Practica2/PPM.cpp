@@ -43,19 +43,10 @@ void PPM::load(const std::string& fileName){
 		inFile >> this->maxColorValue;
 
 		double r, g, b;
-		this->pixels = std::vector<std::vector<std::shared_ptr<Pixel>>>(this->height);
-		for (int32_t i = 0; i < this->height; i++){
-			this->pixels[i] = std::vector<std::shared_ptr<Pixel>>(this->width);
-			for (int32_t j = 0; j < this->width; j++){
-				inFile >> r >> g >> b;
-				this->pixels[i][j] = std::make_shared<Pixel>(
-										Pixel{
-											toMemoryValue(r),
-											toMemoryValue(g),
-											toMemoryValue(b),
-										}
-									);
-			}
+		this->pixels = std::vector<Pixel>(size_t(this->height) * this->width);
+		for (Pixel& pixel : this->pixels){
+			inFile >> r >> g >> b;
+			pixel = Pixel{toMemoryValue(r), toMemoryValue(g), toMemoryValue(b)};
 		}
 
 	} else{
@@ -77,7 +68,7 @@ void PPM::save(const std::string& fileName){
 		//outFile << std::fixed;
 		for (int32_t i = 0; i < this->height; i++){
 			for (int32_t j = 0; j < this->width; j++){
-				Pixel p = *pixels[i][j].get();
+				const Pixel& p = (*this)[i][j];
 				outFile << toFileValue(p.r) << " " << toFileValue(p.g) << " " << toFileValue(p.b) << '\t';
 			}
 			outFile << std::endl;
@@ -5,17 +5,17 @@
 #include <vector>
 
 class PPM{
+public:
+    struct Pixel{
+        double r, g, b;
+    };
 private:    
     std::string fileName;
     std::string version;
     double realMaxColorValue;
     int32_t height, width;
     int32_t maxColorValue;
-    struct Pixel{
-        double r, g, b;
-    };
-    
-    std::vector<std::vector<std::shared_ptr<Pixel>>> pixels;
+    std::vector<Pixel> pixels;      // fila a fila, contiguos
 
 private:
     double toMemoryValue(double s);
@@ -28,16 +28,20 @@ public:
 
     void load(const std::string& fileName);
     void save(const std::string& fileName = "out.ppm");
-    std::vector<std::shared_ptr<Pixel>>& operator[](std::size_t idx){ return pixels[idx]; }
-    const std::vector<std::shared_ptr<Pixel>>& operator[](std::size_t idx) const{ return pixels[idx]; }
+    int32_t getWidth() const { return width; }
+    int32_t getHeight() const { return height; }
+    // Fila idx: image[y][x]
+    Pixel* operator[](std::size_t idx){ return pixels.data() + idx * width; }
+    const Pixel* operator[](std::size_t idx) const{ return pixels.data() + idx * width; }
+    // Canales r g b de todos los pixeles seguidos (3 * width * height valores)
+    double* data(){ return reinterpret_cast<double*>(pixels.data()); }
+    const double* data() const{ return reinterpret_cast<const double*>(pixels.data()); }
     friend std::ostream& operator<<(std::ostream& os, const PPM& image);
 
-    friend void clamping(PPM& image, double clampValue);
-    friend void equalization(PPM& image);
-    friend void equalizationAndClamping(PPM& image, const double clampValue);
-    friend void gamma(PPM& image, double gammaValue);
-    friend void gammaAndClamping(PPM& image, double gammaValue, double clampValue);  
+    friend class ToneMappingPipeline;
 };
 
 
+static_assert(sizeof(PPM::Pixel) == 3 * sizeof(double), "PPM::Pixel must be three packed doubles");
+
 #endif /*PPM_HPP*/
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "PPMStream.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+    const std::string MAX = "#MAX=";
+    // Ningun numero o linea de cabecera util es mas largo que esto
+    const size_t MAX_TOKEN = 256;
+
+    inline bool isSpace(char c){
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+}
+
+PPMReader::PPMReader(const std::string& fileName, size_t bufferSize)
+    : file(fileName, std::ios::binary), fileName(fileName), buffer(std::max(bufferSize, 4 * MAX_TOKEN)) {
+    if(!file.is_open()){
+        throw std::runtime_error("Cannot open " + fileName);
+    }
+    fill();
+
+    skipSpaces();
+    if(end - pos < 2 || buffer[pos] != 'P' || buffer[pos + 1] != '3'){
+        throw std::runtime_error(fileName + ": not a P3 PPM file");
+    }
+    pos += 2;
+
+    // Comentarios; "#MAX=" da el valor real del maximo
+    while(skipSpaces() && buffer[pos] == '#'){
+        const char* start = buffer.data() + pos;
+        const char* newline = static_cast<const char*>(memchr(start, '\n', end - pos));
+        size_t length = newline ? size_t(newline - start) : end - pos;
+        if(length >= MAX.size() && std::string(start, MAX.size()) == MAX){
+            double value = 0;
+            std::from_chars_result result = std::from_chars(start + MAX.size(), start + length, value);
+            if(result.ec != std::errc() || value <= 0){
+                throw std::runtime_error(fileName + ": invalid " + MAX + " comment");
+            }
+            realMaxColorValue = value;
+        }
+        // Comentario mas largo que lo que queda en el buffer: seguir hasta el salto de linea
+        while(!newline && !eof){
+            pos = end;
+            fill();
+            newline = static_cast<const char*>(memchr(buffer.data() + pos, '\n', end - pos));
+            length = newline ? size_t(newline - (buffer.data() + pos)) : end - pos;
+        }
+        pos += newline ? length + 1 : length;
+    }
+
+    width = int32_t(readNumber());
+    height = int32_t(readNumber());
+    maxColorValue = readNumber();
+    if(width <= 0 || height <= 0 || maxColorValue <= 0){
+        throw std::runtime_error(fileName + ": invalid PPM header");
+    }
+    scale = realMaxColorValue / maxColorValue;
+}
+
+// Mueve lo pendiente al principio y completa el buffer desde el fichero
+void PPMReader::fill(){
+    if(eof) return;
+    if(pos > 0){
+        memmove(buffer.data(), buffer.data() + pos, end - pos);
+        end -= pos;
+        pos = 0;
+    }
+    file.read(buffer.data() + end, buffer.size() - end);
+    end += size_t(file.gcount());
+    if(!file){
+        eof = true;
+    }
+}
+
+// Salta espacios; false si se acaba el fichero. Deja al menos MAX_TOKEN bytes por delante si los hay
+bool PPMReader::skipSpaces(){
+    while(true){
+        while(pos < end && isSpace(buffer[pos])) pos++;
+        if(end - pos < MAX_TOKEN && !eof){
+            fill();
+            continue;
+        }
+        return pos < end;
+    }
+}
+
+double PPMReader::readNumber(){
+    if(!skipSpaces()){
+        throw std::runtime_error(fileName + ": unexpected end of file");
+    }
+    double value = 0;
+    std::from_chars_result result = std::from_chars(buffer.data() + pos, buffer.data() + end, value);
+    if(result.ec != std::errc()){
+        throw std::runtime_error(fileName + ": invalid number");
+    }
+    pos = result.ptr - buffer.data();
+    return value;
+}
+
+void PPMReader::readRow(double* rgb){
+    if(rowsRead >= height){
+        throw std::runtime_error(fileName + ": reading past the last row");
+    }
+    for (int32_t i = 0; i < 3 * width; i++){
+        rgb[i] = readNumber() * scale;
+    }
+    rowsRead++;
+}
+
+PPMWriter::PPMWriter(const std::string& fileName, int32_t width, int32_t height, double realMaxColorValue, double maxColorValue)
+    : fileName(fileName), tempName(fileName + ".tmp"), width(width), maxColorValue(maxColorValue), scale(maxColorValue / realMaxColorValue) {
+    file.open(tempName, std::ios::binary);
+    if(!file.is_open()){
+        throw std::runtime_error("Cannot create " + fileName);
+    }
+    file << "P3\n" << MAX << realMaxColorValue << "\n" << width << ' ' << height << "\n" << maxColorValue << "\n";
+    // Hasta 3 numeros de ~14 caracteres por pixel
+    line.resize(size_t(width) * 3 * 16 + 2);
+}
+
+void PPMWriter::writeRow(const double* rgb){
+    char* out = line.data();
+    char* last = line.data() + line.size();
+    for (int32_t i = 0; i < 3 * width; i++){
+        // Mismo formato que operator<< por defecto (6 cifras significativas)
+        out = std::to_chars(out, last, rgb[i] * scale, std::chars_format::general, 6).ptr;
+        *out++ = (i % 3 == 2) ? '\t' : ' ';
+    }
+    *out++ = '\n';
+    file.write(line.data(), out - line.data());
+    if(!file){
+        throw std::runtime_error("Error writing " + fileName);
+    }
+}
+
+PPMWriter::~PPMWriter(){
+    if(!closed){
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(tempName, error);
+    }
+}
+
+void PPMWriter::close(){
+    file.close();
+    if(file.fail()){
+        throw std::runtime_error("Error writing " + fileName);
+    }
+    // Reemplaza la salida anterior si la hay (tambien en Windows)
+    std::error_code error;
+    std::filesystem::rename(tempName, fileName, error);
+    if(error){
+        throw std::runtime_error("Cannot create " + fileName + ": " + error.message());
+    }
+    closed = true;
+}
@@ -0,0 +1,59 @@
+#ifndef PPM_STREAM_HPP
+#define PPM_STREAM_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Lectura de un PPM (P3) fila a fila con un buffer de tamaño fijo: la memoria
+// no depende del tamaño de la imagen. Los valores se devuelven en memoria
+// (escalados por #MAX igual que PPM::load).
+class PPMReader{
+private:
+    std::ifstream file;
+    std::string fileName;
+    std::vector<char> buffer;
+    size_t pos = 0, end = 0;
+    bool eof = false;
+    int32_t width = 0, height = 0;
+    double realMaxColorValue = 1.0;
+    double maxColorValue = 255.0;
+    double scale = 1.0;
+    int32_t rowsRead = 0;
+
+    void fill();
+    bool skipSpaces();
+    double readNumber();
+public:
+    PPMReader(const std::string& fileName, size_t bufferSize = 1 << 20);
+    int32_t getWidth() const { return width; }
+    int32_t getHeight() const { return height; }
+    double getRealMaxColorValue() const { return realMaxColorValue; }
+    // rgb: 3 * width valores
+    void readRow(double* rgb);
+};
+
+// Escritura de un PPM (P3) fila a fila. Se escribe en fileName + ".tmp" y
+// close() lo renombra: si la conversion falla no queda un fichero a medias
+// (el destructor borra el temporal) y una salida anterior no se pierde.
+// Los errores de lectura y escritura ya llevan el nombre del fichero.
+class PPMWriter{
+private:
+    std::ofstream file;
+    std::string fileName;
+    std::string tempName;
+    bool closed = false;
+    std::vector<char> line;
+    int32_t width;
+    double maxColorValue;
+    double scale;
+public:
+    PPMWriter(const std::string& fileName, int32_t width, int32_t height, double realMaxColorValue, double maxColorValue = 255);
+    ~PPMWriter();
+    // rgb: 3 * width valores en [0, realMaxColorValue]
+    void writeRow(const double* rgb);
+    void close();
+};
+
+#endif /* PPM_STREAM_HPP */
@@ -1,19 +1,18 @@
 #include "Point.hpp"
+#include "ValueMath.hpp"
+
 
 std::ostream& operator<<(std::ostream& os, const Point &p){
     os << "Point(" << p.x << ", " << p.y << ", " << p.z << ")";
     return os;
 }
 
-Point::~Point(){
-}
-
 std::shared_ptr<Vector> operator-(Point const &p1, Point const &p2){
-    return std::make_shared<Vector>(p1.x-p2.x, p1.y-p2.y, p1.z-p2.z);
+    return std::make_shared<Vector>(value::subtract(p1, p2));
 }
 
 std::shared_ptr<Point> operator+(int32_t const s, Point const &p){
-    return std::make_shared<Point>(s+p.x, s+p.y, s+p.z);
+    return std::make_shared<Point>(value::add(p, s));
 }
 
 std::shared_ptr<Point> operator+(Point const &p, int32_t const s){
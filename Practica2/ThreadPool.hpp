@@ -0,0 +1,70 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <queue>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <algorithm>
+
+// ThreadPool para paralelizar trabajos
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    bool stop = false;
+
+public:
+    ThreadPool(size_t numThreads);
+
+    template<class F, class... Args>
+    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
+        using returnType = typename std::result_of<F(Args...)>::type;
+
+        auto task = std::make_shared<std::packaged_task<returnType()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+        );
+
+        std::future<returnType> res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            if (stop)
+                throw std::runtime_error("enqueue on stopped ThreadPool");
+            tasks.emplace([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return res;
+    }
+
+    ~ThreadPool();
+
+};
+
+// Ejecuta f(i) para i en [0, n) repartido entre threads hilos (0 -> todos los nucleos)
+template<class F>
+void parallelFor(size_t n, size_t threads, const F& f){
+    if(threads == 0){
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(n <= 1 || threads <= 1){
+        for (size_t i = 0; i < n; i++) f(i);
+        return;
+    }
+    ThreadPool pool(std::min(n, threads));
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < n; i++){
+        futures.emplace_back(pool.enqueue([&f, i]() { f(i); }));
+    }
+    for (auto& future : futures){
+        future.get();
+    }
+}
+
+#endif /* THREADPOOL_HPP */
\ No newline at end of file
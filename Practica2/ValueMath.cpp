@@ -0,0 +1,63 @@
+#include "ValueMath.hpp"
+#include <math.h>
+
+namespace value{
+
+Matrix rotationX(double angle){
+    Matrix m = identity();
+    m[1][1] = cos(angle);
+    m[1][2] = -sin(angle);
+    m[2][1] = sin(angle);
+    m[2][2] = cos(angle);
+    return m;
+}
+
+Matrix rotationY(double angle){
+    Matrix m = identity();
+    m[0][0] = cos(angle);
+    m[0][2] = sin(angle);
+    m[2][0] = -sin(angle);
+    m[2][2] = cos(angle);
+    return m;
+}
+
+Matrix rotationZ(double angle){
+    Matrix m = identity();
+    m[0][0] = cos(angle);
+    m[0][1] = -sin(angle);
+    m[1][0] = sin(angle);
+    m[1][1] = cos(angle);
+    return m;
+}
+
+Vector normalize(const Vector& v){
+    return divide(v, sqrt(value::dotProduct(v, v)));
+}
+
+void Chain::apply(const Point* in, Point* out, std::size_t count) const{
+    for (std::size_t i = 0; i < count; i++){
+        out[i] = value::apply(composed, in[i]);
+    }
+}
+
+void Chain::apply(const Vector* in, Vector* out, std::size_t count) const{
+    for (std::size_t i = 0; i < count; i++){
+        out[i] = value::apply(composed, in[i]);
+    }
+}
+
+void Chain::apply(std::size_t count, double* x, double* y, double* z) const{
+    const Matrix& m = composed;
+    // Un coeficiente por variable: el compilador vectoriza el bucle
+    const double m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
+    const double m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
+    const double m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
+    for (std::size_t i = 0; i < count; i++){
+        double px = x[i], py = y[i], pz = z[i];
+        x[i] = m00 * px + m01 * py + m02 * pz + m03;
+        y[i] = m10 * px + m11 * py + m12 * pz + m13;
+        z[i] = m20 * px + m21 * py + m22 * pz + m23;
+    }
+}
+
+}
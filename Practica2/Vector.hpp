@@ -18,9 +18,8 @@ class Vector: public Coordinate{
 private:
 
 public:
-    Vector(double x, double y, double z) : Coordinate(x, y, z, 0.0){};
-    ~Vector();
-    Vector();
+    constexpr Vector(double x, double y, double z) : Coordinate(x, y, z, 0.0){};
+    Vector() = default;
     friend std::ostream& operator<<(std::ostream& os, const Vector &v);
     friend std::shared_ptr<Vector> operator+(const Vector &v1, const Vector &v2);
     friend std::shared_ptr<Vector> operator-(const Vector &v1, const Vector &v2);
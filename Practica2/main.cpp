@@ -1,61 +1,184 @@
 #include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <memory>
-#include <math.h>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
-#include "Vector.hpp"
-#include "Point.hpp"
-#include "Coordinate.hpp"
-#include "Matrix.hpp"
-#include "PPM.hpp"
+#include "PPMStream.hpp"
 #include "ToneMapping.hpp"
+#include "ThreadPool.hpp"
 using namespace std;
+namespace fs = std::filesystem;
 
-const vector<string> files = vector<string>({
-    /*
-    */
-    "../files/seymour_park.ppm",
-    "../files/nancy_church_3.ppm",
-    "../files/nancy_church_1.ppm",
-    "../files/mpi_atrium_3.ppm",
-    "../files/forest_path.ppm",
-    "../files/mpi_atrium_1.ppm",
-    "../files/nancy_church_2.ppm",
-    "../files/mpi_office.ppm"
-});
-
-void foo(string file, int i){
-    PPM image(file);
-    cout << image << endl;
-    //equalization(image);
-    //equalizationAndClamping(image, 100);
-    //clamping(image);
-    //gamma(image,2);
-    gammaAndClamping(image,2,1.0);
-    cout << image << endl;
-    image.save("out_" + to_string(i) + ".ppm");
+// Conversion por lotes de imagenes HDR (PPM con #MAX) a LDR.
+// Cada trabajo lee, aplica el tone mapping y escribe fila a fila, asi que la
+// memoria por trabajo es constante; como mucho hay --jobs trabajos a la vez.
+// Uso:
+//     ./main.out [opciones] [fichero|directorio|patron]...
+//     ./main.out --jobs 4 --tonemap reinhard:4,gamma:2.2 --output out ../files
+//     ./main.out "../files/nancy_*.ppm"
+
+struct BatchOptions{
+    vector<string> inputs;
+    string outputDir = ".";
+    string prefix = "out_";
+    string toneMapping = "clamp:1,gamma:2";
+    size_t jobs = 0;                // 0 -> todos los nucleos
+};
+
+void usage(){
+    cout << "Uso: main.out [opciones] [fichero|directorio|patron]... (../files por defecto)" << endl
+         << "  --output DIR       directorio de salida (.)" << endl
+         << "  --prefix TEXTO     prefijo de los ficheros de salida (out_)" << endl
+         << "  --jobs N           imagenes convertidas a la vez (todos los nucleos)" << endl
+         << "  --tonemap LISTA    operadores: exposure:p, clamp:v, equalize, gamma:g," << endl
+         << "                     reinhard:w, aces:e (clamp:1,gamma:2)" << endl;
 }
 
-int main(){
-    thread threads[files.size()];
-    for (size_t i = 0; i < files.size(); i++)
-    {
-        /*
-        PPM image(files[i]);
-        cout << image << endl;
-        //equalization(image);
-        //equalizationAndClamping(image, 100);
-        //clamping(image);
-        //gamma(image,2);
-        gammaAndClamping(image,2,1.0);
-        cout << image << endl;
-        image.save("out_" + to_string(i) + ".ppm");
-        */
-       threads[i] = thread(foo,files[i],i);
+// '*' y '?' sobre el nombre del fichero
+bool wildcardMatch(const char* pattern, const char* name){
+    if(*pattern == '\0') return *name == '\0';
+    if(*pattern == '*'){
+        return wildcardMatch(pattern + 1, name) || (*name != '\0' && wildcardMatch(pattern, name + 1));
+    }
+    if(*name == '\0') return false;
+    return (*pattern == '?' || *pattern == *name) && wildcardMatch(pattern + 1, name + 1);
+}
+
+bool isPPM(const fs::path& path){
+    return fs::is_regular_file(path) && path.extension() == ".ppm";
+}
+
+// Directorio -> sus .ppm; patron -> los ficheros que encajan; fichero -> el mismo
+vector<string> expandInputs(const vector<string>& inputs){
+    vector<string> files;
+    for (const string& input : inputs){
+        fs::path path(input);
+        if(input.find_first_of("*?") != string::npos){
+            fs::path dir = path.has_parent_path() ? path.parent_path() : fs::path(".");
+            string pattern = path.filename().string();
+            vector<string> matches;
+            for (const auto& entry : fs::directory_iterator(dir)){
+                if(entry.is_regular_file() && wildcardMatch(pattern.c_str(), entry.path().filename().string().c_str())){
+                    matches.push_back(entry.path().string());
+                }
+            }
+            if(matches.empty()) throw runtime_error("No files match " + input);
+            sort(matches.begin(), matches.end());
+            files.insert(files.end(), matches.begin(), matches.end());
+        }else if(fs::is_directory(path)){
+            vector<string> entries;
+            for (const auto& entry : fs::directory_iterator(path)){
+                if(isPPM(entry.path())) entries.push_back(entry.path().string());
+            }
+            sort(entries.begin(), entries.end());
+            files.insert(files.end(), entries.begin(), entries.end());
+        }else if(fs::exists(path)){
+            files.push_back(input);
+        }else{
+            throw runtime_error("No such file or directory: " + input);
+        }
+    }
+    return files;
+}
+
+BatchOptions parseOptions(int argc, char* argv[]){
+    BatchOptions options;
+    for (int i = 1; i < argc; i++){
+        string arg = argv[i];
+        auto next = [&]() -> string {
+            if(i + 1 >= argc) throw runtime_error("Missing value for " + arg);
+            return argv[++i];
+        };
+        if(arg == "--output") options.outputDir = next();
+        else if(arg == "--prefix") options.prefix = next();
+        else if(arg == "--jobs") options.jobs = stoul(next());
+        else if(arg == "--tonemap") options.toneMapping = next();
+        else if(arg == "--help" || arg == "-h"){
+            usage();
+            exit(0);
+        }else if(arg.rfind("--", 0) == 0) throw runtime_error("Unknown option: " + arg);
+        else options.inputs.push_back(arg);
     }
-    for (size_t i = 0; i < files.size(); i++)
+    if(options.inputs.empty()){
+        options.inputs.push_back("../files");
+    }
+    return options;
+}
+
+// Lee, mapea y escribe fila a fila; devuelve los bytes leidos
+uintmax_t convert(const string& input, const string& output, const ToneMappingPipeline& pipeline){
+    PPMReader reader(input);
+    vector<double> row(3 * size_t(reader.getWidth()));
+    // El maximo de salida solo depende de los operadores, se conoce antes de la primera fila
+    PPMWriter writer(output, reader.getWidth(), reader.getHeight(), pipeline.outputMax(reader.getRealMaxColorValue()));
+    for (int32_t y = 0; y < reader.getHeight(); y++){
+        reader.readRow(row.data());
+        pipeline.apply(row.data(), row.size(), reader.getRealMaxColorValue(), 1);
+        writer.writeRow(row.data());
+    }
+    writer.close();
+    return fs::file_size(input);
+}
+
+int main(int argc, char* argv[]){
+    BatchOptions options;
+    vector<string> files;
+    ToneMappingPipeline pipeline;
+    try{
+        options = parseOptions(argc, argv);
+        pipeline = ToneMappingPipeline::parse(options.toneMapping);
+        files = expandInputs(options.inputs);
+        fs::create_directories(options.outputDir);
+    }catch(const exception& e){
+        cerr << e.what() << endl;
+        usage();
+        return 1;
+    }
+
+    size_t jobs = options.jobs > 0 ? options.jobs : max(1u, thread::hardware_concurrency());
+    cout << files.size() << " images, " << jobs << " jobs, tonemap " << pipeline.toString() << endl;
+
+    mutex outputMutex;
+    atomic<uintmax_t> totalBytes{0};
+    atomic<size_t> failed{0};
+    auto start = chrono::steady_clock::now();
     {
-        threads[i].join();
+        // Cola acotada en trabajos en curso: cada uno solo guarda su fila y sus buffers
+        ThreadPool pool(min(jobs, max<size_t>(files.size(), 1)));
+        vector<future<void>> futures;
+        for (const string& file : files){
+            futures.emplace_back(pool.enqueue([&, file]() {
+                string output = (fs::path(options.outputDir) / (options.prefix + fs::path(file).filename().string())).string();
+                auto jobStart = chrono::steady_clock::now();
+                try{
+                    uintmax_t bytes = convert(file, output, pipeline);
+                    totalBytes += bytes;
+                    double seconds = chrono::duration<double>(chrono::steady_clock::now() - jobStart).count();
+                    lock_guard<mutex> lock(outputMutex);
+                    cout << file << " -> " << output << fixed << setprecision(2)
+                         << "  (" << bytes / 1e6 << " MB, " << seconds << " s)" << endl;
+                }catch(const exception& e){
+                    failed++;
+                    lock_guard<mutex> lock(outputMutex);
+                    // Los errores de PPMReader y PPMWriter ya nombran su fichero
+                    cerr << e.what() << endl;
+                }
+            }));
+        }
+        for (auto& future : futures){
+            future.get();
+        }
     }
-}
\ No newline at end of file
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << fixed << setprecision(2) << "Done: " << files.size() - failed << "/" << files.size() << " images, "
+         << totalBytes / 1e6 << " MB in " << seconds << " s ("
+         << (seconds > 0 ? totalBytes / 1e6 / seconds : 0.0) << " MB/s)" << endl;
+    return failed > 0 ? 1 : 0;
+}
@@ -13,6 +13,7 @@
 #include <future>
 #include <thread>
 #include "Camera.hpp"
+#include "PathIntegrator.hpp"
 #include "Utils.hpp"
 #include "progressbar.hpp"
 #include "ThreadPool.hpp"
@@ -163,6 +164,7 @@ Ray Camera::getRayToPixel(size_t x, size_t y){
  */
 PPM Camera::render(FigureCollection& scene, std::vector<std::shared_ptr<Light>>& lights){
     PPM image(this->height, this->width);
+    const PathIntegrator integrator(scene, lights);
     const int total = this->height * this->width;
     std::atomic<int> pixels_done{0};
     progressbar pb(this->height * this->width);
@@ -189,14 +191,7 @@ PPM Camera::render(FigureCollection& scene, std::vector<std::shared_ptr<Light>>&
             Color color(0,0,0);
 
             for(size_t i = 0; i < MAX_RAYS_PER_PIXEL; i++){
-                                
-                Ray ray = this->getRayToPixel(x, y);
-                
-                Intersection intersection = Intersection();
-                
-                if(scene.isIntersectedBy(ray, 0.00001f, INT_MAX, intersection)){
-                    color += intersection.material->getColor(ray, intersection, lights, scene);
-                }
+                color += integrator.radiance(this->getRayToPixel(x, y));
             }
 
             color /= double(MAX_RAYS_PER_PIXEL);
@@ -52,6 +52,6 @@ std::ostream& operator<<(std::ostream& os, const Color &c){
  * @param b_ Componente azul (0-255).
  * @return Color Un objeto Color con valores RGB normalizados.
  */
-Color Color::fromRGB(double r_, double g_, double b_){
+Color Color::fromRGB(Real r_, Real g_, Real b_){
     return Color(r_ / 255.0, g_ / 255.0, b_ / 255.0);
 }
\ No newline at end of file
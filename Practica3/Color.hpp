@@ -24,18 +24,18 @@
 class Color: public Coordinate{
 private:
 public:
-    double& r = x;
-    double& g = y;
-    double& b = z;
+    Real& r = x;
+    Real& g = y;
+    Real& b = z;
 
-    Color(double r_, double g_, double b_): Coordinate(r_, g_, b_, 0){};
+    Color(Real r_, Real g_, Real b_): Coordinate(r_, g_, b_, 0){};
     Color() : Coordinate(0.0, 0.0, 0.0, 0.0){};
     Color(const Coordinate& c) : Color(c.x, c.y, c.z) {}
     Color(const Color& c) : Color(c.x, c.y, c.z) {}
     ~Color();    
     Color& operator=(const Color& c);
     friend std::ostream& operator<<(std::ostream& os, const Color &c);
-    static Color fromRGB(double r_, double g_, double b_);
+    static Color fromRGB(Real r_, Real g_, Real b_);
 };
 
 #endif /* COLOR_HPP */
\ No newline at end of file
@@ -22,7 +22,7 @@
  * @param z Valor de la coordenada z.
  * @param w Valor de la coordenada homogénea w.
  */
-Coordinate::Coordinate(double x, double y, double z, double w){
+Coordinate::Coordinate(Real x, Real y, Real z, Real w){
     this->x = x;
     this->y = y;
     this->z = z;
@@ -94,7 +94,7 @@ Matrix baseChange(const Coordinate& origin, const Coordinate& u, const Coordinat
  * @return Nuevo objeto Coordinate resultante de la transformación.
  */
 Coordinate operator*(const Matrix& m, const Coordinate& c){
-    double new_x, new_y, new_z, new_w;
+    Real new_x, new_y, new_z, new_w;
 
     new_x = m[0][0] * c.x + m[0][1] * c.y + m[0][2] * c.z + m[0][3] * c.w;
     new_y = m[1][0] * c.x + m[1][1] * c.y + m[1][2] * c.z + m[1][3] * c.w;
@@ -144,7 +144,7 @@ Coordinate operator*(const Coordinate& c1, const Coordinate& c2){
  * @param constant Valor constante por el cual se multiplican las componentes.
  * @return Nuevo objeto Coordinate con las componentes multiplicadas por el escalar.
  */
-Coordinate operator*(const Coordinate& c, const double constant){
+Coordinate operator*(const Coordinate& c, const Real constant){
     return Coordinate(
         c.x * constant,
         c.y * constant,
@@ -163,7 +163,7 @@ Coordinate operator*(const Coordinate& c, const double constant){
  * @param c Objeto Coordinate a multiplicar.
  * @return Nuevo objeto Coordinate con las componentes multiplicadas por el escalar.
  */
-Coordinate operator*(const double constant, const Coordinate& c){
+Coordinate operator*(const Real constant, const Coordinate& c){
     return c * constant;
 }
 
@@ -196,7 +196,7 @@ Coordinate operator/(const Coordinate& c1, const Coordinate& c2){
  * @param constant Valor constante por el cual se dividen las componentes.
  * @return Nuevo objeto Coordinate con las componentes divididas por el escalar.
  */
-Coordinate operator/(const Coordinate& c, const double constant){
+Coordinate operator/(const Coordinate& c, const Real constant){
     return Coordinate(
         c.x / constant,
         c.y / constant,
@@ -234,7 +234,7 @@ Coordinate operator+(const Coordinate& c1, const Coordinate& c2){
  * @param constant Valor constante que se suma a cada componente.
  * @return Nuevo objeto Coordinate con las componentes incrementadas por el escalar.
  */
-Coordinate operator+(const Coordinate& c, const double constant){
+Coordinate operator+(const Coordinate& c, const Real constant){
     return Coordinate(
         c.x + constant,
         c.y + constant,
@@ -253,7 +253,7 @@ Coordinate operator+(const Coordinate& c, const double constant){
  * @param c Objeto Coordinate al que se le suma el escalar.
  * @return Nuevo objeto Coordinate con las componentes incrementadas por el escalar.
  */
-Coordinate operator+(const double constant, const Coordinate& c){
+Coordinate operator+(const Real constant, const Coordinate& c){
     return c + constant;
 }
 
@@ -280,7 +280,7 @@ Coordinate& Coordinate::operator+=(const Coordinate& c){
  * @param constant Valor constante que se suma a cada componente.
  * @return Referencia al objeto Coordinate actualizado.
  */
-Coordinate& Coordinate::operator+=(const double constant){
+Coordinate& Coordinate::operator+=(const Real constant){
     this->x += constant;
     this->y += constant;
     this->z += constant;
@@ -295,7 +295,7 @@ Coordinate& Coordinate::operator+=(const double constant){
  * @param constant Valor constante por el cual se dividen las componentes.
  * @return Referencia al objeto Coordinate actualizado.
  */
-Coordinate& Coordinate::operator*=(const double constant){
+Coordinate& Coordinate::operator*=(const Real constant){
     this->x *= constant;
     this->y *= constant;
     this->z *= constant;
@@ -310,7 +310,7 @@ Coordinate& Coordinate::operator*=(const double constant){
  * @param constant Valor constante por el cual se dividen las componentes.
  * @return Referencia al objeto Coordinate actualizado.
  */
-Coordinate& Coordinate::operator/=(const double constant){
+Coordinate& Coordinate::operator/=(const Real constant){
     this->x /= constant;
     this->y /= constant;
     this->z /= constant;
@@ -325,6 +325,6 @@ Coordinate& Coordinate::operator/=(const double constant){
  * @param c Objeto Coordinate del cual se calcula el componente máximo.
  * @return Valor máximo entre las componentes x, y, z.
  */
-double maxComponent(const Coordinate& c){
+Real maxComponent(const Coordinate& c){
     return std::max(c.x, std::max(c.y, c.z));
 }
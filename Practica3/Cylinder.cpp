@@ -22,7 +22,7 @@
  * @param intersection Objeto Intersection donde se almacenarán los detalles de la intersección si ocurre.
  * @return true Si el rayo intersecta con el cilindro, false en caso contrario.
  */
-bool Cylinder::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const {
+bool Cylinder::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const {
     // Vector hacia la base del cilindro
     Vector delta = ray.origin - baseCenter;
 
@@ -31,22 +31,22 @@ bool Cylinder::isIntersectedBy(const Ray& ray, double tMin, double tMax, Interse
     Vector deltaW = delta - axis * dotProduct(delta, axis);
 
     // Cálculo para intersección con el cuerpo del cilindro
-    double a = dotProduct(w, w);
-    double b = 2 * dotProduct(w, deltaW);
-    double c = dotProduct(deltaW, deltaW) - radius * radius;
+    Real a = dotProduct(w, w);
+    Real b = 2 * dotProduct(w, deltaW);
+    Real c = dotProduct(deltaW, deltaW) - radius * radius;
 
-    double discriminant = b * b - 4 * a * c;
+    Real discriminant = b * b - 4 * a * c;
 
     if (discriminant >= 0) {
         // Soluciones cuadráticas
-        double t0 = (-b - sqrt(discriminant)) / (2 * a);
-        double t1 = (-b + sqrt(discriminant)) / (2 * a);
+        Real t0 = (-b - sqrt(discriminant)) / (2 * a);
+        Real t1 = (-b + sqrt(discriminant)) / (2 * a);
 
         // Verifica rango de altura del cilindro para el cuerpo
-        for (double t : {t0, t1}) {
+        for (Real t : {t0, t1}) {
             if (t > tMin && t < tMax) {
                 Point pCuerpo = ray.at(t);
-                double hCuerpo = dotProduct(pCuerpo - baseCenter, axis);
+                Real hCuerpo = dotProduct(pCuerpo - baseCenter, axis);
 
                 if (hCuerpo >= 0 && hCuerpo <= height) {
                     intersection.t = t;
@@ -63,10 +63,10 @@ bool Cylinder::isIntersectedBy(const Ray& ray, double tMin, double tMax, Interse
 
     // Cálculo para intersección con las tapas
     for (int i = 0; i < 2; i++) {
-        double hTapa = (i == 0) ? 0 : height;
+        Real hTapa = (i == 0) ? 0 : height;
         Point centerTapa = (Point)((Coordinate)baseCenter + (Coordinate)(axis * hTapa));
 
-        double tTapa = dotProduct(centerTapa - ray.origin, axis) / dotProduct(ray.dir, axis);
+        Real tTapa = dotProduct(centerTapa - ray.origin, axis) / dotProduct(ray.dir, axis);
         if (tTapa > tMin && tTapa < tMax) {
             Point pTapa = ray.at(tTapa);
             if (module(pTapa - centerTapa) <= radius) {
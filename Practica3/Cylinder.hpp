@@ -26,16 +26,16 @@ class Cylinder : public Figure {
 private:
     Point baseCenter; // Centro de la base del cilindro
     Vector axis;      // Dirección del eje del cilindro (debe ser normalizada)
-    double radius;    // Radio del cilindro
-    double height;    // Altura del cilindro
+    Real radius;    // Radio del cilindro
+    Real height;    // Altura del cilindro
 
 public:
-    Cylinder(const Point& baseCenter, const Vector& axis, double radius, double height, const std::shared_ptr<Material>& material)
+    Cylinder(const Point& baseCenter, const Vector& axis, Real radius, Real height, const std::shared_ptr<Material>& material)
         : Figure(material), baseCenter(baseCenter), axis(normalize(axis)), radius(radius), height(height) {}
 
     ~Cylinder() = default;
 
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
 };
 
 
@@ -30,7 +30,7 @@ Figure::Figure(const std::shared_ptr<Material>& material){
  * @param g Componente verde del color (0.0 a 1.0).
  * @param b Componente azul del color (0.0 a 1.0).
  */
-void Figure::setColor(double r, double g, double b){
+void Figure::setColor(Real r, Real g, Real b){
     this->material.get()->setColor(Color(r, g, b));
 }
 
@@ -32,9 +32,9 @@ public:
     Figure() = default;
     Figure(const std::shared_ptr<Material>& material);
     virtual ~Figure() = default;
-    void setColor(double r, double g, double b);
+    void setColor(Real r, Real g, Real b);
     void setMaterial(const std::shared_ptr<Material>& material);
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override = 0;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override = 0;
     void setVisible(bool visible);
 };
 
@@ -107,10 +107,10 @@ std::vector<Figure*>::iterator FigureCollection::iterator(){
  * @param intersection Objeto Intersection donde se almacenarán los detalles de la intersección si ocurre.
  * @return true Si al menos una figura es intersectada por el rayo, false en caso contrario.
  */
-bool FigureCollection::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const{
+bool FigureCollection::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
     Intersection tmp;
     bool anyHit = false;
-    double closest = tMax;
+    Real closest = tMax;
 
     for (const auto& fig : this->figureList) {
         if (fig->isIntersectedBy(ray, tMin, closest, tmp)) {
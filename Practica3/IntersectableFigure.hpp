@@ -25,7 +25,7 @@ class Material;
  */
 struct Intersection{
     public:
-        double t = 0;
+        Real t = 0;
         Vector normal = Vector();
         Point intersectionPoint = Point();
         std::shared_ptr<Material> material;
@@ -44,7 +44,7 @@ private:
 public:
     IntersectableFigure(/* args */) = default;
     virtual ~IntersectableFigure() = default;
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const = 0;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const = 0;
     
 };
 
@@ -147,89 +147,19 @@ Vector Material::randomDirection(const Ray& ray, const Intersection& intersectio
 }
 
 /**
- * @brief Calcula la iluminación directa en un punto de intersección utilizando el método de eventos siguientes.
- * 
- * Este método evalúa la contribución de cada fuente de luz a la iluminación del punto de intersección,
- * considerando si hay sombras y aplicando las funciones BRDF y BSDF correspondientes.
- * 
- * @param lights Lista de fuentes de luz en la escena.
- * @param intersection Información sobre la intersección del rayo con el material.
- * @param scene Escena que contiene las figuras intersectables.
- * @return Color Resultado de la iluminación directa en el punto de intersección.
- */
-Color Material::nextEvent(const std::vector<std::shared_ptr<Light>>& lights, const Intersection& intersection, const IntersectableFigure& scene) const{
-    Color finalColor;
-
-    for(const auto& light : lights){
-        Vector shadowRayDirection = light->getCenter() - intersection.intersectionPoint;
-
-        Ray shadowRay(
-            intersection.intersectionPoint,
-            normalize(shadowRayDirection)      
-        );
-
-        Intersection shadowIntersection;
-        if(scene.isIntersectedBy(shadowRay, 0.00001f, module(shadowRayDirection), shadowIntersection)){
-            finalColor += Color(0, 0, 0);
-        }else {
-            Color term1 = (light->getPower() / pow(module(shadowRayDirection), 2));
-            Color term2 = this->brdf(Ray(), intersection);
-            double term3 = abs(
-                dotProduct(
-                    intersection.normal,
-                    (shadowRayDirection) / module(shadowRayDirection)
-                )
-            );
-
-            finalColor += term1 * term2 * term3;   
-        }
-    }
-    finalColor /= double(lights.size());
-
-    return finalColor;
-}
-
-/**
- * @brief Calcula el color resultante de un material en un punto de intersección dado, considerando la iluminación directa e indirecta.
- * 
- * Este método implementa el algoritmo de trazado de rayos para calcular el color final en un punto de intersección,
- * utilizando la ruleta rusa para decidir si se absorbe, refleja o refracta la luz, y recursivamente calcula la iluminación indirecta.
+ * @brief Muestrea la BSDF del material eligiendo el evento con la ruleta rusa.
  * 
  * @param ray Rayo incidente que interactúa con el material.
  * @param intersection Información sobre la intersección del rayo con el material.
- * @param lights Lista de fuentes de luz en la escena.
- * @param scene Escena que contiene las figuras intersectables.
- * @param depth Profundidad actual del rayo en el trazado (para evitar recursión infinita).
- * @return Color Resultado del color calculado en el punto de intersección.
+ * @return BSDFSample Evento elegido, dirección de salida y peso f * cos / pdf.
  */
-Color Material::getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& lights, const IntersectableFigure& scene, int depth) const{
-    if (depth >= MAX_BOUNCES) return Color(0, 0, 0);
-
-    Color final(0,0,0);
-    Color luzDirecta = this->nextEvent(lights, intersection, scene);
-    
-    for(int path = 0; path < MAX_PATHS; path++){
-        Color luzIndirecta(0,0,0);
-
-        RR_Event event = russianRoulette(kd, ks, kt);
-        
-        if(event.eventType == ABSORTION){
-            continue;
-        }
-
-        Vector randomVector = getSacterredVector(ray, intersection, event);
-        Ray randomRay = Ray(intersection.intersectionPoint, randomVector);
-        Intersection randomRayIntersection;
-
-        if(depth < MAX_BOUNCES && scene.isIntersectedBy(randomRay, 0.00001f, INT_MAX, randomRayIntersection)){
-            luzIndirecta = randomRayIntersection.material->getColor(randomRay, randomRayIntersection, lights, scene, depth+1);            
-        }
-        
-        final += luzDirecta + (luzIndirecta * bsdf(randomRay, intersection, event) ) ;
-        
+BSDFSample Material::sample(const Ray& ray, const Intersection& intersection) const{
+    RR_Event event = russianRoulette(kd, ks, kt);
+    if(event.eventType == ABSORTION){
+        return {ABSORTION, Vector(0, 0, 0), Color(0, 0, 0)};
     }
-    final /= double(MAX_PATHS);
-    return final;
+    Vector direction = getSacterredVector(ray, intersection, event);
+    return {event.eventType, direction, bsdf(ray, intersection, event)};
 }
 
 /**
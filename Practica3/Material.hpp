@@ -52,6 +52,19 @@ struct RR_Event{
 
 RR_Event russianRoulette(Color kdWeight, Color ksWeight, Color ktWeight);
 
+/**
+ * @struct BSDFSample
+ * @brief Muestra de la BSDF de un material.
+ *
+ * Contiene el evento elegido, la dirección de salida y el peso f * cos / pdf por el que
+ * el integrador multiplica el throughput del camino.
+ */
+struct BSDFSample{
+    RR_EventType eventType;
+    Vector direction;
+    Color weight;
+};
+
 /**
  * @class Material
  * @brief Clase que representa las propiedades ópticas de un material en el sistema de trazado de rayos.
@@ -59,7 +72,8 @@ RR_Event russianRoulette(Color kdWeight, Color ksWeight, Color ktWeight);
  * Esta clase define las propiedades de un material, incluyendo su color difuso (kd), especular (ks),
  * refractivo (kt) y su índice de refracción (ior). Proporciona métodos para calcular la dirección
  * aleatoria de dispersión, el color resultante de la interacción con la luz y la implementación
- * de la ruleta rusa para seleccionar eventos de dispersión.
+ * de la ruleta rusa para seleccionar eventos de dispersión. El transporte de luz (caminos y luz directa)
+ * lo hace PathIntegrator; el material solo muestrea y evalúa su BSDF.
  */
 class Material{
 private:
@@ -73,12 +87,11 @@ public:
     Material() = default;
     Material(const Color& color);
     Material(const Color& kd, const Color& ks, const Color& kt, double ior);
-    ~Material() = default;
+    virtual ~Material() = default;
     void setColor(const Color& color);
     Vector randomDirection(const Ray& ray, const Intersection& intersection) const;
-    virtual Color getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& lights, const IntersectableFigure& scene, int depth = 0) const;
+    virtual BSDFSample sample(const Ray& ray, const Intersection& intersection) const;
     virtual Color brdf(const Ray& ray, const Intersection& intersection) const;
-    Color nextEvent(const std::vector<std::shared_ptr<Light>>& lights, const Intersection& intersection, const IntersectableFigure& scene) const;
     Vector getSacterredVector(const Ray &ray, const Intersection &intersection, const RR_Event event) const;
     Color bsdf(const Ray& ray, const Intersection& intersection, const RR_Event event) const;
 };
@@ -12,9 +12,7 @@
 #define _USE_MATH_DEFINES
 
 #include <math.h>
-#include <limits.h>
 #include "Materials.hpp"
-#include "FigureCollection.hpp"
 
 /**
  * @brief Constructor de la clase Material.
@@ -43,41 +41,16 @@ Materials::Lambertian::Lambertian(double r, double g, double b): Material(Color:
 }
 
 /**
- * @brief Método que calcula el color resultante de un rayo en una intersección con un material Lambertiano.
+ * @brief Muestrea la BRDF de un material Lambertiano.
  * 
- * Este método implementa el algoritmo de path tracing para calcular la iluminación directa e indirecta
- * en una intersección, utilizando la ruleta rusa para seleccionar eventos de dispersión y generando rayos aleatorios
- * para simular la luz difusa.
+ * La dirección se elige con densidad proporcional al coseno, así que el peso f * cos / pdf es kd.
  * 
  * @param ray Rayo incidente que interactúa con el material.
  * @param intersection Información sobre la intersección del rayo con el material.
- * @param lights Lista de luces presentes en la escena.
- * @param scene Escena que contiene las figuras y sus materiales.
- * @param depth Profundidad actual del rayo en el trazado de rayos.
- * @return Color Resultado del color calculado en la intersección.
+ * @return BSDFSample Evento difuso, dirección aleatoria y peso kd.
  */
-Color Materials::Lambertian::getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& lights, const IntersectableFigure& scene, int depth) const{
-    Color final(0,0,0);
-    Color luzDirecta = this->nextEvent(lights, intersection, scene);
-    
-    for(int path = 0; path < MAX_PATHS; path++){
-        Color luzIndirecta(0,0,0);
-
-        //random ray
-        Vector randomVector = randomDirection(ray, intersection);
-        Ray randomRay = Ray(intersection.intersectionPoint, randomVector);
-        Intersection randomRayIntersection;
-
-        if(depth < MAX_BOUNCES && scene.isIntersectedBy(randomRay, 0.00001f, INT_MAX, randomRayIntersection)){
-            luzIndirecta = randomRayIntersection.material->getColor(randomRay, randomRayIntersection, lights, scene, depth+1);            
-        }
-
-        final += luzDirecta + (luzIndirecta * M_PI * this->brdf(ray,intersection));
-
-    }
-    final /= double(MAX_PATHS);
-    return final;
-
+BSDFSample Materials::Lambertian::sample(const Ray& ray, const Intersection& intersection) const{
+    return {DIFUSSE, randomDirection(ray, intersection), this->kd};
 }
 
 /**
@@ -121,39 +94,16 @@ Materials::Metal::Metal(double r, double g, double b): Material(Color::fromRGB(r
 }
 
 /**
- * @brief Método que calcula el color resultante de un rayo en una intersección con un material metálico.
+ * @brief Muestrea la BRDF de un material metálico.
  * 
- * Este método implementa el algoritmo de path tracing para calcular la iluminación directa e indirecta
- * en una intersección, utilizando la ruleta rusa para seleccionar eventos de reflexión especular y generando rayos reflejados
- * para simular la luz especular.
+ * La reflexión es perfecta: la dirección es la reflejada y el peso es kd.
  * 
  * @param ray Rayo incidente que interactúa con el material.
  * @param intersection Información sobre la intersección del rayo con el material.
- * @param lights Lista de luces presentes en la escena.
- * @param scene Escena que contiene las figuras y sus materiales.
- * @param depth Profundidad actual del rayo en el trazado de rayos.
- * @return Color Resultado del color calculado en la intersección.
+ * @return BSDFSample Evento especular, dirección reflejada y peso kd.
  */
-Color Materials::Metal::getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& lights, const IntersectableFigure& scene, int depth) const{
-    Color final(0,0,0);
-    Color luzDirecta = this->nextEvent(lights, intersection, scene);
-    
-    for(int path = 0; path < MAX_PATHS; path++){
-        Color luzIndirecta(0,0,0);
-
-        Vector reflectedVector = reflect(ray.dir, intersection.normal);
-        Ray reflectedRay = Ray(intersection.intersectionPoint, reflectedVector);
-        Intersection reflectedRayIntersection;
-
-        if(depth < MAX_BOUNCES && scene.isIntersectedBy(reflectedRay, 0.00001f, INT_MAX, reflectedRayIntersection)){
-            luzIndirecta = reflectedRayIntersection.material->getColor(reflectedRay, reflectedRayIntersection, lights, scene, depth+1);            
-        }
-
-        final += luzDirecta + (luzIndirecta * M_PI  *this->brdf(ray,intersection));
-
-    }
-    final /= double(MAX_PATHS);
-    return final;
+BSDFSample Materials::Metal::sample(const Ray& ray, const Intersection& intersection) const{
+    return {SPECULAR, reflect(ray.dir, intersection.normal), this->kd};
 }
 
 /**
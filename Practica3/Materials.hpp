@@ -38,7 +38,7 @@ namespace Materials{
         Lambertian(const Color& color);
         Lambertian(double r, double g, double b);
         ~Lambertian() = default;
-        virtual Color getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& light, const IntersectableFigure& scene, int depth = 0) const override;
+        virtual BSDFSample sample(const Ray& ray, const Intersection& intersection) const override;
         virtual Color brdf(const Ray& ray, const Intersection& intersection) const ;
     };
 
@@ -57,7 +57,7 @@ namespace Materials{
         Metal(const Color& color);
         Metal(double r, double g, double b);
         ~Metal() = default;
-        virtual Color getColor(const Ray& ray, const Intersection& intersection, const std::vector<std::shared_ptr<Light>>& light, const IntersectableFigure& scene, int depth = 0) const override;
+        virtual BSDFSample sample(const Ray& ray, const Intersection& intersection) const override;
         virtual Color brdf(const Ray& ray, const Intersection& intersection) const ;
     };
 
@@ -106,7 +106,7 @@ Matrix identity(){
  * @param new_z Desplazamiento en el eje z.
  * @return Matrix Matriz de traslación 4x4.
  */
-Matrix traslation(const double new_x, const double new_y, const double new_z){
+Matrix traslation(const Real new_x, const Real new_y, const Real new_z){
     Matrix m = identity();
     m[0][3] = new_x;
     m[1][3] = new_y;
@@ -123,7 +123,7 @@ Matrix traslation(const double new_x, const double new_y, const double new_z){
  * @param angle Ángulo de rotación en radianes.
  * @return Matrix Matriz de rotación alrededor del eje X 4x4.
  */
-Matrix rotationX(const double angle){
+Matrix rotationX(const Real angle){
     Matrix m = identity();
     m[1][1] = cos(angle);
     m[1][2] = -sin(angle);
@@ -141,7 +141,7 @@ Matrix rotationX(const double angle){
  * @param angle Ángulo de rotación en radianes.
  * @return Matrix Matriz de rotación alrededor del eje Y 4x4.
  */
-Matrix rotationY(const double angle){
+Matrix rotationY(const Real angle){
     Matrix m = identity();
     m[0][0] = cos(angle);
     m[0][2] = sin(angle);
@@ -159,7 +159,7 @@ Matrix rotationY(const double angle){
  * @param angle Ángulo de rotación en radianes.
  * @return Matrix Matriz de rotación alrededor del eje Z 4x4.
  */
-Matrix rotationZ(const double angle){
+Matrix rotationZ(const Real angle){
     Matrix m = identity();
     m[0][0] = cos(angle);
     m[0][1] = -sin(angle);
@@ -179,7 +179,7 @@ Matrix rotationZ(const double angle){
  * @param z_scale Factor de escalado en el eje z.
  * @return Matrix Matriz de escalado 4x4.
  */
-Matrix scale(const double x_scale, const double y_scale, const double z_scale){
+Matrix scale(const Real x_scale, const Real y_scale, const Real z_scale){
     Matrix m = identity();
     m[0][0] = x_scale;
     m[1][1] = y_scale;
@@ -219,7 +219,7 @@ Matrix operator*(const Matrix& m1, const Matrix& m2){
  * @param c Escalar por el cual se multiplica la matriz.
  * @return Matrix Resultado de la multiplicación de la matriz por el escalar.
  */
-Matrix operator*(const Matrix& m, const double c){
+Matrix operator*(const Matrix& m, const Real c){
     Matrix result = Matrix();
     for (size_t i = 0; i < 4; i++){
         for (size_t j = 0; j < 4; j++){
@@ -238,7 +238,7 @@ Matrix operator*(const Matrix& m, const double c){
  * @param m Matriz a multiplicar.
  * @return Matrix Resultado de la multiplicación del escalar por la matriz.
  */
-Matrix operator*(const double c, const Matrix& m){
+Matrix operator*(const Real c, const Matrix& m){
     return m * c;
 }
 
@@ -2,7 +2,7 @@
  * @file Matrix.hpp
  * @brief Definición de la clase Matrix y funciones auxiliares para operaciones con matrices 4x4.
  * 
- * Este archivo contiene la declaración de la clase Matrix, que representa matrices de 4x4 de tipo double,
+ * Este archivo contiene la declaración de la clase Matrix, que representa matrices de 4x4 de tipo Real,
  * así como las funciones y operadores necesarios para realizar operaciones comunes en gráficos por computadora,
  * como identidad, traslación, rotación y escalado.
  * 
@@ -15,35 +15,36 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include "Real.hpp"
 
 /**
  * @class Matrix
- * @brief Clase que representa una matriz 4x4 de tipo double.
+ * @brief Clase que representa una matriz 4x4 de tipo Real.
  * 
  * Esta clase proporciona métodos para crear matrices identidad, de traslación, rotación y escalado,
  * así como operadores para multiplicar matrices y escalar matrices por un escalar.
  */
 class Matrix{
 private:
-    double mat[4][4];    
+    Real mat[4][4];    
 public:
     Matrix();
     ~Matrix();
-    double* operator[](std::size_t idx ){ return mat[idx]; }
-    const double* operator[](std::size_t idx ) const{ return mat[idx]; }
+    Real* operator[](std::size_t idx ){ return mat[idx]; }
+    const Real* operator[](std::size_t idx ) const{ return mat[idx]; }
     friend std::ostream& operator<<(std::ostream& os, const Matrix &m);
     friend Matrix operator*(const Matrix& m1, const Matrix& m2);
-    friend Matrix operator*(const Matrix& m, const double c);
-    friend Matrix operator*(const double c, const Matrix& m);
+    friend Matrix operator*(const Matrix& m, const Real c);
+    friend Matrix operator*(const Real c, const Matrix& m);
 };
 
 Matrix identity();
-Matrix traslation(double new_x, double new_y, double new_z);
+Matrix traslation(Real new_x, Real new_y, Real new_z);
 
-Matrix rotationX(double angle);
-Matrix rotationY(double angle);
-Matrix rotationZ(double angle);
+Matrix rotationX(Real angle);
+Matrix rotationY(Real angle);
+Matrix rotationZ(Real angle);
 
-Matrix scale(double x_scale, double y_scale, double z_scale);
+Matrix scale(Real x_scale, Real y_scale, Real z_scale);
 
 #endif /* MATRIX_HPP */
\ No newline at end of file
@@ -0,0 +1,112 @@
+/**
+ * @file PathIntegrator.cpp
+ * @brief Implementación del integrador iterativo de caminos.
+ *
+ * @author Alex
+ * @date 18-6-2025
+ */
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <algorithm>
+#include <limits.h>
+#include "PathIntegrator.hpp"
+#include "Material.hpp"
+#include "Utils.hpp"
+
+/**
+ * @brief Constructor del integrador.
+ *
+ * @param scene Escena que contiene las figuras intersectables.
+ * @param lights Lista de fuentes de luz en la escena.
+ */
+PathIntegrator::PathIntegrator(const IntersectableFigure& scene, const std::vector<std::shared_ptr<Light>>& lights)
+    : scene(scene), lights(lights) {}
+
+/**
+ * @brief Calcula la radiancia que llega a lo largo de un rayo.
+ *
+ * Se lanzan MAX_PATHS caminos desde el primer impacto y se promedian.
+ *
+ * @param ray Rayo desde la cámara.
+ * @return Color Radiancia estimada (negro si el rayo no choca con nada).
+ */
+Color PathIntegrator::radiance(const Ray& ray) const{
+    Intersection intersection;
+    if(!scene.isIntersectedBy(ray, ray.epsilon(), INT_MAX, intersection)){
+        return Color(0, 0, 0);
+    }
+    Color result(0, 0, 0);
+    for(size_t path = 0; path < MAX_PATHS; path++){
+        result += tracePath(ray, intersection);
+    }
+    return result / double(MAX_PATHS);
+}
+
+/**
+ * @brief Sigue un camino desde su primer impacto.
+ *
+ * @param ray Rayo que produjo el impacto.
+ * @param intersection Primer impacto del camino.
+ * @return Color Radiancia acumulada a lo largo del camino.
+ */
+Color PathIntegrator::tracePath(Ray ray, Intersection intersection) const{
+    Color result(0, 0, 0);
+    Color throughput(1, 1, 1);
+    // Luz directa en MAX_BOUNCES vertices como mucho (profundidad 0 a MAX_BOUNCES - 1), como Material::getColor
+    for(size_t bounce = 0; bounce < MAX_BOUNCES; bounce++){
+        result += throughput * nextEvent(intersection);
+        if(bounce + 1 >= MAX_BOUNCES){
+            break;
+        }
+        BSDFSample sample = intersection.material->sample(ray, intersection);
+        if(sample.eventType == ABSORTION){
+            break;
+        }
+        throughput = throughput * sample.weight;
+
+        // Ruleta rusa: sobrevive con probabilidad igual al throughput (acotada)
+        if(bounce + 1 >= ROULETTE_DEPTH){
+            double survive = std::min<double>(maxComponent(throughput), 0.95);
+            if(randomDouble() >= survive){
+                break;
+            }
+            throughput /= survive;
+        }
+
+        ray = Ray(intersection.intersectionPoint, sample.direction);
+        if(!scene.isIntersectedBy(ray, ray.epsilon(), INT_MAX, intersection)){
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Calcula la iluminación directa en un punto de intersección.
+ *
+ * Evalúa la contribución de cada fuente de luz, considerando si hay sombras y la BRDF del
+ * material, y promedia entre el número de luces.
+ *
+ * @param intersection Información sobre la intersección del rayo con el material.
+ * @return Color Resultado de la iluminación directa en el punto de intersección.
+ */
+Color PathIntegrator::nextEvent(const Intersection& intersection) const{
+    Color finalColor;
+
+    for(const auto& light : lights){
+        Vector shadowRayDirection = light->getCenter() - intersection.intersectionPoint;
+        double distance = module(shadowRayDirection);
+        Ray shadowRay(intersection.intersectionPoint, shadowRayDirection / distance);
+
+        Intersection shadowIntersection;
+        if(!scene.isIntersectedBy(shadowRay, shadowRay.epsilon(), distance, shadowIntersection)){
+            Color term1 = light->getPower() / (distance * distance);
+            Color term2 = intersection.material->brdf(Ray(), intersection);
+            double term3 = std::abs(dotProduct(intersection.normal, shadowRayDirection / distance));
+            finalColor += term1 * term2 * term3;
+        }
+    }
+    finalColor /= double(lights.size());
+
+    return finalColor;
+}
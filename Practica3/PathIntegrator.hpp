@@ -0,0 +1,38 @@
+/**
+ * @file PathIntegrator.hpp
+ * @brief Declaración del integrador iterativo de caminos.
+ *
+ * El integrador guarda el estado del camino (rayo, throughput y radiancia acumulada) en un bucle
+ * en lugar de recursión, y solo usa los materiales para muestrear y evaluar su BSDF.
+ *
+ * @author Alex
+ * @date 18-6-2025
+ */
+#ifndef PATHINTEGRATOR_HPP
+#define PATHINTEGRATOR_HPP
+#include <vector>
+#include <memory>
+#include "IntersectableFigure.hpp"
+#include "Light.hpp"
+
+/**
+ * @class PathIntegrator
+ * @brief Path tracing iterativo con luz directa en cada vértice y ruleta rusa por throughput.
+ *
+ * Cada camino suma la luz directa en cada vértice, multiplica su throughput por el peso de la
+ * muestra de la BSDF y sigue hasta MAX_BOUNCES rebotes. Pasados ROULETTE_DEPTH rebotes el
+ * camino termina con probabilidad 1 - throughput y, si sobrevive, se repondera.
+ */
+class PathIntegrator{
+private:
+    const IntersectableFigure& scene;
+    const std::vector<std::shared_ptr<Light>>& lights;
+
+    Color tracePath(Ray ray, Intersection intersection) const;
+public:
+    PathIntegrator(const IntersectableFigure& scene, const std::vector<std::shared_ptr<Light>>& lights);
+    Color radiance(const Ray& ray) const;
+    Color nextEvent(const Intersection& intersection) const;
+};
+
+#endif /* PATHINTEGRATOR_HPP */
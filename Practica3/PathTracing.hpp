@@ -29,6 +29,7 @@
 #include "TriangleMesh.hpp"
 #include "Plane.hpp"
 #include "Camera.hpp"
+#include "PathIntegrator.hpp"
 #include "PPM.hpp"
 #include "FigureCollection.hpp"
 #include "Light.hpp"
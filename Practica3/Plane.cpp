@@ -28,7 +28,7 @@ Plane::~Plane(){
  * @param dist Distancia desde el origen al plano.
  * @param material Material asociado al plano.
  */
-Plane::Plane(const Vector& normal, const double dist, const std::shared_ptr<Material>& material): Figure(material){
+Plane::Plane(const Vector& normal, const Real dist, const std::shared_ptr<Material>& material): Figure(material){
     this->normal = normal;
     this->dist = dist;
 }
@@ -57,16 +57,16 @@ Plane::Plane(const Vector& normal){
  * @param intersection Estructura donde se almacenarán los detalles de la intersección si ocurre.
  * @return bool Verdadero si hay una intersección válida, falso en caso contrario.
  */
-bool Plane::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const{
+bool Plane::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
     if(!this->visible){
         return false;
     }
 
-    double denom = dotProduct(ray.dir, this->normal);
+    Real denom = dotProduct(ray.dir, this->normal);
     if(denom == 0){
         return false;
     }
-    double div = this->dist + (ray.origin * (this->normal));
+    Real div = this->dist + (ray.origin * (this->normal));
     
     intersection.t = -(div/denom);
     intersection.normal = this->normal;
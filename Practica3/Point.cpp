@@ -54,7 +54,7 @@ Vector operator-(Point const &p1, Point const &p2){
  * @param p Punto al que se le suma el escalar.
  * @return Point Resultado de la suma del escalar al punto.
  */
-Point operator+(double const s, Point const &p){
+Point operator+(Real const s, Point const &p){
     return Point(s+p.x, s+p.y, s+p.z);
 }
 
@@ -67,7 +67,7 @@ Point operator+(double const s, Point const &p){
  * @param s Escalar a sumar.
  * @return Point Resultado de la suma del escalar al punto.
  */
-Point operator+(Point const &p, double const s){
+Point operator+(Point const &p, Real const s){
     return s+p;
 }
 
@@ -78,9 +78,9 @@ Point operator+(Point const &p, double const s){
  * 
  * @param p Punto que se multiplica por el vector.
  * @param v Vector con el que se multiplica el punto.
- * @return double Resultado del producto punto.
+ * @return Real Resultado del producto punto.
  */
-double operator*(const Point& p, const Vector &v){
+Real operator*(const Point& p, const Vector &v){
     return v*p;
 }
 
@@ -91,8 +91,8 @@ double operator*(const Point& p, const Vector &v){
  * 
  * @param v Vector que se multiplica por el punto.
  * @param p Punto con el que se multiplica el vector.
- * @return double Resultado del producto punto.
+ * @return Real Resultado del producto punto.
  */
-double operator*(const Vector &v, const Point& p){
+Real operator*(const Vector &v, const Point& p){
     return dotProduct(v, p - Point(0, 0, 0));
 }
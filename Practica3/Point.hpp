@@ -27,17 +27,17 @@
  */
 class Point: public Coordinate{
 public:
-    Point(double x, double y, double z) : Coordinate(x, y, z, 1.0){};
+    Point(Real x, Real y, Real z) : Coordinate(x, y, z, 1.0){};
     Point(const Coordinate& c) : Coordinate(c.x, c.y, c.z, 1.0) {};
     ~Point();
     Point() = default;
     friend Vector operator-(Point const &p1, Point const &p2);
-    friend Point operator+(double const s, Point const &p);
-    friend Point operator+(Point const &p, double const s);
+    friend Point operator+(Real const s, Point const &p);
+    friend Point operator+(Point const &p, Real const s);
     friend std::ostream& operator<<(std::ostream& os, const Point &p);
     
-    friend double operator*(const Point& p, const Vector &v);
-    friend double operator*(const Vector &v, const Point& p);
+    friend Real operator*(const Point& p, const Vector &v);
+    friend Real operator*(const Vector &v, const Point& p);
 
 };
 #endif /* POINT_HPP */
\ No newline at end of file
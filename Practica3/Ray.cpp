@@ -8,6 +8,8 @@
  * @date 18-6-2025
  */
 #include "Ray.hpp"
+#include <algorithm>
+#include <cmath>
 
 /**
  * @brief Constructor de la clase Ray.
@@ -54,7 +56,7 @@ std::ostream& operator<<(std::ostream& os, const Ray &r){
  * @param t Distancia desde el origen del rayo.
  * @return Point Punto en el rayo a la distancia t.
  */
-Point Ray::at(double t) const{
+Point Ray::at(Real t) const{
     return Point(
         this->origin.x + t*this->dir.x,
         this->origin.y + t*this->dir.y,
@@ -62,3 +64,16 @@ Point Ray::at(double t) const{
     );
 }
 
+
+/**
+ * @brief Distancia minima de interseccion para un rayo que parte de una superficie.
+ *
+ * RAY_EPSILON escalado por la mayor coordenada del origen, para que el margen
+ * cubra el error de redondeo del punto de impacto tambien en float.
+ *
+ * @return Real tMin con el que trazar el rayo.
+ */
+Real Ray::epsilon() const{
+    Real scale = std::max({Real(1), std::abs(origin.x), std::abs(origin.y), std::abs(origin.z)});
+    return RAY_EPSILON * scale;
+}
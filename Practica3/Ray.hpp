@@ -29,7 +29,8 @@ public:
     Ray(/* args */) = default;
     ~Ray();
     friend std::ostream& operator<<(std::ostream& os, const Ray &r);
-    Point at(double t) const;
+    Point at(Real t) const;
+    Real epsilon() const;
 };
 
 #endif /* RAY_HPP */
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * @file Real.hpp
+ * @brief Tipo escalar del nucleo de render y tolerancias de interseccion.
+ *
+ * Por defecto el tipo es double; compilando con -DREAL_FLOAT la geometria, los
+ * colores y las intersecciones pasan a float.
+ *
+ * @author Alex
+ * @date 18-6-2025
+ */
+#ifndef REAL_HPP
+#define REAL_HPP
+
+#ifdef REAL_FLOAT
+typedef float Real;
+#else
+typedef double Real;
+#endif
+
+/**
+ * @brief Distancia minima de un rayo que sale de una superficie.
+ *
+ * Se escala con la magnitud del origen (Ray::epsilon): el error de redondeo de
+ * un punto de impacto crece con sus coordenadas.
+ */
+#ifdef REAL_FLOAT
+const Real RAY_EPSILON = 1e-4f;
+#else
+const Real RAY_EPSILON = 1e-5;
+#endif
+
+/**
+ * @brief Coseno minimo entre un rayo unitario y el plano de un triangulo para no
+ * considerarlo paralelo.
+ *
+ * Es relativo: el determinante de Möller-Trumbore crece con |e1| |e2|, asi que
+ * un umbral absoluto descartaria los triangulos pequeños.
+ */
+#ifdef REAL_FLOAT
+const Real PARALLEL_EPSILON = 1e-5f;
+#else
+const Real PARALLEL_EPSILON = 1e-6;
+#endif
+
+/**
+ * @brief Indica si un rayo es paralelo a un triangulo.
+ *
+ * @param det Determinante de Möller-Trumbore, d . (e2 x e1).
+ * @param edge1Squared Longitud al cuadrado de la primera arista.
+ * @param edge2Squared Longitud al cuadrado de la segunda arista.
+ * @return true Si el rayo es paralelo o el triangulo es degenerado (det = 0).
+ */
+inline bool isParallelToTriangle(Real det, Real edge1Squared, Real edge2Squared){
+    return det * det <= PARALLEL_EPSILON * PARALLEL_EPSILON * edge1Squared * edge2Squared;
+}
+
+#endif /* REAL_HPP */
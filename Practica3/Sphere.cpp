@@ -19,7 +19,7 @@
  * @param r Radio de la esfera.
  * @param material Material asociado a la esfera.
  */
-Sphere::Sphere(const Point &origin, double r, const std::shared_ptr<Material>& material): Figure(material){
+Sphere::Sphere(const Point &origin, Real r, const std::shared_ptr<Material>& material): Figure(material){
     this->origin = origin;
     this->r = r;
 }
@@ -44,23 +44,23 @@ Sphere::~Sphere(){
  * @param intersection Estructura donde se almacenarán los detalles de la intersección si ocurre.
  * @return bool Verdadero si hay una intersección válida, falso en caso contrario.
  */
-bool Sphere::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const{
+bool Sphere::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const{
     if(!this->visible){
         return false;
     }
     Vector vectorToCenter = ray.origin - this->origin;
-    double a = dotProduct(ray.dir, ray.dir);
-    double b = 2 * dotProduct(vectorToCenter, ray.dir);
-    double c = dotProduct(vectorToCenter, vectorToCenter) - this->r * this->r;
+    Real a = dotProduct(ray.dir, ray.dir);
+    Real b = 2 * dotProduct(vectorToCenter, ray.dir);
+    Real c = dotProduct(vectorToCenter, vectorToCenter) - this->r * this->r;
     //std::cout << "a: " << a << "; b: " << b << "; c: " << c << std::endl;
-    double delta = b*b - 4 * a * c;
+    Real delta = b*b - 4 * a * c;
     //std::cout << "delta: " << delta << std::endl;
 
     if(delta < 0){
         return false;
     }
     
-    double t0 = (-b - sqrt(delta)) / (2 * a);
+    Real t0 = (-b - sqrt(delta)) / (2 * a);
     if(t0 < tMax && t0 > tMin){
         intersection.t = t0;
         intersection.intersectionPoint = ray.at(intersection.t);
@@ -70,7 +70,7 @@ bool Sphere::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersect
         return true;
     }
     
-    double t1 = (-b + sqrt(delta)) / (2 * a);
+    Real t1 = (-b + sqrt(delta)) / (2 * a);
     if(t1 < tMax && t1 > tMin){
         intersection.t = t1;
         intersection.intersectionPoint = ray.at(intersection.t);
@@ -25,12 +25,12 @@
 class Sphere : public Figure{
 private:
     Point origin;
-    double r;
+    Real r;
 public:
-    Sphere(const Point &origin, double r, const std::shared_ptr<Material>& material);
-    Sphere(double x, double y, double z, double r, const std::shared_ptr<Material>& material): Figure(material), origin(Point(x, y, z)), r(r){};
+    Sphere(const Point &origin, Real r, const std::shared_ptr<Material>& material);
+    Sphere(Real x, Real y, Real z, Real r, const std::shared_ptr<Material>& material): Figure(material), origin(Point(x, y, z)), r(r){};
     ~Sphere();
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
 };
 
 #endif /* SPHERE_HPP */
\ No newline at end of file
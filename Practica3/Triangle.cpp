@@ -25,34 +25,34 @@
  * @return true Si hay una intersección válida.
  * @return false Si no hay intersección o si el rayo es paralelo al triángulo.
  */
-bool Triangle::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const {
+bool Triangle::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const {
     // Calcula los bordes del triángulo
     Vector edge1 = v1 - v0;
     Vector edge2 = v2 - v0;
 
     // Calcula el determinante con el producto cruzado
     Vector h = crossProduct(ray.dir, edge2);
-    double det = dotProduct(edge1, h);
+    Real det = dotProduct(edge1, h);
 
     // Si el determinante es pequeño, el rayo es paralelo al triángulo
-    if (std::abs(det) < 1e-6) return false;
+    if (isParallelToTriangle(det, dotProduct(edge1, edge1), dotProduct(edge2, edge2))) return false;
 
-    double invDet = 1.0 / det;
+    Real invDet = 1.0 / det;
 
     // Vector desde el vértice v0 hasta el origen del rayo
     Vector s = ray.origin - v0;
 
     // Calcula la coordenada baricéntrica u
-    double u = dotProduct(s, h) * invDet;
+    Real u = dotProduct(s, h) * invDet;
     if (u < 0.0 || u > 1.0) return false;
 
     // Calcula la coordenada baricéntrica v
     Vector q = crossProduct(s, edge1);
-    double v = dotProduct(ray.dir, q) * invDet;
+    Real v = dotProduct(ray.dir, q) * invDet;
     if (v < 0.0 || u + v > 1.0) return false;
 
     // Calcula t para determinar el punto de intersección
-    double t = dotProduct(edge2, q) * invDet;
+    Real t = dotProduct(edge2, q) * invDet;
     if (t < tMin || t > tMax) return false;
 
     // Si hay intersección, rellena la información en el objeto `intersection`
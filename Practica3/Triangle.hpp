@@ -32,7 +32,7 @@ public:
         : Figure(material), v0(v0), v1(v1), v2(v2) {}
     virtual ~Triangle() = default;
 
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
 };
 
 #endif /* TRIANGLE_HPP */
\ No newline at end of file
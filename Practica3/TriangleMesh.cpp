@@ -75,9 +75,9 @@ void TriangleMesh::addTriangle(const Point& v0, const Point& v1, const Point& v2
  * @param intersection Estructura donde se almacenarán los detalles de la intersección si ocurre.
  * @return bool Verdadero si hay una intersección válida, falso en caso contrario.
  */
-bool TriangleMesh::isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const {
+bool TriangleMesh::isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const {
     bool hitAnything = false;
-    double closestSoFar = tMax;
+    Real closestSoFar = tMax;
 
     for (const auto& triangle : triangles) {
         Intersection tempIntersection;
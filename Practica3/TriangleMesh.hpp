@@ -39,7 +39,7 @@ public:
 
     virtual ~TriangleMesh();
 
-    virtual bool isIntersectedBy(const Ray& ray, double tMin, double tMax, Intersection& intersection) const override;
+    virtual bool isIntersectedBy(const Ray& ray, Real tMin, Real tMax, Intersection& intersection) const override;
 
     void addTriangle(const Point& v0, const Point& v1, const Point& v2);
 };
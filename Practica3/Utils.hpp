@@ -16,6 +16,7 @@
 
 const size_t MAX_BOUNCES = 6;
 const size_t MAX_PATHS = 1;
+const size_t ROULETTE_DEPTH = 3;   // Rebotes antes de aplicar la ruleta rusa por throughput
 
 const size_t MAX_RAYS_PER_PIXEL = 64;
 const size_t IMAGE_WIDTH = 1024;
@@ -75,9 +75,9 @@ Vector crossProduct(const Vector &v1, const Vector &v2){
  * 
  * @param v1 Primer vector.
  * @param v2 Segundo vector.
- * @return double Resultado del producto escalar de v1 y v2.
+ * @return Real Resultado del producto escalar de v1 y v2.
  */
-double dotProduct(const Vector &v1, const Vector &v2){
+Real dotProduct(const Vector &v1, const Vector &v2){
     return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z);
 }
 
@@ -90,7 +90,7 @@ double dotProduct(const Vector &v1, const Vector &v2){
  * @param s Escalar por el cual se multiplica el vector.
  * @return Vector Resultado de la multiplicación del vector por el escalar.
  */
-Vector operator*(const Vector &v, const double s){
+Vector operator*(const Vector &v, const Real s){
     return Vector(v.x * s, v.y * s, v.z * s);
 }
 
@@ -103,7 +103,7 @@ Vector operator*(const Vector &v, const double s){
  * @param v Vector a escalar.
  * @return Vector Resultado de la multiplicación del escalar por el vector.
  */
-Vector operator*(const double s, const Vector &v){
+Vector operator*(const Real s, const Vector &v){
     return v*s;
 }
 
@@ -116,7 +116,7 @@ Vector operator*(const double s, const Vector &v){
  * @param s Escalar por el cual se divide el vector.
  * @return Vector Resultado de la división del vector por el escalar.
  */
-Vector operator/(const Vector &v, const double s){
+Vector operator/(const Vector &v, const Real s){
     return Vector(v.x / s, v.y / s, v.z / s);
 }
 
@@ -127,9 +127,9 @@ Vector operator/(const Vector &v, const double s){
  * de sus componentes.
  * 
  * @param v Vector del cual se desea calcular la magnitud.
- * @return double Magnitud del vector v.
+ * @return Real Magnitud del vector v.
  */
-double module(const Vector &v){
+Real module(const Vector &v){
     return sqrt(pow(v.x, 2) + pow(v.y, 2) + pow(v.z, 2));
 }
 
@@ -140,9 +140,9 @@ double module(const Vector &v){
  * 
  * @param v1 Primer vector.
  * @param v2 Segundo vector.
- * @return double Ángulo en radianes entre v1 y v2.
+ * @return Real Ángulo en radianes entre v1 y v2.
  */
-double angle(const Vector &v1, const Vector &v2){
+Real angle(const Vector &v1, const Vector &v2){
     return acos((dotProduct(v1,v2))/(module(v1)*module(v2)));
 }
 
@@ -183,23 +183,23 @@ Vector reflect(const Vector& incident, const Vector& normal) {
  * @param ior_ratio Índice de refracción del medio al que se está refractando.
  * @return Vector Vector refractado, o un vector nulo si ocurre reflexión total interna.
  */
-Vector refract(const Vector& incident, const Vector& normal, double ior_ratio) {
+Vector refract(const Vector& incident, const Vector& normal, Real ior_ratio) {
     Vector incidentNorm = normalize(incident);
     Vector normalNorm = normalize(normal);
 
-    double cosi = dotProduct(incidentNorm, normalNorm);
+    Real cosi = dotProduct(incidentNorm, normalNorm);
     if (cosi < -1.0) cosi = -1.0;
     if (cosi > 1.0) cosi = 1.0;
 
-    double etai = 1.0;
-    double etat = ior_ratio;
+    Real etai = 1.0;
+    Real etat = ior_ratio;
     if (cosi > 0) {
         normalNorm = -normalNorm;
         std::swap(etai, etat);
     }
 
-    double eta = etai / etat;
-    double k = 1.0 - eta * eta * (1.0 - cosi * cosi);
+    Real eta = etai / etat;
+    Real k = 1.0 - eta * eta * (1.0 - cosi * cosi);
 
     if (k < 0.0) {
         return Vector(0, 0, 0);  // Reflexión total interna
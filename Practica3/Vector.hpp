@@ -26,7 +26,7 @@ class Vector: public Coordinate{
 private:
 
 public:
-    Vector(double _x, double _y, double _z) : Coordinate(_x, _y, _z, 0.0){};
+    Vector(Real _x, Real _y, Real _z) : Coordinate(_x, _y, _z, 0.0){};
     Vector(const Coordinate& c) : Coordinate(c.x, c.y, c.z, 0.0) {};
 
     ~Vector() = default;
@@ -35,15 +35,15 @@ public:
     friend Vector operator+(const Vector &v1, const Vector &v2);
     friend Vector operator-(const Vector &v1, const Vector &v2);
     friend Vector crossProduct(const Vector &v1, const Vector &v2);
-    friend double dotProduct(const Vector &v1, const Vector &v2);
-    friend Vector operator*(const Vector &v, const double s);
-    friend Vector operator*(const double s, const Vector &v);
-    friend Vector operator/(const Vector &v, const double s);
-    friend double module(const Vector &v);
-    friend double angle(const Vector &v1, const Vector &v2);
+    friend Real dotProduct(const Vector &v1, const Vector &v2);
+    friend Vector operator*(const Vector &v, const Real s);
+    friend Vector operator*(const Real s, const Vector &v);
+    friend Vector operator/(const Vector &v, const Real s);
+    friend Real module(const Vector &v);
+    friend Real angle(const Vector &v1, const Vector &v2);
     friend Vector normalize(const Vector &v);
     friend Vector reflect(const Vector& incident, const Vector& normal);
-    friend Vector refract(const Vector& incident, const Vector& normal, double ior_ratio);
+    friend Vector refract(const Vector& incident, const Vector& normal, Real ior_ratio);
     friend Vector operator-(const Vector& v);
 };
 